@@ -329,6 +329,9 @@ void Agros2DGenerator::generateModule(const QString &moduleId)
     generator.generatePluginSurfaceIntegralFiles();
     generator.generatePluginVolumeIntegralFiles();
 
+    // generates metadata index
+    generator.generatePluginIndex();
+
     // generates documentation
     generator.generatePluginDocumentationFiles();
 
@@ -351,5 +354,8 @@ void Agros2DGenerator::generateCoupling(const QString &couplingId)
     generator.generatePluginInterfaceFiles();
     generator.generatePluginWeakFormFiles();
     generator.deleteWeakFormOutput();
+
+    // generates metadata index
+    generator.generatePluginIndex();
 }
 
@@ -26,6 +26,7 @@
 #include "hermes2d/weak_form.h"
 #include "hermes2d/module.h"
 #include "hermes2d/coupling.h"
+#include "hermes2d/module_index.h"
 
 #include "parser/lex.h"
 
@@ -77,6 +78,34 @@ Agros2DGeneratorCoupling::Agros2DGeneratorCoupling(const QString &couplingId) :
     Module::volumeQuantityProperties(m_sourceModule, sourceQuantityOrdering, sourceQuantityIsNonlinear, sourceFunctionOrdering);
 }
 
+void Agros2DGeneratorCoupling::generatePluginIndex()
+{
+    Hermes::Mixins::Loggable::Static::info(QString("generating metadata index").toLatin1());
+
+    QString sourceModuleId = QString::fromStdString(m_coupling->general_coupling().modules().source().id());
+    QString targetModuleId = QString::fromStdString(m_coupling->general_coupling().modules().target().id());
+    QString id = QString("%1-%2").arg(sourceModuleId).arg(targetModuleId);
+
+    // same information as CouplingList reads from XML
+    QList<ModuleIndex::CouplingItem> items;
+    for (int i = 0; i < m_coupling->volume().weakforms_volume().weakform_volume().size(); i++)
+    {
+        XMLModule::weakform_volume wf = m_coupling->volume().weakforms_volume().weakform_volume().at(i);
+
+        ModuleIndex::CouplingItem item;
+        item.sourceField = sourceModuleId;
+        item.sourceAnalysisType = analysisTypeFromStringKey(QString::fromStdString(wf.sourceanalysis().get()));
+        item.targetField = targetModuleId;
+        item.targetAnalysisType = analysisTypeFromStringKey(QString::fromStdString(wf.analysistype()));
+        item.couplingType = couplingTypeFromStringKey(QString::fromStdString(wf.couplingtype().get()));
+
+        items.append(item);
+    }
+
+    if (!ModuleIndex::writeCoupling(compatibleFilename(datadir() + COUPLINGROOT + "/" + id + ".xml"), id, items))
+        throw AgrosGeneratorException(QString("Could not write metadata index of coupling '%1'.").arg(id));
+}
+
 void Agros2DGeneratorCoupling::generatePluginProjectFile()
 {
     QString id = (QString::fromStdString(m_coupling->general_coupling().id().c_str()));
@@ -39,6 +39,7 @@ public:
     void generatePluginLocalPointFiles();
     void generatePluginInterfaceFiles();
     void generatePluginWeakFormFiles();
+    void generatePluginIndex();
     QMap<QString, QString>  sourceVaribales() const {return m_sourceVariables;}
     QMap<QString, QString>  targetVaribales() const {return m_targetVariables;}
 
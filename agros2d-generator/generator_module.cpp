@@ -21,6 +21,7 @@
 #include "generator_module.h"
 #include "parser.h"
 #include "hermes2d/module.h"
+#include "hermes2d/module_index.h"
 
 
 #include "util/constants.h"
@@ -92,6 +93,17 @@ void Agros2DGeneratorModule::generatePluginProjectFile()
                        QString::fromStdString(text));
 }
 
+void Agros2DGeneratorModule::generatePluginIndex()
+{
+    Hermes::Mixins::Loggable::Static::info(QString("generating metadata index").toLatin1());
+
+    QString id = QString::fromStdString(m_module->general_field().id());
+    QString name = QString::fromStdString(m_module->general_field().name());
+
+    if (!ModuleIndex::writeModule(compatibleFilename(datadir() + MODULEROOT + "/" + id + ".xml"), id, name))
+        throw AgrosGeneratorException(QString("Could not write metadata index of module '%1'.").arg(id));
+}
+
 void Agros2DGeneratorModule::prepareWeakFormsOutput()
 {
     Hermes::Mixins::Loggable::Static::info(QString("parsing weak forms").toLatin1());
@@ -44,6 +44,7 @@ public:
     void generatePluginDocumentationFiles();
     void generatePluginEquations();
     void generatePluginErrorCalculator();
+    void generatePluginIndex();
 
 
 private:
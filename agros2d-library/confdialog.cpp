@@ -73,6 +73,7 @@ void ConfigComputerDialog::load()
 
     // std log
     chkLogStdOut->setChecked(Agros2D::configComputer()->value(Config::Config_LogStdOut).toBool());
+    chkLogSolverIterations->setChecked(Agros2D::configComputer()->value(Config::Config_LogSolverIterations).toBool());
 
     // workspace
     chkShowGrid->setChecked(Agros2D::configComputer()->value(Config::Config_ShowGrid).toBool());
@@ -113,6 +114,7 @@ void ConfigComputerDialog::save()
 
     // std log
     Agros2D::configComputer()->setValue(Config::Config_LogStdOut, chkLogStdOut->isChecked());
+    Agros2D::configComputer()->setValue(Config::Config_LogSolverIterations, chkLogSolverIterations->isChecked());
 
     // workspace
     Agros2D::configComputer()->setValue(Config::Config_ShowGrid, chkShowGrid->isChecked());
@@ -206,10 +208,12 @@ QWidget *ConfigComputerDialog::createMainWidget()
     chkLineEditValueShowResult = new QCheckBox(tr("Show value result in line edit input"));
 
     chkLogStdOut = new QCheckBox(tr("Print application log to standard output."));
+    chkLogSolverIterations = new QCheckBox(tr("Print iterations of nonlinear solvers"));
 
     QVBoxLayout *layoutOther = new QVBoxLayout();
     layoutOther->addWidget(chkLineEditValueShowResult);
     layoutOther->addWidget(chkLogStdOut);
+    layoutOther->addWidget(chkLogSolverIterations);
 
     QGroupBox *grpOther = new QGroupBox(tr("Other"));
     grpOther->setLayout(layoutOther);
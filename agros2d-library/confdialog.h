@@ -56,6 +56,7 @@ private:
 
     // log std out
     QCheckBox *chkLogStdOut;
+    QCheckBox *chkLogSolverIterations;
 
     // development
     QCheckBox *chkDiscreteSaveMatrixRHS;
@@ -24,9 +24,11 @@
 #include "problem.h"
 #include "coupling.h"
 #include "scene.h"
+#include "scenemarkerdialog.h"
 #include "logview.h"
 #include "solver.h"
 #include "module.h"
+#include "weak_form.h"
 #include "problem_config.h"
 #include "plugin_interface.h"
 
@@ -379,6 +381,49 @@ LinearityType Block::linearityType() const
         assert(0);
 }
 
+bool Block::isMatrixTimeIndependent() const
+{
+    if (linearityType() != LinearityType_Linear)
+        return false;
+
+    // external fields are updated in each time step
+    if (!sourceFieldInfosCoupling().isEmpty())
+        return false;
+
+    foreach (Field* field, m_fields)
+    {
+        FieldInfo* fieldInfo = field->fieldInfo();
+
+        // materials (sources are in the right hand side only)
+        foreach (SceneMaterial *material, Agros2D::scene()->materials->items())
+        {
+            if (material->fieldInfo() != fieldInfo)
+                continue;
+
+            foreach (Module::MaterialTypeVariable variable, fieldInfo->materialTypeVariables())
+                if (variable.isTimeDep() && !variable.isSource() && material->value(variable.id())->isTimeDependent())
+                    return false;
+        }
+
+        // boundaries with surface matrix forms
+        foreach (SceneBoundary *boundary, Agros2D::scene()->boundaries->items())
+        {
+            if (boundary->fieldInfo() != fieldInfo || boundary->isNone())
+                continue;
+
+            Module::BoundaryType boundaryType = fieldInfo->boundaryType(boundary->type());
+            if (boundaryType.wfMatrixSurface().isEmpty())
+                continue;
+
+            foreach (Module::BoundaryTypeVariable variable, boundaryType.variables())
+                if (variable.isTimeDep() && boundary->value(variable.id())->isTimeDependent())
+                    return false;
+        }
+    }
+
+    return true;
+}
+
 Hermes::MatrixSolverType Block::matrixSolver() const
 {
     Hermes::MatrixSolverType mt = m_fields.at(0)->fieldInfo()->matrixSolver();
@@ -392,6 +437,35 @@ Hermes::MatrixSolverType Block::matrixSolver() const
     return mt;
 }
 
+bool Block::matrixSolverAutomatic() const
+{
+    foreach (Field *field, m_fields)
+        if (!field->fieldInfo()->value(FieldInfo::LinearSolverAutomatic).toBool())
+            return false;
+
+    return true;
+}
+
+bool Block::isMatrixSymmetric() const
+{
+    // off-diagonal blocks of hard coupling
+    foreach (CouplingInfo *couplingInfo, m_couplings)
+        if (couplingInfo->isHard())
+            return false;
+
+    CoordinateType coordinateType = Agros2D::problem()->config()->coordinateType();
+    foreach (Field *field, m_fields)
+    {
+        FieldInfo *fieldInfo = field->fieldInfo();
+
+        foreach (FormInfo form, WeakFormAgros<double>::wfMatrixVolumeSeparated(fieldInfo->plugin()->module(), fieldInfo->analysisType(), fieldInfo->linearityType()))
+            if (form.sym(coordinateType) != Hermes::Hermes2D::HERMES_SYM)
+                return false;
+    }
+
+    return true;
+}
+
 double Block::nonlinearResidualNorm() const
 {
     double tolerance = numeric_limits<double>::max();
@@ -611,6 +685,43 @@ double Block::iterLinearSolverToleranceAbsolute() const
     return coeff;
 }
 
+int Block::iterLinearSolverAMGReuseSolves() const
+{
+    int solves = numeric_limits<int>::max();
+
+    foreach (Field* field, m_fields)
+    {
+        FieldInfo* fieldInfo = field->fieldInfo();
+        if (fieldInfo->value(FieldInfo::LinearSolverAMGReuseSolves).toInt() < solves)
+            solves = fieldInfo->value(FieldInfo::LinearSolverAMGReuseSolves).toInt();
+    }
+
+    return solves;
+}
+
+int Block::iterLinearSolverAMGReuseIters() const
+{
+    int iters = numeric_limits<int>::max();
+
+    foreach (Field* field, m_fields)
+    {
+        FieldInfo* fieldInfo = field->fieldInfo();
+        if (fieldInfo->value(FieldInfo::LinearSolverAMGReuseIters).toInt() < iters)
+            iters = fieldInfo->value(FieldInfo::LinearSolverAMGReuseIters).toInt();
+    }
+
+    return iters;
+}
+
+bool Block::iterLinearSolverMixedPrecision() const
+{
+    foreach (Field *field, m_fields)
+        if (!field->fieldInfo()->value(FieldInfo::LinearSolverMixedPrecision).toBool())
+            return false;
+
+    return true;
+}
+
 int Block::iterLinearSolverIters() const
 {
     int iters = 1;
@@ -58,8 +58,17 @@ public:
     LinearityType linearityType() const;
     bool isTransient() const;
 
+    // linear block without time dependent coefficients and weak couplings (matrix can be reused between time steps)
+    bool isMatrixTimeIndependent() const;
+
     Hermes::MatrixSolverType matrixSolver() const;
 
+    // matrix solver selected automatically (use only if true for all fields)
+    bool matrixSolverAutomatic() const;
+
+    // all volume matrix forms are symmetric and fields are not hard coupled
+    bool isMatrixSymmetric() const;
+
     // returns minimal time skip of individual fields
     double timeSkip() const;
     //bool skipThisTimeStep() const;
@@ -116,6 +125,13 @@ public:
     double iterLinearSolverToleranceAbsolute() const;
     int iterLinearSolverIters() const;
 
+    // number of linear solves with one AMG hierarchy (0 - rebuild in each solve)
+    int iterLinearSolverAMGReuseSolves() const;
+    // AMG hierarchy is rebuilt when number of iterations exceeds this value
+    int iterLinearSolverAMGReuseIters() const;
+    // single precision inner solve with double precision defect correction
+    bool iterLinearSolverMixedPrecision() const;
+
     bool contains(const FieldInfo *fieldInfo) const;
     Field* field(const FieldInfo* fieldInfo) const;
 
@@ -32,6 +32,7 @@
 #include "hermes2d/problem.h"
 #include "hermes2d/problem_config.h"
 #include "hermes2d/plugin_interface.h"
+#include "hermes2d/module_index.h"
 
 #include "../../resources_source/classes/module_xml.h"
 
@@ -55,6 +56,27 @@ CouplingList::CouplingList()
 
     foreach (QString filename, list)
     {
+        // precomputed index (agros2d-generator), full XML is parsed only if missing or stale
+        QString id;
+        QList<ModuleIndex::CouplingItem> indexItems;
+        if (ModuleIndex::readCoupling(compatibleFilename(datadir() + COUPLINGROOT + "/" + filename), id, indexItems))
+        {
+            foreach (ModuleIndex::CouplingItem indexItem, indexItems)
+            {
+                CouplingList::Item item;
+
+                item.sourceField = indexItem.sourceField;
+                item.sourceAnalysisType = indexItem.sourceAnalysisType;
+                item.targetField = indexItem.targetField;
+                item.targetAnalysisType = indexItem.targetAnalysisType;
+                item.couplingType = indexItem.couplingType;
+
+                m_couplings.append(item);
+            }
+
+            continue;
+        }
+
         try
         {
             // todo: this was copied from module. Find a way to do all catching at one place
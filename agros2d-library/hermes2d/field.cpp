@@ -935,6 +935,10 @@ void FieldInfo::setStringKeys()
     m_settingKey[LinearSolverIterPreconditioner] = "LinearSolverIterPreconditioner";
     m_settingKey[LinearSolverIterToleranceAbsolute] = "LinearSolverIterToleranceAbsolute";
     m_settingKey[LinearSolverIterIters] = "LinearSolverIterIters";
+    m_settingKey[LinearSolverAutomatic] = "LinearSolverAutomatic";
+    m_settingKey[LinearSolverAMGReuseSolves] = "LinearSolverAMGReuseSolves";
+    m_settingKey[LinearSolverAMGReuseIters] = "LinearSolverAMGReuseIters";
+    m_settingKey[LinearSolverMixedPrecision] = "LinearSolverMixedPrecision";
     m_settingKey[TimeUnit] = "TimeUnit";
 
 }
@@ -974,5 +978,9 @@ void FieldInfo::setDefaultValues()
     m_settingDefault[LinearSolverIterPreconditioner] = Hermes::Solvers::ILU;
     m_settingDefault[LinearSolverIterToleranceAbsolute] = 1e-16;
     m_settingDefault[LinearSolverIterIters] = 1000;
+    m_settingDefault[LinearSolverAutomatic] = false;
+    m_settingDefault[LinearSolverAMGReuseSolves] = 0;
+    m_settingDefault[LinearSolverAMGReuseIters] = 50;
+    m_settingDefault[LinearSolverMixedPrecision] = false;
     m_settingDefault[TimeUnit] = "s";
 }
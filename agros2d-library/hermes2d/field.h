@@ -96,6 +96,10 @@ public:
         LinearSolverIterPreconditioner,
         LinearSolverIterToleranceAbsolute,
         LinearSolverIterIters,
+        LinearSolverAutomatic,
+        LinearSolverAMGReuseSolves,
+        LinearSolverAMGReuseIters,
+        LinearSolverMixedPrecision,
         TimeUnit
     };
 
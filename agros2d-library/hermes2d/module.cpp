@@ -37,6 +37,7 @@
 #include "hermes2d/plugin_interface.h"
 #include "hermes2d/bdf2.h"
 #include "hermes2d/problem_config.h"
+#include "hermes2d/module_index.h"
 
 #include "mesh/mesh_reader_h2d.h"
 
@@ -64,6 +65,15 @@ QMap<QString, QString> Module::availableModules()
 
         foreach (QString filename, list)
         {
+            // precomputed index (agros2d-generator), full XML is parsed only if missing or stale
+            QString id;
+            QString name;
+            if (ModuleIndex::readModule(compatibleFilename(datadir() + MODULEROOT + "/" + filename), id, name))
+            {
+                modules[filename.left(filename.size() - 4)] = name;
+                continue;
+            }
+
             try
             {
                 // todo: find a way to validate if required. If validated here, sensible error messages will be obtained
@@ -618,12 +628,28 @@ Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > WeakFormAgros<S
 template <typename Scalar>
 Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > WeakFormAgros<Scalar>::sourceCouplingSolutions(const FieldInfo* fieldInfo) const
 {
-    Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > result;
-
     FieldSolutionID solutionID = Agros2D::solutionStore()->lastTimeAndAdaptiveSolution(fieldInfo, SolutionMode_Finer);
+    int revision = Agros2D::solutionStore()->fieldRevision(fieldInfo);
 
+    // source field has not been solved again
+    if (m_sourceCouplings.contains(fieldInfo))
+    {
+        const SourceCoupling &sourceCoupling = m_sourceCouplings[fieldInfo];
+        if ((sourceCoupling.solutionID == solutionID) && (sourceCoupling.revision == revision))
+            return sourceCoupling.solutions;
+    }
+
+    Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > result;
+
+    MultiArray<double> multiArray = Agros2D::solutionStore()->multiArray(solutionID);
     for (int comp = 0; comp < solutionID.group->numberOfSolutions(); comp++)
-        result.push_back(Agros2D::solutionStore()->multiArray(solutionID).solutions().at(comp));
+        result.push_back(multiArray.solutions().at(comp));
+
+    SourceCoupling sourceCoupling;
+    sourceCoupling.solutionID = solutionID;
+    sourceCoupling.revision = revision;
+    sourceCoupling.solutions = result;
+    m_sourceCouplings[fieldInfo] = sourceCoupling;
 
     return result;
 }
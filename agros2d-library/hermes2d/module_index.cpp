@@ -0,0 +1,159 @@
+// This file is part of Agros2D.
+//
+// Agros2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Agros2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Agros2D.  If not, see <http://www.gnu.org/licenses/>.
+//
+// hp-FEM group (http://hpfem.org/)
+// University of Nevada, Reno (UNR) and University of West Bohemia, Pilsen
+// Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
+
+
+#include "module_index.h"
+
+// "A2DI"
+const quint32 MODULE_INDEX_MAGIC = 0x41324449;
+// increase when the layout changes
+const quint32 MODULE_INDEX_VERSION = 1;
+
+QString ModuleIndex::indexFileName(const QString &xmlFileName)
+{
+    QFileInfo info(xmlFileName);
+    return QString("%1/%2.%3").arg(info.absolutePath()).arg(info.completeBaseName()).arg(MODULE_INDEX_SUFFIX);
+}
+
+bool ModuleIndex::openForWrite(QFile &file, QDataStream &stream, const QString &xmlFileName, Kind kind, const QString &id)
+{
+    QFileInfo xmlInfo(xmlFileName);
+    if (!xmlInfo.exists())
+        return false;
+
+    file.setFileName(indexFileName(xmlFileName));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    stream.setDevice(&file);
+    stream.setVersion(QDataStream::Qt_4_8);
+
+    // header - source XML size and timestamp are used to detect stale index
+    stream << MODULE_INDEX_MAGIC << MODULE_INDEX_VERSION << (quint32) kind
+           << (qint64) xmlInfo.size() << (qint64) xmlInfo.lastModified().toMSecsSinceEpoch()
+           << id;
+
+    return true;
+}
+
+bool ModuleIndex::openForRead(QFile &file, QDataStream &stream, const QString &xmlFileName, Kind kind, QString &id)
+{
+    QFileInfo xmlInfo(xmlFileName);
+    file.setFileName(indexFileName(xmlFileName));
+    if (!xmlInfo.exists() || !file.exists())
+        return false;
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    stream.setDevice(&file);
+    stream.setVersion(QDataStream::Qt_4_8);
+
+    quint32 magic, version, kindStored;
+    qint64 size, lastModified;
+    stream >> magic >> version >> kindStored >> size >> lastModified >> id;
+
+    if (stream.status() != QDataStream::Ok
+            || magic != MODULE_INDEX_MAGIC
+            || version != MODULE_INDEX_VERSION
+            || kindStored != (quint32) kind)
+        return false;
+
+    // XML was modified after the index has been generated
+    if (size != xmlInfo.size() || lastModified != xmlInfo.lastModified().toMSecsSinceEpoch())
+        return false;
+
+    return true;
+}
+
+bool ModuleIndex::writeModule(const QString &xmlFileName, const QString &id, const QString &name)
+{
+    QFile file;
+    QDataStream stream;
+    if (!openForWrite(file, stream, xmlFileName, Kind_Module, id))
+        return false;
+
+    stream << name;
+
+    return (stream.status() == QDataStream::Ok);
+}
+
+bool ModuleIndex::readModule(const QString &xmlFileName, QString &id, QString &name)
+{
+    QFile file;
+    QDataStream stream;
+    if (!openForRead(file, stream, xmlFileName, Kind_Module, id))
+        return false;
+
+    stream >> name;
+
+    return (stream.status() == QDataStream::Ok);
+}
+
+bool ModuleIndex::writeCoupling(const QString &xmlFileName, const QString &id, const QList<CouplingItem> &items)
+{
+    QFile file;
+    QDataStream stream;
+    if (!openForWrite(file, stream, xmlFileName, Kind_Coupling, id))
+        return false;
+
+    stream << (quint32) items.count();
+    foreach (CouplingItem item, items)
+    {
+        stream << item.sourceField << (qint32) item.sourceAnalysisType
+               << item.targetField << (qint32) item.targetAnalysisType
+               << (qint32) item.couplingType;
+    }
+
+    return (stream.status() == QDataStream::Ok);
+}
+
+bool ModuleIndex::readCoupling(const QString &xmlFileName, QString &id, QList<CouplingItem> &items)
+{
+    QFile file;
+    QDataStream stream;
+    if (!openForRead(file, stream, xmlFileName, Kind_Coupling, id))
+        return false;
+
+    quint32 count;
+    stream >> count;
+
+    QList<CouplingItem> list;
+    for (quint32 i = 0; i < count; i++)
+    {
+        qint32 sourceAnalysisType, targetAnalysisType, couplingType;
+
+        CouplingItem item;
+        stream >> item.sourceField >> sourceAnalysisType
+               >> item.targetField >> targetAnalysisType
+               >> couplingType;
+
+        item.sourceAnalysisType = (AnalysisType) sourceAnalysisType;
+        item.targetAnalysisType = (AnalysisType) targetAnalysisType;
+        item.couplingType = (CouplingType) couplingType;
+
+        list.append(item);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    items = list;
+    return true;
+}
@@ -0,0 +1,67 @@
+// This file is part of Agros2D.
+//
+// Agros2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Agros2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Agros2D.  If not, see <http://www.gnu.org/licenses/>.
+//
+// hp-FEM group (http://hpfem.org/)
+// University of Nevada, Reno (UNR) and University of West Bohemia, Pilsen
+// Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
+
+
+#ifndef MODULE_INDEX_H
+#define MODULE_INDEX_H
+
+#include "util.h"
+#include "util/enums.h"
+
+// compact binary metadata of module and coupling XML files
+// index is written by agros2d-generator next to the XML file (<id>.idx) and is
+// used at startup instead of the full XSD parser; stale or missing index falls back to XML
+
+const QString MODULE_INDEX_SUFFIX = "idx";
+
+class AGROS_LIBRARY_API ModuleIndex
+{
+public:
+    struct CouplingItem
+    {
+        QString sourceField;
+        AnalysisType sourceAnalysisType;
+        QString targetField;
+        AnalysisType targetAnalysisType;
+        CouplingType couplingType;
+    };
+
+    // index file name for given XML file
+    static QString indexFileName(const QString &xmlFileName);
+
+    // module (field id and name)
+    static bool writeModule(const QString &xmlFileName, const QString &id, const QString &name);
+    static bool readModule(const QString &xmlFileName, QString &id, QString &name);
+
+    // coupling (list of available source/target analyses)
+    static bool writeCoupling(const QString &xmlFileName, const QString &id, const QList<CouplingItem> &items);
+    static bool readCoupling(const QString &xmlFileName, QString &id, QList<CouplingItem> &items);
+
+private:
+    enum Kind
+    {
+        Kind_Module = 1,
+        Kind_Coupling = 2
+    };
+
+    static bool openForWrite(QFile &file, QDataStream &stream, const QString &xmlFileName, Kind kind, const QString &id);
+    static bool openForRead(QFile &file, QDataStream &stream, const QString &xmlFileName, Kind kind, QString &id);
+};
+
+#endif // MODULE_INDEX_H
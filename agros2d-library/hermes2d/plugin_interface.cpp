@@ -112,6 +112,29 @@ double AgrosSpecialExtFunction::getValue(int hermesMarker, double h) const
         return calculateValue(hermesMarker, h);
 }
 
+// descriptions are requested from worker threads too (post-processing tasks, batch)
+static QMutex descriptionMutex;
+
+XMLModule::field *PluginInterface::module() const
+{
+    QMutexLocker lock(&descriptionMutex);
+    if (!m_module)
+        loadModule();
+
+    assert(m_module);
+    return m_module;
+}
+
+XMLModule::coupling *PluginInterface::coupling() const
+{
+    QMutexLocker lock(&descriptionMutex);
+    if (!m_coupling)
+        loadCoupling();
+
+    assert(m_coupling);
+    return m_coupling;
+}
+
 template class AGROS_LIBRARY_API FormAgrosInterface<double>;
 template class AGROS_LIBRARY_API MatrixFormVolAgros<double>;
 template class AGROS_LIBRARY_API VectorFormVolAgros<double>;
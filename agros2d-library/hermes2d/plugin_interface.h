@@ -292,8 +292,9 @@ public:
 
     virtual QString fieldId() = 0;
 
-    inline XMLModule::field *module() const { assert(m_module); return m_module; }
-    inline XMLModule::coupling *coupling() const { assert(m_coupling); return m_coupling; }
+    // full XML description is parsed on first access (thread safe)
+    XMLModule::field *module() const;
+    XMLModule::coupling *coupling() const;
 
     // weak forms
     virtual MatrixFormVolAgros<double> *matrixFormVol(const ProblemID problemId, FormInfo *form, const WeakFormAgros<double>* wfAgros, Material *material) = 0;
@@ -334,8 +335,12 @@ public:
     virtual QString localeDescription() = 0;
 
 protected:
-    XMLModule::field *m_module;
-    XMLModule::coupling *m_coupling;
+    // parse XML description (generated)
+    virtual void loadModule() const {}
+    virtual void loadCoupling() const {}
+
+    mutable XMLModule::field *m_module;
+    mutable XMLModule::coupling *m_coupling;
 };
 
 
@@ -85,6 +85,7 @@ Problem::Problem()
     m_calculationThread = new CalculationThread();
 
     m_isNonlinear = false;
+    m_reuseInitialMesh = false;
 
     actMesh = new QAction(icon("scene-meshgen"), tr("&Mesh area"), this);
     actMesh->setShortcut(QKeySequence(tr("Alt+W")));
@@ -165,6 +166,8 @@ bool Problem::determineIsNonlinear() const
 
 void Problem::clearSolution()
 {
+    emit aboutToClearSolution();
+
     m_abort = false;
 
     // m_timeStep = 0;
@@ -405,6 +408,21 @@ bool Problem::meshAction(bool emitMeshed)
     Agros2D::scene()->checkGeometryResult();
     Agros2D::scene()->checkGeometryAssignement();
 
+    // geometry and mesh settings unchanged -> copy of previous initial meshes
+    QByteArray meshKey;
+    if (m_reuseInitialMesh)
+    {
+        meshKey = initialMeshKey();
+        if (meshKey == m_initialMeshKey && m_initialMeshCache.size() == m_fieldInfos.size())
+        {
+            Agros2D::log()->printMessage(QObject::tr("Mesh Generator"), QObject::tr("Geometry unchanged, initial mesh reused"));
+
+            QSharedPointer<MeshGenerator> meshGenerator(new MeshGeneratorCached(m_initialMeshCache));
+            readInitialMeshesFromFile(emitMeshed, meshGenerator);
+            return true;
+        }
+    }
+
     QSharedPointer<MeshGenerator> meshGenerator;
     switch (config()->meshType())
     {
@@ -434,6 +452,13 @@ bool Problem::meshAction(bool emitMeshed)
 
     if (meshGenerator && meshGenerator->mesh())
     {
+        // cache unrefined meshes
+        if (m_reuseInitialMesh)
+        {
+            m_initialMeshKey = meshKey;
+            m_initialMeshCache = MeshGeneratorCached::copyMeshes(meshGenerator->meshes());
+        }
+
         // load mesh
         try
         {
@@ -453,6 +478,39 @@ bool Problem::meshAction(bool emitMeshed)
     return false;
 }
 
+QByteArray Problem::initialMeshKey() const
+{
+    // everything the mesh generator depends on (materials and boundary values excluded)
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+
+    stream << (qint32) config()->meshType();
+
+    foreach (SceneNode *node, Agros2D::scene()->nodes->items())
+        stream << node->point().x << node->point().y;
+
+    foreach (SceneEdge *edge, Agros2D::scene()->edges->items())
+        stream << (qint32) Agros2D::scene()->nodes->items().indexOf(edge->nodeStart())
+               << (qint32) Agros2D::scene()->nodes->items().indexOf(edge->nodeEnd())
+               << edge->angle() << (qint32) edge->segments() << edge->isCurvilinear();
+
+    foreach (SceneLabel *label, Agros2D::scene()->labels->items())
+        stream << label->point().x << label->point().y << label->area();
+
+    // holes and boundaries without condition
+    foreach (FieldInfo *fieldInfo, m_fieldInfos)
+    {
+        stream << fieldInfo->fieldId();
+
+        foreach (SceneEdge *edge, Agros2D::scene()->edges->items())
+            stream << edge->marker(fieldInfo)->isNone();
+        foreach (SceneLabel *label, Agros2D::scene()->labels->items())
+            stream << label->marker(fieldInfo)->isNone();
+    }
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Md5);
+}
+
 double Problem::timeStepToTime(int timeStepIndex) const
 {
     if (timeStepIndex == 0 || timeStepIndex == NOT_FOUND_SO_FAR)
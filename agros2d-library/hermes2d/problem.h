@@ -65,6 +65,8 @@ signals:
     /// emited when an field is added or removed. Menus need to adjusted
     void couplingsChanged();
 
+    // emited before meshes and solutions are released
+    void aboutToClearSolution();
     void clearedSolution();
 
 public slots:
@@ -90,6 +92,10 @@ public:
     // check geometry
     bool checkGeometry();
 
+    // reuse initial meshes while the geometry and mesh settings are unchanged (batch solver)
+    inline void setReuseInitialMesh(bool reuse = true) { m_reuseInitialMesh = reuse; m_initialMeshCache.clear(); }
+    inline bool reuseInitialMesh() const { return m_reuseInitialMesh; }
+
     bool isSolved() const;
     bool isSolving() const { return m_isSolving; }
     bool isMeshed() const;
@@ -185,6 +191,12 @@ private:
     // determined in create structure to speed up the calculation
     bool m_isNonlinear;
 
+    // initial mesh cache
+    bool m_reuseInitialMesh;
+    QByteArray m_initialMeshKey;
+    Hermes::vector<Hermes::Hermes2D::MeshSharedPtr> m_initialMeshCache;
+    QByteArray initialMeshKey() const;
+
     QList<double> m_timeStepLengths;
     double m_actualTime;
 
@@ -142,6 +142,7 @@ void ProblemConfig::setStringKeys()
     m_settingKey[Frequency] = "Frequency";
     m_settingKey[TimeMethod] = "TimeMethod";
     m_settingKey[TimeMethodTolerance] = "TimeMethodTolerance";
+    m_settingKey[TimeMethodEstimator] = "TimeMethodEstimator";
     m_settingKey[TimeInitialStepSize] = "TimeInitialStepSize";
     m_settingKey[TimeOrder] = "TimeOrder";
     m_settingKey[TimeConstantTimeSteps] = "TimeSteps";
@@ -155,6 +156,7 @@ void ProblemConfig::setDefaultValues()
     m_settingDefault[Frequency] = 50.0;
     m_settingDefault[TimeMethod] = TimeStepMethod_BDFNumSteps;
     m_settingDefault[TimeMethodTolerance] = 0.05;
+    m_settingDefault[TimeMethodEstimator] = TimeStepEstimator_LowerOrder;
     m_settingDefault[TimeInitialStepSize] = 0.0;
     m_settingDefault[TimeOrder] = 2;
     m_settingDefault[TimeConstantTimeSteps] = 10;
@@ -46,6 +46,7 @@ public:
         Frequency,
         TimeMethod,
         TimeMethodTolerance,
+        TimeMethodEstimator,
         TimeInitialStepSize,
         TimeOrder,
         TimeConstantTimeSteps,
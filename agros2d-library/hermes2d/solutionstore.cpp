@@ -72,6 +72,8 @@ void SolutionStore::clearAll()
     assert(m_multiSolutions.isEmpty());
     assert(m_multiSolutionRunTimeDetails.isEmpty());
     assert(m_multiSolutionCache.isEmpty());
+    assert(m_fieldSolutions.isEmpty());
+    assert(m_fieldRevision.isEmpty());
 }
 
 MultiArray<double> SolutionStore::multiArray(FieldSolutionID solutionID)
@@ -283,6 +285,8 @@ void SolutionStore::addSolution(FieldSolutionID solutionID, MultiArray<double> m
 
     // append multisolution
     m_multiSolutions.append(solutionID);
+    m_fieldSolutions[solutionID.group]++;
+    m_fieldRevision[solutionID.group] = ++m_revision;
 
     // append properties
     m_multiSolutionRunTimeDetails.insert(solutionID, runTime);
@@ -305,6 +309,16 @@ void SolutionStore::removeSolution(FieldSolutionID solutionID, bool saveRunTime)
 
     // remove from list
     m_multiSolutions.removeOne(solutionID);
+    // forget fields without solutions (field info can be deleted)
+    if (--m_fieldSolutions[solutionID.group] > 0)
+    {
+        m_fieldRevision[solutionID.group] = ++m_revision;
+    }
+    else
+    {
+        m_fieldSolutions.remove(solutionID.group);
+        m_fieldRevision.remove(solutionID.group);
+    }
     // remove properties
     m_multiSolutionRunTimeDetails.remove(solutionID);
     // remove from cache
@@ -628,6 +642,8 @@ void SolutionStore::loadRunTimeDetails()
                                        solutionTypeFromStringKey(QString::fromStdString(data.solution_type())));
             // append multisolution
             m_multiSolutions.append(solutionID);
+            m_fieldSolutions[solutionID.group]++;
+            m_fieldRevision[solutionID.group] = ++m_revision;
 
             // TODO: remove "problem time step structures"
             // define transient time step
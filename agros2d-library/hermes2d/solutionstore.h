@@ -25,6 +25,7 @@
 class AGROS_LIBRARY_API SolutionStore
 {
 public:
+    SolutionStore() : m_revision(0) {}
     ~SolutionStore();
 
     class SolutionRunTimeDetails
@@ -50,7 +51,8 @@ public:
         };
 
         SolutionRunTimeDetails(double time_step_length = 0, double error = 0, int DOFs = 0)
-            : m_timeStepLength(time_step_length), m_adaptivityError(error), m_DOFs(DOFs) {}
+            : m_timeStepLength(time_step_length), m_adaptivityError(error), m_DOFs(DOFs),
+              m_jacobianCalculations(0), m_matrixAssemblies(0), m_matrixFactorizations(0) {}
         ~SolutionRunTimeDetails()
         {
             m_fileNames.clear();
@@ -67,6 +69,10 @@ public:
         inline void setDOFs(int value) { m_DOFs = value; }
         inline int jacobianCalculations() const { return m_jacobianCalculations; }
         inline void setJacobianCalculations(int value) { m_jacobianCalculations = value; }
+        inline int matrixAssemblies() const { return m_matrixAssemblies; }
+        inline void setMatrixAssemblies(int value) { m_matrixAssemblies = value; }
+        inline int matrixFactorizations() const { return m_matrixFactorizations; }
+        inline void setMatrixFactorizations(int value) { m_matrixFactorizations = value; }
         inline QList<FileName> fileNames() const { return m_fileNames; }
         inline void setFileNames(QList<FileName> value) { m_fileNames = value; }
         inline QVector<double> relativeChangeOfSolutions() const { return m_relativeChangeOfSolutions; }
@@ -81,6 +87,8 @@ public:
         double m_adaptivityError;
         int m_DOFs;
         int m_jacobianCalculations;
+        int m_matrixAssemblies;
+        int m_matrixFactorizations;
 
         QList<FileName> m_fileNames;
         QVector<double> m_relativeChangeOfSolutions;
@@ -134,6 +142,8 @@ public:
     void multiSolutionRunTimeDetailReplace(FieldSolutionID solutionID, SolutionRunTimeDetails runTime);
 
     inline bool isEmpty() const { return m_multiSolutions.isEmpty(); }
+    // changes whenever a solution of the field is added or removed
+    inline int fieldRevision(const FieldInfo *fieldInfo) const { return m_fieldRevision.value(fieldInfo, 0); }
     void clearAll();
 
     void printDebugCacheStatus();
@@ -143,6 +153,11 @@ private:
     QMap<FieldSolutionID, SolutionRunTimeDetails> m_multiSolutionRunTimeDetails;
     QMap<FieldSolutionID, MultiArray<double> > m_multiSolutionCache;
     QList<FieldSolutionID> m_multiSolutionCacheIDOrder;
+    // revisions are taken from store-wide counter, value is never reused for other solutions
+    QMap<const FieldInfo *, int> m_fieldRevision;
+    int m_revision;
+    // number of solutions of the field, entries are removed with the last solution
+    QMap<const FieldInfo *, int> m_fieldSolutions;
 
     void addSolution(FieldSolutionID solutionID, MultiArray<double> multiArray, SolutionRunTimeDetails runTime);
     void removeSolution(FieldSolutionID solutionID, bool saveRunTime = true);
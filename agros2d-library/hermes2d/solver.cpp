@@ -44,14 +44,135 @@
 
 #include "pythonlab/pythonengine.h"
 
+#include "paralution.hpp"
+
 using namespace Hermes::Hermes2D;
 
+// capacity of per-solve statistics (grows if exceeded)
+const int NONLINEAR_STEPS_RESERVE = 64;
+
 void SolverAgros::clearSteps()
 {
-    m_steps.clear();
-    m_damping.clear();
-    m_residualNorms.clear();
-    m_solutionNorms.clear();
+    // resize(0) keeps allocated capacity
+    m_steps.resize(0);
+    m_damping.resize(0);
+    m_residualNorms.resize(0);
+    m_solutionNorms.resize(0);
+    m_relativeChangeOfSolutions.resize(0);
+
+    m_steps.reserve(NONLINEAR_STEPS_RESERVE);
+    m_damping.reserve(NONLINEAR_STEPS_RESERVE);
+    m_residualNorms.reserve(NONLINEAR_STEPS_RESERVE);
+    m_solutionNorms.reserve(NONLINEAR_STEPS_RESERVE);
+    m_relativeChangeOfSolutions.reserve(NONLINEAR_STEPS_RESERVE);
+}
+
+void SolverAgros::linearSolveBegin(Hermes::Algebra::LinearMatrixSolver<double> *linearSolver)
+{
+    if (!dynamic_cast<AMGParalutionLinearMatrixSolver<double> *>(linearSolver))
+        return;
+
+    // sparsity is unchanged, keep hierarchy and smoothers, only matrix values are updated
+    m_amgHierarchyReused = !m_amgHierarchyRebuild && (m_amgHierarchySolves < m_block->iterLinearSolverAMGReuseSolves());
+    if (m_amgHierarchyReused)
+    {
+        linearSolver->set_reuse_scheme(HERMES_REUSE_MATRIX_STRUCTURE_COMPLETELY);
+        m_amgHierarchySolves++;
+    }
+    else
+    {
+        // scheme may be left at reuse from the previous solve
+        linearSolver->set_reuse_scheme(HERMES_CREATE_STRUCTURE_FROM_SCRATCH);
+        m_amgHierarchySolves = 1;
+        m_amgHierarchyRebuild = false;
+    }
+
+    m_linearSolveTimer.start();
+}
+
+void SolverAgros::resetAMGHierarchy()
+{
+    m_amgHierarchySolves = 0;
+    m_amgHierarchyRebuild = true;
+}
+
+void SolverAgros::linearSolveEnd(Hermes::Algebra::LinearMatrixSolver<double> *linearSolver)
+{
+    if (!dynamic_cast<AMGParalutionLinearMatrixSolver<double> *>(linearSolver))
+        return;
+
+    qint64 elapsed = m_linearSolveTimer.elapsed();
+
+    int iterations = 0;
+    if (LoopSolver<double> *loopSolver = dynamic_cast<LoopSolver<double> *>(linearSolver))
+        iterations = loopSolver->get_num_iters();
+
+    // hierarchy does not fit the actual matrix anymore
+    if (iterations > m_block->iterLinearSolverAMGReuseIters())
+        m_amgHierarchyRebuild = true;
+
+    // setup + solve vs. solve only
+    Agros2D::log()->printDebug(QObject::tr("Solver"),
+                               QObject::tr("AMG %1: %2 iterations, %3 ms (%4)")
+                               .arg(m_amgHierarchyReused ? QObject::tr("hierarchy reused (solve %1)").arg(m_amgHierarchySolves) : QObject::tr("hierarchy built"))
+                               .arg(iterations)
+                               .arg(elapsed)
+                               .arg(m_amgHierarchyReused ? QObject::tr("solve") : QObject::tr("setup and solve")));
+}
+
+// error calculation of one field (runs in thread pool)
+template <typename Scalar>
+class ErrorCalculationTask : public QRunnable
+{
+public:
+    ErrorCalculationTask(ErrorCalculator<Scalar> *errorCalculator,
+                         Hermes::vector<MeshFunctionSharedPtr<Scalar> > solutions,
+                         Hermes::vector<MeshFunctionSharedPtr<Scalar> > solutionsRef)
+        : m_errorCalculator(errorCalculator), m_solutions(solutions), m_solutionsRef(solutionsRef)
+    {
+        setAutoDelete(false);
+    }
+
+    virtual void run()
+    {
+        // exceptions must not leave the worker thread
+        try
+        {
+            m_errorCalculator->calculate_errors(m_solutions, m_solutionsRef, true);
+        }
+        catch (Hermes::Exceptions::Exception &e)
+        {
+            m_error = QString(e.what());
+        }
+        catch (std::exception &e)
+        {
+            m_error = QString(e.what());
+        }
+        catch (...)
+        {
+            m_error = QObject::tr("unknown exception");
+        }
+    }
+
+    inline QString error() const { return m_error; }
+
+private:
+    ErrorCalculator<Scalar> *m_errorCalculator;
+    Hermes::vector<MeshFunctionSharedPtr<Scalar> > m_solutions;
+    Hermes::vector<MeshFunctionSharedPtr<Scalar> > m_solutionsRef;
+
+    QString m_error;
+};
+
+// solutions are not thread safe, every task works with its own copy
+template <typename Scalar>
+Hermes::vector<MeshFunctionSharedPtr<Scalar> > cloneSolutions(Hermes::vector<MeshFunctionSharedPtr<Scalar> > solutions)
+{
+    Hermes::vector<MeshFunctionSharedPtr<Scalar> > cloned;
+    for (int i = 0; i < solutions.size(); i++)
+        cloned.push_back(MeshFunctionSharedPtr<Scalar>(solutions.at(i)->clone()));
+
+    return cloned;
 }
 
 Hermes::Solvers::ExternalSolver<double>* getExternalSolver(CSCMatrix<double> *m, SimpleVector<double> *rhs)
@@ -220,6 +341,168 @@ void AgrosExternalSolverUMFPack::setSolverCommand()
     //    str += QString("load(\"%1\", \"initial\");\n").arg(fileInitial);
 }
 
+// inner (single precision) solver reduces residual by this factor
+const float MIXED_PRECISION_INNER_RELATIVE_TOLERANCE = 1e-4;
+// outer (double precision) defect correction
+const double MIXED_PRECISION_RELATIVE_TOLERANCE = 1e-12;
+const double MIXED_PRECISION_DIVERGENCE_TOLERANCE = 1e8;
+const int MIXED_PRECISION_MAX_DEFECT_CORRECTIONS = 30;
+
+template <typename ValueType>
+paralution::IterativeLinearSolver<paralution::LocalMatrix<ValueType>, paralution::LocalVector<ValueType>, ValueType> *paralutionKrylovSolver(Hermes::Solvers::IterSolverType type)
+{
+    switch (type)
+    {
+    case Hermes::Solvers::CG:
+        return new paralution::CG<paralution::LocalMatrix<ValueType>, paralution::LocalVector<ValueType>, ValueType>();
+    case Hermes::Solvers::GMRES:
+        return new paralution::GMRES<paralution::LocalMatrix<ValueType>, paralution::LocalVector<ValueType>, ValueType>();
+    case Hermes::Solvers::CR:
+        return new paralution::CR<paralution::LocalMatrix<ValueType>, paralution::LocalVector<ValueType>, ValueType>();
+    default:
+        return new paralution::BiCGStab<paralution::LocalMatrix<ValueType>, paralution::LocalVector<ValueType>, ValueType>();
+    }
+}
+
+template <typename ValueType>
+paralution::Solver<paralution::LocalMatrix<ValueType>, paralution::LocalVector<ValueType>, ValueType> *paralutionPreconditioner(Hermes::Solvers::PreconditionerType type, bool amg)
+{
+    if (amg)
+    {
+        // one V-cycle with default smoothers
+        paralution::AMG<paralution::LocalMatrix<ValueType>, paralution::LocalVector<ValueType>, ValueType> *preconditioner
+                = new paralution::AMG<paralution::LocalMatrix<ValueType>, paralution::LocalVector<ValueType>, ValueType>();
+        preconditioner->InitMaxIter(1);
+        preconditioner->Verbose(0);
+        return preconditioner;
+    }
+
+    switch (type)
+    {
+    case Hermes::Solvers::ILU:
+        return new paralution::ILU<paralution::LocalMatrix<ValueType>, paralution::LocalVector<ValueType>, ValueType>();
+    case Hermes::Solvers::MultiColoredSGS:
+        return new paralution::MultiColoredSGS<paralution::LocalMatrix<ValueType>, paralution::LocalVector<ValueType>, ValueType>();
+    case Hermes::Solvers::MultiColoredILU:
+        return new paralution::MultiColoredILU<paralution::LocalMatrix<ValueType>, paralution::LocalVector<ValueType>, ValueType>();
+    default:
+        // saddle point and multi-elimination preconditioners need additional setup
+        return new paralution::Jacobi<paralution::LocalMatrix<ValueType>, paralution::LocalVector<ValueType>, ValueType>();
+    }
+}
+
+Hermes::Solvers::ExternalSolver<double>* getExternalSolverParalutionMixed(CSCMatrix<double> *m, SimpleVector<double> *rhs)
+{
+    return new AgrosExternalSolverParalutionMixed(m, rhs);
+}
+
+AgrosExternalSolverParalutionMixed::AgrosExternalSolverParalutionMixed(CSCMatrix<double> *m, SimpleVector<double> *rhs)
+    : ExternalSolver<double>(m, rhs), m_iterSolverType(Hermes::Solvers::BiCGStab), m_preconditionerType(Hermes::Solvers::ILU),
+      m_toleranceAbsolute(1e-16), m_maxIterations(1000), m_amg(false)
+{
+}
+
+void AgrosExternalSolverParalutionMixed::solve()
+{
+    solve(NULL);
+}
+
+void AgrosExternalSolverParalutionMixed::solve(double* initial_guess)
+{
+    typedef paralution::LocalMatrix<double> MatrixDouble;
+    typedef paralution::LocalVector<double> VectorDouble;
+    typedef paralution::LocalMatrix<float> MatrixFloat;
+    typedef paralution::LocalVector<float> VectorFloat;
+
+    // init_paralution() restarts running backend
+    paralution::Paralution_Backend_Descriptor backend;
+    paralution::_get_backend_descriptor(&backend);
+    if (!backend.init)
+        paralution::init_paralution();
+
+    int size = this->m->get_size();
+
+    // CSC storage of A is CSR storage of A^T
+    MatrixDouble matrix;
+    matrix.AllocateCSR("matrix", this->m->get_nnz(), size, size);
+    matrix.CopyFromCSR((int *) this->m->get_Ap(), (int *) this->m->get_Ai(), this->m->get_Ax());
+    matrix.Transpose();
+
+    VectorDouble rhs;
+    rhs.Allocate("rhs", size);
+    VectorDouble x;
+    x.Allocate("x", size);
+    for (int i = 0; i < size; i++)
+    {
+        rhs[i] = this->rhs->v[i];
+        x[i] = initial_guess ? initial_guess[i] : 0.0;
+    }
+
+    // inner solver has to outlive defect correction (Clear() releases it)
+    paralution::IterativeLinearSolver<MatrixFloat, VectorFloat, float> *innerSolver = paralutionKrylovSolver<float>(m_iterSolverType);
+    paralution::Solver<MatrixFloat, VectorFloat, float> *innerPreconditioner = paralutionPreconditioner<float>(m_preconditionerType, m_amg);
+    innerSolver->SetPreconditioner(*innerPreconditioner);
+    innerSolver->InitTol(0.0, MIXED_PRECISION_INNER_RELATIVE_TOLERANCE, MIXED_PRECISION_DIVERGENCE_TOLERANCE);
+    innerSolver->InitMaxIter(m_maxIterations);
+    innerSolver->Verbose(0);
+
+    paralution::MixedPrecisionDC<MatrixDouble, VectorDouble, double, MatrixFloat, VectorFloat, float> defectCorrection;
+    defectCorrection.SetOperator(matrix);
+    defectCorrection.Init(*innerSolver);
+    defectCorrection.InitTol(m_toleranceAbsolute, MIXED_PRECISION_RELATIVE_TOLERANCE, MIXED_PRECISION_DIVERGENCE_TOLERANCE);
+    defectCorrection.InitMaxIter(MIXED_PRECISION_MAX_DEFECT_CORRECTIONS);
+    defectCorrection.Verbose(0);
+    defectCorrection.Build();
+    defectCorrection.Solve(rhs, &x);
+
+    // status: 1 - absolute, 2 - relative tolerance reached, 3 - divergence, 4 - max. iterations, 0 - NaN
+    int status = defectCorrection.GetSolverStatus();
+    int corrections = defectCorrection.GetIterationCount();
+    defectCorrection.Clear();
+
+    delete innerSolver;
+    delete innerPreconditioner;
+
+    if (status != 1 && status != 2)
+    {
+        Agros2D::log()->printWarning(QObject::tr("Solver"), QObject::tr("Mixed precision solver stalled after %1 defect corrections, switching to double precision").
+                                     arg(corrections));
+
+        for (int i = 0; i < size; i++)
+            x[i] = initial_guess ? initial_guess[i] : 0.0;
+
+        paralution::IterativeLinearSolver<MatrixDouble, VectorDouble, double> *solver = paralutionKrylovSolver<double>(m_iterSolverType);
+        paralution::Solver<MatrixDouble, VectorDouble, double> *preconditioner = paralutionPreconditioner<double>(m_preconditionerType, m_amg);
+        solver->SetOperator(matrix);
+        solver->SetPreconditioner(*preconditioner);
+        solver->InitTol(m_toleranceAbsolute, MIXED_PRECISION_RELATIVE_TOLERANCE, MIXED_PRECISION_DIVERGENCE_TOLERANCE);
+        solver->InitMaxIter(m_maxIterations);
+        solver->Verbose(0);
+        solver->Build();
+        solver->Solve(rhs, &x);
+
+        status = solver->GetSolverStatus();
+        if (status != 1 && status != 2)
+            Agros2D::log()->printWarning(QObject::tr("Solver"), QObject::tr("Double precision solver did not converge (%1 iterations, residual %2)").
+                                         arg(solver->GetIterationCount()).
+                                         arg(solver->GetCurrentResidual()));
+
+        solver->Clear();
+        delete solver;
+        delete preconditioner;
+    }
+    else
+    {
+        Agros2D::log()->printDebug(QObject::tr("Solver"), QObject::tr("Mixed precision solver converged after %1 defect corrections").
+                                   arg(corrections));
+    }
+
+    delete [] this->sln;
+    this->sln = new double[size];
+    for (int i = 0; i < size; i++)
+        this->sln[i] = x[i];
+}
+
 template <typename Scalar>
 void HermesSolverContainer<Scalar>::setMatrixRhsOutputGen(Hermes::Algebra::Mixins::MatrixRhsOutput<Scalar>* solver, QString solverName, int adaptivityStep)
 {
@@ -239,8 +522,43 @@ void HermesSolverContainer<Scalar>::setMatrixRhsOutputGen(Hermes::Algebra::Mixin
     }
 }
 
+// up to this size direct solvers are faster than preconditioned Krylov methods (2D problems)
+const int AUTOMATIC_SOLVER_DIRECT_MAX_DOFS = 150000;
+
+// automatic choice of the matrix solver, returns reason of the choice
+QString automaticMatrixSolver(Block *block, int ndof,
+                              Hermes::MatrixSolverType &matrixSolver,
+                              Hermes::Solvers::IterSolverType &iterSolverType,
+                              Hermes::Solvers::PreconditionerType &preconditionerType)
+{
+    if (ndof <= AUTOMATIC_SOLVER_DIRECT_MAX_DOFS)
+    {
+#ifdef WITH_MUMPS
+        matrixSolver = Hermes::SOLVER_MUMPS;
+#else
+        matrixSolver = Hermes::SOLVER_UMFPACK;
+#endif
+        return QObject::tr("%1 DOFs, direct solver").arg(ndof);
+    }
+
+    if (block->linearityType() == LinearityType_Linear && block->isMatrixSymmetric())
+    {
+        matrixSolver = Hermes::SOLVER_PARALUTION_AMG;
+        iterSolverType = Hermes::Solvers::CG;
+        preconditionerType = Hermes::Solvers::MultiColoredSGS;
+        return QObject::tr("%1 DOFs, linear symmetric problem, algebraic multigrid with CG smoother").arg(ndof);
+    }
+
+    matrixSolver = Hermes::SOLVER_PARALUTION_ITERATIVE;
+    iterSolverType = Hermes::Solvers::GMRES;
+    preconditionerType = Hermes::Solvers::MultiColoredILU;
+    return QObject::tr("%1 DOFs, %2 problem, GMRES with multicolored ILU").
+            arg(ndof).
+            arg(block->linearityType() == LinearityType_Linear ? QObject::tr("nonsymmetric") : QObject::tr("nonlinear"));
+}
+
 template <typename Scalar>
-QSharedPointer<HermesSolverContainer<Scalar> > HermesSolverContainer<Scalar>::factory(Block* block)
+QSharedPointer<HermesSolverContainer<Scalar> > HermesSolverContainer<Scalar>::factory(Block* block, int ndof)
 {
     QString solverName;
     QListIterator<Field*> iter(block->fields());
@@ -251,13 +569,44 @@ QSharedPointer<HermesSolverContainer<Scalar> > HermesSolverContainer<Scalar>::fa
             solverName += ", ";
     }
 
-    Hermes::HermesCommonApi.set_integral_param_value(Hermes::matrixSolverType, block->matrixSolver());
-    Agros2D::log()->printDebug(QObject::tr("Solver (%1)").arg(solverName), QObject::tr("Linear solver: %1").arg(matrixSolverTypeString(block->matrixSolver())));
+    Hermes::MatrixSolverType matrixSolver = block->matrixSolver();
+    Hermes::Solvers::IterSolverType iterSolverType = block->iterLinearSolverType();
+    Hermes::Solvers::PreconditionerType preconditionerType = block->iterPreconditionerType();
+    if (block->matrixSolverAutomatic())
+    {
+        QString reason = automaticMatrixSolver(block, ndof, matrixSolver, iterSolverType, preconditionerType);
+        Agros2D::log()->printMessage(QObject::tr("Solver (%1)").arg(solverName), QObject::tr("Automatic linear solver: %1 (%2)").
+                                     arg(isMatrixSolverIterative(matrixSolver) ? QString("%1, %2, %3").
+                                                                                 arg(matrixSolverTypeString(matrixSolver)).
+                                                                                 arg(iterLinearSolverMethodString(iterSolverType)).
+                                                                                 arg(iterLinearSolverPreconditionerTypeString(preconditionerType))
+                                                                               : matrixSolverTypeString(matrixSolver)).
+                                     arg(reason));
+    }
+    Hermes::MatrixSolverType selectedMatrixSolver = matrixSolver;
+
+    // mixed precision defect correction is not a Hermes solver, route it through the external solver interface
+    bool mixedPrecision = (matrixSolver == Hermes::SOLVER_PARALUTION_ITERATIVE || matrixSolver == Hermes::SOLVER_PARALUTION_AMG)
+            && block->iterLinearSolverMixedPrecision();
+    if (mixedPrecision)
+    {
+        Agros2D::log()->printDebug(QObject::tr("Solver (%1)").arg(solverName), QObject::tr("Linear solver: mixed precision defect correction (%1, %2)").
+                                   arg(iterLinearSolverMethodString(iterSolverType)).
+                                   arg(matrixSolver == Hermes::SOLVER_PARALUTION_AMG ? QObject::tr("algebraic multigrid")
+                                                                                    : iterLinearSolverPreconditionerTypeString(preconditionerType)));
+        matrixSolver = Hermes::SOLVER_EXTERNAL;
+    }
+
+    Hermes::HermesCommonApi.set_integral_param_value(Hermes::matrixSolverType, matrixSolver);
+    Agros2D::log()->printDebug(QObject::tr("Solver (%1)").arg(solverName), QObject::tr("Linear solver: %1").arg(matrixSolverTypeString(matrixSolver)));
 
-    if (block->matrixSolver() == Hermes::SOLVER_EXTERNAL)
+    if (matrixSolver == Hermes::SOLVER_EXTERNAL)
     {
         // register external solver
-        ExternalSolver<double>::create_external_solver = getExternalSolver;
+        if (mixedPrecision)
+            ExternalSolver<double>::create_external_solver = getExternalSolverParalutionMixed;
+        else
+            ExternalSolver<double>::create_external_solver = getExternalSolver;
     }
 
     QSharedPointer<HermesSolverContainer<Scalar> > solver;
@@ -279,6 +628,8 @@ QSharedPointer<HermesSolverContainer<Scalar> > HermesSolverContainer<Scalar>::fa
 
     assert(!solver.isNull());
 
+    solver->m_matrixSolverType = selectedMatrixSolver;
+
     if (LoopSolver<Scalar> *linearSolver = dynamic_cast<LoopSolver<Scalar> *>(solver->linearSolver()))
     {
         linearSolver->set_max_iters(block->iterLinearSolverIters());
@@ -286,17 +637,33 @@ QSharedPointer<HermesSolverContainer<Scalar> > HermesSolverContainer<Scalar>::fa
     }
     if (IterativeParalutionLinearMatrixSolver<Scalar> *linearSolver = dynamic_cast<IterativeParalutionLinearMatrixSolver<Scalar> *>(solver.data()->linearSolver()))
     {
-        linearSolver->set_solver_type(block->iterLinearSolverType());
-        linearSolver->set_precond(new Hermes::Preconditioners::ParalutionPrecond<Scalar>(block->iterPreconditionerType()));
+        linearSolver->set_solver_type(iterSolverType);
+        linearSolver->set_precond(new Hermes::Preconditioners::ParalutionPrecond<Scalar>(preconditionerType));
     }
     if (AMGParalutionLinearMatrixSolver<Scalar> *linearSolver = dynamic_cast<AMGParalutionLinearMatrixSolver<Scalar> *>(solver.data()->linearSolver()))
     {
-        linearSolver->set_smoother(block->iterLinearSolverType(), block->iterPreconditionerType());
+        linearSolver->set_smoother(iterSolverType, preconditionerType);
+    }
+    if (AgrosExternalSolverParalutionMixed *linearSolver = dynamic_cast<AgrosExternalSolverParalutionMixed *>(solver.data()->linearSolver()))
+    {
+        linearSolver->setIterSolverType(iterSolverType);
+        linearSolver->setPreconditionerType(preconditionerType);
+        linearSolver->setToleranceAbsolute(block->iterLinearSolverToleranceAbsolute());
+        linearSolver->setMaxIterations(block->iterLinearSolverIters());
+        linearSolver->setAMG(selectedMatrixSolver == Hermes::SOLVER_PARALUTION_AMG);
     }
 
     return solver;
 }
 
+template <typename Scalar>
+void HermesSolverContainer<Scalar>::setSpaces(Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces)
+{
+    setTableSpaces()->set_spaces(spaces);
+    solver()->resetAMGHierarchy();
+    spacesChanged();
+}
+
 template <typename Scalar>
 void HermesSolverContainer<Scalar>::projectPreviousSolution(Scalar* solutionVector,
                                                             Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces,
@@ -445,6 +812,34 @@ Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > ProblemSolver<Scalar>:
     return newSpaces;
 }
 
+template <typename Scalar>
+Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > ProblemSolver<Scalar>::referenceSpaces(bool &reused)
+{
+    Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces = actualSpaces();
+
+    reused = (m_referenceSpaces.size() == spaces.size()) && (m_referenceSpacesCoarse.size() == spaces.size());
+    for (int i = 0; reused && i < spaces.size(); i++)
+    {
+        if ((m_referenceSpacesCoarse.at(i).get() != spaces.at(i).get()) ||
+                (m_referenceSpacesCoarseSeq.at(i) != spaces.at(i)->get_seq()))
+            reused = false;
+    }
+
+    if (reused)
+    {
+        Agros2D::log()->printDebug(m_solverID, QObject::tr("Coarse spaces unchanged, reference spaces reused"));
+        return m_referenceSpaces;
+    }
+
+    m_referenceSpaces = deepMeshAndSpaceCopy(spaces, true);
+    m_referenceSpacesCoarse = spaces;
+    m_referenceSpacesCoarseSeq.clear();
+    for (int i = 0; i < spaces.size(); i++)
+        m_referenceSpacesCoarseSeq.append(spaces.at(i)->get_seq());
+
+    return m_referenceSpaces;
+}
+
 template <typename Scalar>
 void ProblemSolver<Scalar>::setActualSpaces(Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces)
 {
@@ -463,6 +858,25 @@ Scalar *ProblemSolver<Scalar>::solveOneProblem(Hermes::vector<Hermes::Hermes2D::
                                                int adaptivityStep,
                                                Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > previousSolution)
 {
+    // automatic selection depends on the size of the solved problem (reference spaces in adaptivity)
+    if (m_block->matrixSolverAutomatic())
+    {
+        int ndof = Hermes::Hermes2D::Space<Scalar>::get_num_dofs(spaces);
+
+        Hermes::MatrixSolverType matrixSolver = m_block->matrixSolver();
+        Hermes::Solvers::IterSolverType iterSolverType = m_block->iterLinearSolverType();
+        Hermes::Solvers::PreconditionerType preconditionerType = m_block->iterPreconditionerType();
+        automaticMatrixSolver(m_block, ndof, matrixSolver, iterSolverType, preconditionerType);
+
+        if (matrixSolver != m_hermesSolverContainer->matrixSolverType())
+        {
+            // new container assembles the matrix from scratch
+            m_hermesSolverContainer = HermesSolverContainer<Scalar>::factory(m_block, ndof);
+            m_hermesSolverContainer->setWeakFormulation(m_block->weakForm());
+            m_hermesSolverContainer->setSpaces(spaces);
+        }
+    }
+
     LinearMatrixSolver<Scalar> *linearSolver = m_hermesSolverContainer->linearSolver();
 
     if (m_block->isTransient())
@@ -535,6 +949,9 @@ void ProblemSolver<Scalar>::solveSimple(int timeStep, int adaptivityStep)
         Scalar *solutionVector = solveOneProblem(actualSpaces(), adaptivityStep,
                                                  previousTSMultiSolutionArray.solutions());
 
+        if (m_block->isTransient())
+            appendTimeHistory(solutionVector, ndof);
+
         // output
         Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > solutions = createSolutions<Scalar>(spacesMeshes(actualSpaces()));
         Solution<Scalar>::vector_to_solutions(solutionVector, actualSpaces(), solutions);
@@ -549,6 +966,8 @@ void ProblemSolver<Scalar>::solveSimple(int timeStep, int adaptivityStep)
         runTime.setNonlinearDamping(solver->damping());
         runTime.setJacobianCalculations(solver->jacobianCalculations());
         runTime.setRelativeChangeOfSolutions(solver->relativeChangeOfSolutions());
+        runTime.setMatrixAssemblies(m_hermesSolverContainer->matrixAssemblies());
+        runTime.setMatrixFactorizations(m_hermesSolverContainer->matrixFactorizations());
 
         Agros2D::solutionStore()->addSolution(solutionID, MultiArray<Scalar>(actualSpaces(), solutions), runTime);
     }
@@ -558,6 +977,88 @@ void ProblemSolver<Scalar>::solveSimple(int timeStep, int adaptivityStep)
     }
 }
 
+template <typename Scalar>
+void ProblemSolver<Scalar>::appendTimeHistory(const Scalar *solutionVector, int ndof)
+{
+    double time = Agros2D::problem()->actualTime();
+
+    // space has changed, previous vectors are not compatible
+    if (!m_timeHistory.isEmpty() && m_timeHistory.last().vector.size() != ndof)
+        m_timeHistory.clear();
+
+    // remove refused steps
+    while (!m_timeHistory.isEmpty() && m_timeHistory.last().time >= time - EPS_ZERO * max(1.0, fabs(time)))
+        m_timeHistory.removeLast();
+
+    TimeHistoryEntry entry;
+    entry.time = time;
+    entry.vector.resize(ndof);
+    memcpy(entry.vector.data(), solutionVector, ndof * sizeof(Scalar));
+    m_timeHistory.append(entry);
+
+    // order + predictor points + actual solution
+    int maxSize = Agros2D::problem()->config()->value(ProblemConfig::TimeOrder).toInt() + 2;
+    while (m_timeHistory.size() > maxSize)
+        m_timeHistory.removeFirst();
+}
+
+template <typename Scalar>
+double ProblemSolver<Scalar>::estimateTimeErrorExtrapolation(int order, const Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > &timeReferenceSolution)
+{
+    // returns negative value if the history is not usable
+    // (first steps, changed number of DOFs - blocks with space adaptivity use the lower order estimator)
+    int ndof = Hermes::Hermes2D::Space<Scalar>::get_num_dofs(actualSpaces());
+    int p = order;
+    if ((p < 1) || (m_timeHistory.size() < p + 2))
+        return -1.0;
+
+    const TimeHistoryEntry &actual = m_timeHistory.last();
+    double time = Agros2D::problem()->actualTime();
+    if ((actual.vector.size() != ndof) || (fabs(actual.time - time) > EPS_ZERO * max(1.0, fabs(time))))
+        return -1.0;
+
+    // predictor: polynomial of degree p through previous p + 1 solutions evaluated at actual time
+    int last = m_timeHistory.size() - 2;
+    QVector<Scalar> predictor(ndof, Scalar(0));
+    for (int i = 0; i <= p; i++)
+    {
+        const TimeHistoryEntry &entry = m_timeHistory.at(last - i);
+
+        double weight = 1.0;
+        for (int j = 0; j <= p; j++)
+        {
+            if (i == j)
+                continue;
+
+            double tj = m_timeHistory.at(last - j).time;
+            weight *= (time - tj) / (entry.time - tj);
+        }
+
+        for (int k = 0; k < ndof; k++)
+            predictor[k] += weight * entry.vector.at(k);
+    }
+
+    Hermes::vector<Hermes::Hermes2D::MeshSharedPtr> meshes = spacesMeshes(actualSpaces());
+    Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > solutions = createSolutions<Scalar>(meshes);
+    Solution<Scalar>::vector_to_solutions(predictor.data(), actualSpaces(), solutions);
+
+    DefaultErrorCalculator<double, HERMES_H1_NORM> errorCalculator(RelativeErrorToGlobalNorm, solutions.size());
+    errorCalculator.calculate_errors(timeReferenceSolution, solutions, false);
+
+    // Milne's device for variable steps: with D = y^(p+1) / (p+1)! and P = prod_{j=0}^{p-1} (t - t_{n-j})
+    // predictor error  y - y_pred = P (t - t_{n-p}) D
+    // corrector error  y - y_bdf = -P h / alpha D, alpha = sum_{j=0}^{p-1} h / (t - t_{n-j})
+    // (constant steps: error constant -1 / ((p+1) H_p) of BDF p in the normalization of the solution)
+    double h = time - m_timeHistory.at(last).time;
+    double alpha = 0.0;
+    for (int j = 0; j < p; j++)
+        alpha += h / (time - m_timeHistory.at(last - j).time);
+
+    double corrector = h / alpha;
+    double scale = corrector / ((time - m_timeHistory.at(last - p).time) + corrector);
+    return errorCalculator.get_total_error_squared() * scale * scale;
+}
+
 template <typename Scalar>
 TimeStepInfo ProblemSolver<Scalar>::estimateTimeStepLength(int timeStep, int adaptivityStep)
 {
@@ -588,28 +1089,48 @@ TimeStepInfo ProblemSolver<Scalar>::estimateTimeStepLength(int timeStep, int ada
     }
 
     int previouslyUsedOrder = min(timeStep, Agros2D::problem()->config()->value(ProblemConfig::TimeOrder).toInt());
-    bool matrixUnchanged = m_block->weakForm()->bdf2Table()->setOrderAndPreviousSteps(previouslyUsedOrder - 1, Agros2D::problem()->timeStepLengths());
-    // using different order
-    assert(matrixUnchanged == false);
-    m_hermesSolverContainer->matrixUnchangedDueToBDF(matrixUnchanged);
-    m_block->weakForm()->set_current_time(Agros2D::problem()->actualTime());
-    m_block->weakForm()->updateExtField();
 
     // solutions obtained by time method of higher order in the original calculation
     Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > timeReferenceSolution;
     if(timeStep > 0)
         timeReferenceSolution = referenceCalculation.solutions();
-    Scalar *solutionVector = solveOneProblem(actualSpaces(), adaptivityStep, timeReferenceSolution);
 
-    Hermes::vector<Hermes::Hermes2D::MeshSharedPtr> meshes = spacesMeshes(actualSpaces());
-    Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > solutions = createSolutions<Scalar>(meshes);
-    Solution<Scalar>::vector_to_solutions(solutionVector, actualSpaces(), solutions);
+    // cheap estimate from previous solutions, no additional solve
+    double error = -1.0;
+    TimeStepEstimator timeStepEstimator = (TimeStepEstimator) Agros2D::problem()->config()->value(ProblemConfig::TimeMethodEstimator).toInt();
+    if (timeStepEstimator == TimeStepEstimator_Extrapolation)
+    {
+        // solution vectors of adapted spaces are not comparable between time steps
+        if (m_block->adaptivityType() == AdaptivityType_None)
+            error = estimateTimeErrorExtrapolation(previouslyUsedOrder, timeReferenceSolution);
+        else if (timeStep == 2)
+            Agros2D::log()->printWarning(m_solverID, QObject::tr("Extrapolation error estimator is not available with space adaptivity, lower order solution is used"));
+    }
 
-    // error calculation
-    DefaultErrorCalculator<double, HERMES_H1_NORM> errorCalculator(RelativeErrorToGlobalNorm, solutions.size());
-    // calculate error the total error estimate.
-    errorCalculator.calculate_errors(referenceCalculation.solutions(), solutions, false);
-    double error = errorCalculator.get_total_error_squared();
+    if (error < 0.0)
+    {
+        // lower order solution
+        bool matrixUnchanged = m_block->weakForm()->bdf2Table()->setOrderAndPreviousSteps(previouslyUsedOrder - 1, Agros2D::problem()->timeStepLengths());
+        // using different order
+        assert(matrixUnchanged == false);
+        m_hermesSolverContainer->matrixUnchangedDueToBDF(matrixUnchanged);
+        m_block->weakForm()->set_current_time(Agros2D::problem()->actualTime());
+        m_block->weakForm()->updateExtField();
+
+        Scalar *solutionVector = solveOneProblem(actualSpaces(), adaptivityStep, timeReferenceSolution);
+
+        Hermes::vector<Hermes::Hermes2D::MeshSharedPtr> meshes = spacesMeshes(actualSpaces());
+        Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > solutions = createSolutions<Scalar>(meshes);
+        Solution<Scalar>::vector_to_solutions(solutionVector, actualSpaces(), solutions);
+
+        // error calculation
+        DefaultErrorCalculator<double, HERMES_H1_NORM> errorCalculator(RelativeErrorToGlobalNorm, solutions.size());
+        // calculate error the total error estimate.
+        errorCalculator.calculate_errors(referenceCalculation.solutions(), solutions, false);
+        error = errorCalculator.get_total_error_squared();
+
+        timeStepEstimator = TimeStepEstimator_LowerOrder;
+    }
 
     // update
     double actualRatio = error / Agros2D::problem()->actualTimeStepLength();
@@ -650,14 +1171,15 @@ TimeStepInfo ProblemSolver<Scalar>::estimateTimeStepLength(int timeStep, int ada
     nextTimeStepLength = min(nextTimeStepLength, Agros2D::problem()->actualTimeStepLength() * maxTimeStepRatio);
     nextTimeStepLength = max(nextTimeStepLength, Agros2D::problem()->actualTimeStepLength() / maxTimeStepRatio);
 
-    Agros2D::log()->printDebug(m_solverID, QString("Time adaptivity, time %1 s, rel. error %2, tolerance %3, step size %4 -> %5 (%6 %), average err/len %7").
+    Agros2D::log()->printDebug(m_solverID, QString("Time adaptivity (%8), time %1 s, rel. error %2, tolerance %3, step size %4 -> %5 (%6 %), average err/len %7").
                                arg(Agros2D::problem()->actualTime()).
                                arg(error).
                                arg(TOL).
                                arg(Agros2D::problem()->actualTimeStepLength()).
                                arg(nextTimeStepLength).
                                arg(nextTimeStepLength / Agros2D::problem()->actualTimeStepLength()*100.).
-                               arg(m_averageErrorToLenghtRatio));
+                               arg(m_averageErrorToLenghtRatio).
+                               arg(timeStepEstimatorString(timeStepEstimator)));
     if(refuseThisStep)
         Agros2D::log()->printMessage(m_solverID, "Transient step refused");
 
@@ -741,10 +1263,10 @@ void ProblemSolver<Scalar>::createInitialSpace()
     }
 
     assert(!m_hermesSolverContainer);
-    m_hermesSolverContainer = HermesSolverContainer<Scalar>::factory(m_block);
+    m_hermesSolverContainer = HermesSolverContainer<Scalar>::factory(m_block, Hermes::Hermes2D::Space<Scalar>::get_num_dofs(m_actualSpaces));
 
     m_hermesSolverContainer->setWeakFormulation(m_block->weakForm());
-    m_hermesSolverContainer->setTableSpaces()->set_spaces(m_actualSpaces);
+    m_hermesSolverContainer->setSpaces(m_actualSpaces);
 }
 
 template <typename Scalar>
@@ -813,8 +1335,9 @@ void ProblemSolver<Scalar>::solveReferenceAndProject(int timeStep, int adaptivit
     m_block->weakForm()->set_current_time(Agros2D::problem()->actualTime());
     m_block->weakForm()->updateExtField();
 
-    // create reference spaces
-    Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spacesRef = deepMeshAndSpaceCopy(actualSpaces(), true);
+    // create reference spaces (or reuse the last ones)
+    bool referenceSpacesReused = false;
+    Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spacesRef = referenceSpaces(referenceSpacesReused);
     assert(actualSpaces().size() == spacesRef.size());
 
     // todo: delete? je to vubec potreba?
@@ -822,8 +1345,10 @@ void ProblemSolver<Scalar>::solveReferenceAndProject(int timeStep, int adaptivit
 
     // solve reference problem
 
-    // in adaptivity, in each step we use different spaces. This should be done some other way
-    m_hermesSolverContainer->setTableSpaces()->set_spaces(spacesRef);
+    // in adaptivity, in each step we use different spaces
+    // unchanged spaces keep the assembled matrix structure and the reordering in the solver
+    if (!referenceSpacesReused)
+        m_hermesSolverContainer->setSpaces(spacesRef);
     Scalar *solutionVector = solveOneProblem(spacesRef, adaptivityStep,
                                              Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> >());
 
@@ -858,6 +1383,8 @@ void ProblemSolver<Scalar>::solveReferenceAndProject(int timeStep, int adaptivit
     runTime.setNonlinearDamping(solver->damping());
     runTime.setJacobianCalculations(solver->jacobianCalculations());
     runTime.setRelativeChangeOfSolutions(solver->relativeChangeOfSolutions());
+    runTime.setMatrixAssemblies(m_hermesSolverContainer->matrixAssemblies());
+    runTime.setMatrixFactorizations(m_hermesSolverContainer->matrixFactorizations());
 
     MultiArray<Scalar> msa(actualSpaces(), solutions);
     Agros2D::solutionStore()->addSolution(solutionID, msa, runTime);
@@ -897,25 +1424,68 @@ bool ProblemSolver<Scalar>::createAdaptedSpace(int timeStep, int adaptivityStep)
         break;
     }
 
+    // error calculation
+    // every field has its own calculator, fields of the block run in parallel,
+    // all errors are known before any space is refined
+    QList<QSharedPointer<ErrorCalculator<double> > > errorCalculators;
+    foreach (Field *field, m_block->fields())
+        errorCalculators.append(QSharedPointer<ErrorCalculator<double> >(
+                                    field->fieldInfo()->plugin()->errorCalculator(field->fieldInfo(),
+                                                                                  field->fieldInfo()->value(FieldInfo::AdaptivityErrorCalculator).toString(),
+                                                                                  Hermes::Hermes2D::RelativeErrorToGlobalNorm)));
+
+    int numThreads = Agros2D::configComputer()->value(Config::Config_NumberOfThreads).toInt();
+    if ((errorCalculators.count() > 1) && (numThreads > 1))
+    {
+        QList<QSharedPointer<ErrorCalculationTask<Scalar> > > tasks;
+        foreach (QSharedPointer<ErrorCalculator<double> > errorCalculator, errorCalculators)
+            tasks.append(QSharedPointer<ErrorCalculationTask<Scalar> >(new ErrorCalculationTask<Scalar>(errorCalculator.data(),
+                                                                                                         cloneSolutions(msa.solutions()),
+                                                                                                         cloneSolutions(msaRef.solutions()))));
+
+        // threads are shared between fields (elements of one field are distributed by Hermes)
+        Hermes::HermesCommonApi.set_integral_param_value(Hermes::numThreads, max(1, numThreads / errorCalculators.count()));
+
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(min(numThreads, errorCalculators.count()));
+        foreach (QSharedPointer<ErrorCalculationTask<Scalar> > task, tasks)
+            threadPool.start(task.data());
+        threadPool.waitForDone();
+
+        Hermes::HermesCommonApi.set_integral_param_value(Hermes::numThreads, numThreads);
+
+        foreach (QSharedPointer<ErrorCalculationTask<Scalar> > task, tasks)
+        {
+            if (!task->error().isEmpty())
+            {
+                Agros2D::log()->printDebug(m_solverID, QObject::tr("Error calculation failed: %1").arg(task->error()));
+                throw AgrosSolverException(QObject::tr("Error calculation failed: %1").arg(task->error()));
+            }
+        }
+    }
+    else
+    {
+        // elements are distributed by Hermes (numThreads is set in Problem::solve)
+        foreach (QSharedPointer<ErrorCalculator<double> > errorCalculator, errorCalculators)
+            errorCalculator.data()->calculate_errors(msa.solutions(), msaRef.solutions(), true);
+    }
+
     // TODO: hard coupling
     bool adapt = false;
 
     // update error in solution store
-    foreach (Field *field, m_block->fields())
+    // refinement is applied serially in the order of fields, result does not depend on number of threads
+    for (int fieldIndex = 0; fieldIndex < m_block->fields().count(); fieldIndex++)
     {
-        // error calculation & adaptivity.
-        QSharedPointer<ErrorCalculator<double> > errorCalculator = QSharedPointer<ErrorCalculator<double> >(
-                    field->fieldInfo()->plugin()->errorCalculator(field->fieldInfo(),
-                                                                  field->fieldInfo()->value(FieldInfo::AdaptivityErrorCalculator).toString(),
-                                                                  Hermes::Hermes2D::RelativeErrorToGlobalNorm));
+        Field *field = m_block->fields().at(fieldIndex);
+        QSharedPointer<ErrorCalculator<double> > errorCalculator = errorCalculators.at(fieldIndex);
 
         // adaptivity
         Adapt<Scalar> adaptivity(errorCalculator.data(), stopingCriterion.data());
         adaptivity.set_spaces(m_actualSpaces);
         adaptivity.set_verbose_output(false);
 
-        // calculate error the total error estimate.
-        errorCalculator.data()->calculate_errors(msa.solutions(), msaRef.solutions(), true);
+        // total error estimate
         double error = errorCalculator.data()->get_total_error_squared() * 100;
 
         FieldSolutionID solutionID(field->fieldInfo(), timeStep, adaptivityStep - 1, SolutionMode_Normal);
@@ -994,6 +1564,14 @@ void ProblemSolver<Scalar>::solveInitialTimeStep()
     Agros2D::solutionStore()->addSolution(solutionID,
                                           MultiArray<Scalar>(actualSpaces(), solutions),
                                           runTime);
+
+    // initial condition starts the history of the extrapolation estimator
+    m_timeHistory.clear();
+    int ndof = Hermes::Hermes2D::Space<Scalar>::get_num_dofs(actualSpaces());
+    Scalar *initialVector = new Scalar[ndof];
+    m_hermesSolverContainer->projectPreviousSolution(initialVector, actualSpaces(), solutions);
+    appendTimeHistory(initialVector, ndof);
+    delete [] initialVector;
 }
 
 template <typename Scalar>
@@ -1005,7 +1583,7 @@ void ProblemSolver<Scalar>::resumeAdaptivityProcess(int adaptivityStep)
     setActualSpaces(msa.spaces());
 
     assert(!m_hermesSolverContainer);
-    m_hermesSolverContainer = HermesSolverContainer<Scalar>::factory(m_block);
+    m_hermesSolverContainer = HermesSolverContainer<Scalar>::factory(m_block, Hermes::Hermes2D::Space<Scalar>::get_num_dofs(m_actualSpaces));
 
 }
 
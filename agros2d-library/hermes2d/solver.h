@@ -38,7 +38,8 @@ namespace Module {
 class SolverAgros
 {
 public:
-    SolverAgros(Block *block) : m_block(block), m_jacobianCalculations(0), m_phase(Phase_Undefined) {}
+    SolverAgros(Block *block) : m_block(block), m_jacobianCalculations(0), m_phase(Phase_Undefined),
+        m_amgHierarchySolves(0), m_amgHierarchyRebuild(true), m_amgHierarchyReused(false) {}
 
     enum Phase
     {
@@ -60,6 +61,12 @@ public:
 
     void clearSteps();
 
+    // AMG hierarchy reuse between linear solves (Newton iterations, time steps)
+    void linearSolveBegin(Hermes::Algebra::LinearMatrixSolver<double> *linearSolver);
+    void linearSolveEnd(Hermes::Algebra::LinearMatrixSolver<double> *linearSolver);
+    // new spaces, next solve builds the hierarchy
+    void resetAMGHierarchy();
+
 protected:
     Block* m_block;
     Phase m_phase;
@@ -72,6 +79,13 @@ protected:
     QVector<double> m_solutionNorms;
     QVector<double> m_relativeChangeOfSolutions;
     int m_jacobianCalculations;
+
+private:
+    // number of solves with actual hierarchy
+    int m_amgHierarchySolves;
+    bool m_amgHierarchyRebuild;
+    bool m_amgHierarchyReused;
+    QElapsedTimer m_linearSolveTimer;
 };
 
 class AgrosExternalSolverExternal : public QObject, public ExternalSolver<double>
@@ -118,6 +132,30 @@ public:
     virtual void setSolverCommand();
 };
 
+// double precision defect correction around single precision Krylov solver (PARALUTION)
+class AgrosExternalSolverParalutionMixed : public ExternalSolver<double>
+{
+public:
+    AgrosExternalSolverParalutionMixed(CSCMatrix<double> *m, SimpleVector<double> *rhs);
+    void solve();
+    void solve(double* initial_guess);
+
+    // settings of the block (set by solver factory)
+    inline void setIterSolverType(Hermes::Solvers::IterSolverType iterSolverType) { m_iterSolverType = iterSolverType; }
+    inline void setPreconditionerType(Hermes::Solvers::PreconditionerType preconditionerType) { m_preconditionerType = preconditionerType; }
+    inline void setToleranceAbsolute(double toleranceAbsolute) { m_toleranceAbsolute = toleranceAbsolute; }
+    inline void setMaxIterations(int maxIterations) { m_maxIterations = maxIterations; }
+    // AMG preconditioner instead of preconditionerType
+    inline void setAMG(bool amg) { m_amg = amg; }
+
+private:
+    Hermes::Solvers::IterSolverType m_iterSolverType;
+    Hermes::Solvers::PreconditionerType m_preconditionerType;
+    double m_toleranceAbsolute;
+    int m_maxIterations;
+    bool m_amg;
+};
+
 struct TimeStepInfo
 {
     TimeStepInfo(double len, bool ref = false) : length(len), refuse(ref) {}
@@ -129,7 +167,7 @@ template <typename Scalar>
 class HermesSolverContainer
 {
 public:
-    HermesSolverContainer(Block* block) : m_block(block), m_slnVector(NULL), m_constJacobianPossible(false) {}
+    HermesSolverContainer(Block* block) : m_block(block), m_slnVector(NULL), m_constJacobianPossible(false), m_matrixSolverType(Hermes::SOLVER_UMFPACK) {}
     virtual ~HermesSolverContainer() {}
 
     void projectPreviousSolution(Scalar* solutionVector,
@@ -143,20 +181,32 @@ public:
     virtual void setMatrixRhsOutput(QString solverName, int adaptivityStep) = 0;
     void setMatrixRhsOutputGen(Hermes::Algebra::Mixins::MatrixRhsOutput<Scalar>* solver, QString solverName, int adaptivityStep);
 
+    void setSpaces(Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces);
+    virtual void spacesChanged() {}
+
     virtual void matrixUnchangedDueToBDF(bool unchanged) {}
     virtual Hermes::Algebra::LinearMatrixSolver<Scalar> *linearSolver() = 0;
 
+    // statistics of the last solve
+    virtual int matrixAssemblies() const { return solver()->jacobianCalculations(); }
+    virtual int matrixFactorizations() const { return solver()->jacobianCalculations(); }
+
     inline Scalar *slnVector() { return m_slnVector; }
     virtual SolverAgros *solver() const = 0;
 
+    // matrix solver chosen by factory (after automatic selection)
+    inline Hermes::MatrixSolverType matrixSolverType() const { return m_matrixSolverType; }
+
     // solver factory
-    static QSharedPointer<HermesSolverContainer<Scalar> > factory(Block* block);
+    static QSharedPointer<HermesSolverContainer<Scalar> > factory(Block* block, int ndof);
 
 protected:
     Block* m_block;
     Scalar *m_slnVector;
 
     bool m_constJacobianPossible;
+
+    Hermes::MatrixSolverType m_matrixSolverType;
 };
 
 // solve
@@ -199,6 +249,25 @@ private:
     // to be used in advanced time step adaptivity
     double m_averageErrorToLenghtRatio;
 
+    // previous solution vectors (extrapolation error estimator)
+    struct TimeHistoryEntry
+    {
+        double time;
+        QVector<Scalar> vector;
+    };
+    QList<TimeHistoryEntry> m_timeHistory;
+
+    // reference spaces of the last reference solution and coarse spaces they were created from
+    Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > m_referenceSpaces;
+    Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > m_referenceSpacesCoarse;
+    QList<int> m_referenceSpacesCoarseSeq;
+
+    // returns cached reference spaces if coarse spaces are unchanged
+    Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > referenceSpaces(bool &reused);
+
+    void appendTimeHistory(const Scalar *solutionVector, int ndof);
+    double estimateTimeErrorExtrapolation(int order, const Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > &timeReferenceSolution);
+
     void initSelectors(Hermes::vector<QSharedPointer<Hermes::Hermes2D::RefinementSelectors::Selector<Scalar> > >& selectors);
 
     Scalar *solveOneProblem(Hermes::vector<Hermes::Hermes2D::SpaceSharedPtr<Scalar> > spaces, int adaptivityStep, Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > previousSolution = Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> >());
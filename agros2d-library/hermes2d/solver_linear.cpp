@@ -48,12 +48,14 @@ LinearSolverAgros<Scalar>::LinearSolverAgros(Block *block)
 }
 
 template <typename Scalar>
-LinearSolverContainer<Scalar>::LinearSolverContainer(Block* block) : HermesSolverContainer<Scalar>(block)
+LinearSolverContainer<Scalar>::LinearSolverContainer(Block* block) : HermesSolverContainer<Scalar>(block),
+    m_matrixConstant(false), m_matrixAssembled(false), m_matrixReused(false)
 {
     m_linearSolver = new LinearSolverAgros<Scalar>(block);
     m_linearSolver->set_verbose_output(false);
 
-    this->m_constJacobianPossible = true;
+    // time dependent coefficients and external fields change the matrix in each time step
+    this->m_constJacobianPossible = !block->isTransient() || block->isMatrixTimeIndependent();
 }
 
 template <typename Scalar>
@@ -66,14 +68,27 @@ LinearSolverContainer<Scalar>::~LinearSolverContainer()
 template <typename Scalar>
 void LinearSolverContainer<Scalar>::matrixUnchangedDueToBDF(bool unchanged)
 {
-    m_linearSolver->set_jacobian_constant(unchanged && this->m_constJacobianPossible);
+    m_matrixConstant = unchanged && this->m_constJacobianPossible;
+    m_linearSolver->set_jacobian_constant(m_matrixConstant);
 }
 
 template <typename Scalar>
 void LinearSolverContainer<Scalar>::solve(Scalar* previousSolutionVector)
 {
+    m_matrixReused = m_matrixConstant && m_matrixAssembled;
+    if (m_matrixReused)
+    {
+        // assemble right hand side only and reuse numeric factorization
+        linearSolver()->set_reuse_scheme(HERMES_REUSE_MATRIX_STRUCTURE_COMPLETELY);
+        Agros2D::log()->printDebug(QObject::tr("Solver"), QObject::tr("Matrix unchanged, factorization reused"));
+    }
+
+    m_linearSolver->linearSolveBegin(linearSolver());
     m_linearSolver->solve(previousSolutionVector);
+    m_linearSolver->linearSolveEnd(linearSolver());
     this->m_slnVector = m_linearSolver->get_sln_vector();
+
+    m_matrixAssembled = true;
 }
 
 //template class VectorStore<double>;
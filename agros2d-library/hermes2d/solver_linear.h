@@ -54,12 +54,23 @@ public:
     virtual Hermes::Hermes2D::Mixins::SettableSpaces<Scalar>* setTableSpaces() { return m_linearSolver; }
     virtual void setWeakFormulation(Hermes::Hermes2D::WeakForm<Scalar>* wf) {m_linearSolver->set_weak_formulation(wf); }
     virtual void matrixUnchangedDueToBDF(bool unchanged);
+    virtual void spacesChanged() { m_matrixAssembled = false; }
     virtual LinearMatrixSolver<Scalar> *linearSolver() { return m_linearSolver->get_linear_matrix_solver(); }
 
     virtual SolverAgros *solver() const { return m_linearSolver; }
 
+    virtual int matrixAssemblies() const { return m_matrixReused ? 0 : 1; }
+    virtual int matrixFactorizations() const { return m_matrixReused ? 0 : 1; }
+
 private:
     LinearSolverAgros<Scalar> *m_linearSolver;
+
+    // matrix and its factorization can be reused
+    bool m_matrixConstant;
+    // matrix assembled and factorized for actual spaces
+    bool m_matrixAssembled;
+    // only right hand side assembled in the last solve
+    bool m_matrixReused;
 };
 
 #endif // SOLVER_LINEAR_H
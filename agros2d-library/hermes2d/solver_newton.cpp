@@ -39,9 +39,9 @@ NewtonSolverAgros<Scalar>::NewtonSolverAgros(Block *block)
 template <typename Scalar>
 bool NewtonSolverAgros<Scalar>::on_initialization()
 {
-    m_residualNorms.clear();
-    m_solutionNorms.clear();
-    m_relativeChangeOfSolutions.clear();
+    m_residualNorms.resize(0);
+    m_solutionNorms.resize(0);
+    m_relativeChangeOfSolutions.resize(0);
 
     return !Agros2D::problem()->isAborted();
 }
@@ -57,12 +57,16 @@ bool NewtonSolverAgros<Scalar>::on_initial_step_end()
 template <typename Scalar>
 bool NewtonSolverAgros<Scalar>::on_step_begin()
 {
+    linearSolveBegin(this->get_linear_matrix_solver());
+
     return !Agros2D::problem()->isAborted();
 }
 
 template <typename Scalar>
 bool NewtonSolverAgros<Scalar>::on_step_end()
 {
+    linearSolveEnd(this->get_linear_matrix_solver());
+
     return !Agros2D::problem()->isAborted();
 }
 
@@ -122,6 +126,28 @@ void NewtonSolverAgros<Scalar>::setError()
     assert(m_steps.size() == m_solutionNorms.size());
     assert(m_steps.size() == m_relativeChangeOfSolutions.size());
 
+    if (m_phase == Phase_Finished)
+    {
+        m_jacobianCalculations = 0;
+        for (int i = 0; i < jacobian_recalculated_log.size(); i++)
+            if (jacobian_recalculated_log.at(i))
+                m_jacobianCalculations++;
+    }
+
+    m_damping.append(current_damping_factor);
+
+    // iterations are formatted only if configured, summary is always printed
+    bool logIterations = Agros2D::log()->isSolverIterationLogged();
+    if (logIterations || (m_phase == Phase_Finished))
+        printStep(iteration, current_damping_factor, previous_damping_factor);
+
+    if (logIterations)
+        Agros2D::log()->updateNonlinearChartInfo(m_phase, m_steps, m_relativeChangeOfSolutions);
+}
+
+template <typename Scalar>
+void NewtonSolverAgros<Scalar>::printStep(int iteration, double current_damping_factor, double previous_damping_factor)
+{
     if (m_phase == Phase_Init)
     {
         assert(iteration == 0);
@@ -146,29 +172,11 @@ void NewtonSolverAgros<Scalar>::setError()
     }
     else if (m_phase == Phase_Finished)
     {
-        QString reuses;
-        m_jacobianCalculations = 0;
-        for (int i = 0; i < jacobian_recalculated_log.size(); i++)
-        {
-            if(jacobian_recalculated_log.at(i))
-            {
-                m_jacobianCalculations++;
-                reuses.append("F ");
-            }
-            else
-            {
-                reuses.append("T ");
-            }
-        }
-
         Agros2D::log()->printMessage(QObject::tr("Solver (Newton)"), QObject::tr("Calculation finished (Jacobian recalculated %1x)")
                                      .arg(m_jacobianCalculations));
     }
     else
         assert(0);
-
-    m_damping.append(current_damping_factor);
-    Agros2D::log()->updateNonlinearChartInfo(m_phase, m_steps, m_relativeChangeOfSolutions);
 }
 
 template <typename Scalar>
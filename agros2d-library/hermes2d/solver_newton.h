@@ -48,6 +48,9 @@ public:
 
 protected:
     virtual void setError();
+
+private:
+    void printStep(int iteration, double current_damping_factor, double previous_damping_factor);
 };
 template <typename Scalar>
 class NewtonSolverContainer : public HermesSolverContainer<Scalar>
@@ -39,7 +39,7 @@ PicardSolverAgros<Scalar>::PicardSolverAgros(Block *block)
 template <typename Scalar>
 bool PicardSolverAgros<Scalar>::on_initialization()
 {
-    m_relativeChangeOfSolutions.clear();
+    m_relativeChangeOfSolutions.resize(0);
 
     return !Agros2D::problem()->isAborted();
 }
@@ -55,12 +55,16 @@ bool PicardSolverAgros<Scalar>::on_initial_step_end()
 template <typename Scalar>
 bool PicardSolverAgros<Scalar>::on_step_begin()
 {
+    linearSolveBegin(this->get_linear_matrix_solver());
+
     return !Agros2D::problem()->isAborted();
 }
 
 template <typename Scalar>
 bool PicardSolverAgros<Scalar>::on_step_end()
 {
+    linearSolveEnd(this->get_linear_matrix_solver());
+
     m_phase = Phase_DFDetermined;
     setError();
     return !Agros2D::problem()->isAborted();
@@ -80,7 +84,8 @@ void PicardSolverAgros<Scalar>::setError()
     if (m_phase == Phase_Init)
     {
         m_jacobianCalculations = 0;
-        Agros2D::log()->printMessage(QObject::tr("Solver (Picard)"), QObject::tr("Initial step"));
+        if (Agros2D::log()->isSolverIterationLogged())
+            Agros2D::log()->printMessage(QObject::tr("Solver (Picard)"), QObject::tr("Initial step"));
         return;
     }
 
@@ -107,22 +112,25 @@ void PicardSolverAgros<Scalar>::setError()
     assert(m_steps.size() == m_solutionNorms.size());
     assert(m_steps.size() == m_relativeChangeOfSolutions.size());
 
+    assert(m_phase == Phase_DFDetermined || m_phase == Phase_Finished);
+
+    m_damping.append(current_damping_factor);
+
+    // iterations are formatted only if configured, summary is always printed
+    bool logIterations = Agros2D::log()->isSolverIterationLogged();
     if (m_phase == Phase_DFDetermined)
     {
-        Agros2D::log()->printMessage(QObject::tr("Solver (Picard)"), QObject::tr("Iteration: %1 (rel. change of sol.: %3 %, damping: %2)")
-                                     .arg(iteration)
-                                     .arg(previous_damping_factor)
-                                     .arg(QString::number(m_relativeChangeOfSolutions.last(), 'f', 5)));
-    }
-    else if (m_phase == Phase_Finished)
-    {
-        Agros2D::log()->printMessage(QObject::tr("Solver (Picard)"), QObject::tr("Calculation finished"));
+        if (logIterations)
+            Agros2D::log()->printMessage(QObject::tr("Solver (Picard)"), QObject::tr("Iteration: %1 (rel. change of sol.: %3 %, damping: %2)")
+                                         .arg(iteration)
+                                         .arg(previous_damping_factor)
+                                         .arg(QString::number(m_relativeChangeOfSolutions.last(), 'f', 5)));
     }
     else
-        assert(0);
+        Agros2D::log()->printMessage(QObject::tr("Solver (Picard)"), QObject::tr("Calculation finished"));
 
-    m_damping.append(current_damping_factor);
-    Agros2D::log()->updateNonlinearChartInfo(m_phase, m_steps, m_relativeChangeOfSolutions);
+    if (logIterations)
+        Agros2D::log()->updateNonlinearChartInfo(m_phase, m_steps, m_relativeChangeOfSolutions);
 }
 
 template <typename Scalar>
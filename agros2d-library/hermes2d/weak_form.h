@@ -2,6 +2,7 @@
 #define WEAK_FORM_H
 
 #include "form_info.h"
+#include "solutiontypes.h"
 
 class BDF2Table;
 class Block;
@@ -152,6 +153,16 @@ private:
     Hermes::vector<Hermes::Hermes2D::UExtFunctionSharedPtr<Scalar> > quantitiesAndSpecialFunctions(const FieldInfo* fieldInfo, bool linearize) const;
     Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > previousTimeLevelsSolutions(const FieldInfo* fieldInfo) const;
     Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > sourceCouplingSolutions(const FieldInfo* fieldInfo) const;
+
+    // weak coupling sources are kept between solves of the block until the source field changes
+    // (solution store cache would otherwise read them from disk again in each outer iteration)
+    struct SourceCoupling
+    {
+        FieldSolutionID solutionID;
+        int revision;
+        Hermes::vector<Hermes::Hermes2D::MeshFunctionSharedPtr<Scalar> > solutions;
+    };
+    mutable QMap<const FieldInfo *, SourceCoupling> m_sourceCouplings;
 };
 
 #endif // WEAK_FORM_H
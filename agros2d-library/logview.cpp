@@ -20,6 +20,7 @@
 #include "logview.h"
 
 #include "util/global.h"
+#include "util/conf.h"
 #include "util/constants.h"
 #include "util/memory_monitor.h"
 #include "gui/common.h"
@@ -39,6 +40,11 @@ Log::Log()
     qRegisterMetaType<SolverAgros::Phase>("SolverAgros::Phase");
 }
 
+bool Log::isSolverIterationLogged() const
+{
+    return Agros2D::configComputer()->value(Config::Config_LogSolverIterations).toBool();
+}
+
 // *******************************************************************************************************
 
 LogWidget::LogWidget(QWidget *parent) : QWidget(parent),
@@ -286,8 +292,8 @@ LogDialog::~LogDialog()
 void LogDialog::createControls()
 {
     connect(Agros2D::log(), SIGNAL(errorMsg(QString, QString)), this, SLOT(printError(QString, QString)));
-    connect(Agros2D::log(), SIGNAL(updateNonlinearChart(SolverAgros::Phase, const QVector<double>, const QVector<double>)),
-            this, SLOT(updateNonlinearChartInfo(SolverAgros::Phase, const QVector<double>, const QVector<double>)));
+    connect(Agros2D::log(), SIGNAL(updateNonlinearChart(SolverAgros::Phase, const QVector<double> &, const QVector<double> &)),
+            this, SLOT(updateNonlinearChartInfo(SolverAgros::Phase, const QVector<double> &, const QVector<double> &)));
     connect(Agros2D::log(), SIGNAL(updateAdaptivityChart(const FieldInfo *, int, int)), this, SLOT(updateAdaptivityChartInfo(const FieldInfo *, int, int)));
     connect(Agros2D::log(), SIGNAL(updateTransientChart(double)), this, SLOT(updateTransientChartInfo(double)));
     connect(Agros2D::log(), SIGNAL(addIconImg(QIcon, QString)), this, SLOT(addIcon(QIcon, QString)));
@@ -514,11 +520,20 @@ void LogDialog::printError(const QString &module, const QString &message)
     m_logWidget->setVisible(true);
 }
 
-void LogDialog::updateNonlinearChartInfo(SolverAgros::Phase phase, const QVector<double> steps, const QVector<double> relativeChangeOfSolutions)
+// maximum refresh rate of solver charts
+const int CHART_FRAMES_PER_SECOND = 10;
+
+void LogDialog::updateNonlinearChartInfo(SolverAgros::Phase phase, const QVector<double> &steps, const QVector<double> &relativeChangeOfSolutions)
 {
     if (!m_nonlinearErrorGraph)
         return;
 
+    // first and last steps are always drawn
+    if ((phase != SolverAgros::Phase_Init) && (phase != SolverAgros::Phase_Finished)
+            && m_nonlinearChartTimer.isValid() && (m_nonlinearChartTimer.elapsed() < 1000 / CHART_FRAMES_PER_SECOND))
+        return;
+    m_nonlinearChartTimer.start();
+
     m_nonlinearErrorGraph->setData(steps, relativeChangeOfSolutions);
     m_nonlinearChart->rescaleAxes();
     m_nonlinearChart->replot(QCustomPlot::rpImmediate);
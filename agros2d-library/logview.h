@@ -40,12 +40,15 @@ public:
     inline void printWarning(const QString &module, const QString &message) { emit warningMsg(module, message); }
     inline void printDebug(const QString &module, const QString &message) { emit debugMsg(module, message); }
 
-    inline void updateNonlinearChartInfo(SolverAgros::Phase phase, const QVector<double> steps, const QVector<double> relativeChangeOfSolutions) { emit updateNonlinearChart(phase, steps, relativeChangeOfSolutions); }
+    inline void updateNonlinearChartInfo(SolverAgros::Phase phase, const QVector<double> &steps, const QVector<double> &relativeChangeOfSolutions) { emit updateNonlinearChart(phase, steps, relativeChangeOfSolutions); }
     inline void updateAdaptivityChartInfo(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep) { emit updateAdaptivityChart(fieldInfo, timeStep, adaptivityStep); }
     inline void updateTransientChartInfo(double actualTime) { emit updateTransientChart(actualTime); }
 
     inline void addIcon(const QIcon &icn, const QString &label) { emit addIconImg(icn, label); }
 
+    // messages and chart of nonlinear iterations (Config_LogSolverIterations)
+    bool isSolverIterationLogged() const;
+
 signals:
     void headingMsg(const QString &message);
     void messageMsg(const QString &module, const QString &message);
@@ -53,7 +56,7 @@ signals:
     void warningMsg(const QString &module, const QString &message);
     void debugMsg(const QString &module, const QString &message);
 
-    void updateNonlinearChart(SolverAgros::Phase phase, const QVector<double> steps, const QVector<double> relativeChangeOfSolutions);
+    void updateNonlinearChart(SolverAgros::Phase phase, const QVector<double> &steps, const QVector<double> &relativeChangeOfSolutions);
     void updateAdaptivityChart(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep);
     void updateTransientChart(double actualTime);
 
@@ -140,6 +143,8 @@ private:
     QCustomPlot *m_nonlinearChart;
     QCPGraph *m_nonlinearErrorGraph;
     QProgressBar *m_nonlinearProgress;
+    // replot throttling
+    QElapsedTimer m_nonlinearChartTimer;
 
     QCustomPlot *m_adaptivityChart;
     QCPGraph *m_adaptivityErrorGraph;
@@ -158,7 +163,7 @@ private:
 private slots:    
     void printError(const QString &module, const QString &message);
 
-    void updateNonlinearChartInfo(SolverAgros::Phase phase, const QVector<double> steps, const QVector<double> relativeChangeOfSolutions);
+    void updateNonlinearChartInfo(SolverAgros::Phase phase, const QVector<double> &steps, const QVector<double> &relativeChangeOfSolutions);
     void updateAdaptivityChartInfo(const FieldInfo *fieldInfo, int timeStep, int adaptivityStep);
     void updateTransientChartInfo(double actualTime);
 
@@ -130,8 +130,8 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
     connect(currentPythonEngineAgros(), SIGNAL(executedScript()), this, SLOT(doExecutedScript()));
 
     // post hermes
-    connect(problemWidget, SIGNAL(changed()), postHermes, SLOT(refresh()));
-    connect(postprocessorWidget, SIGNAL(apply()), postHermes, SLOT(refresh()));
+    connect(problemWidget, SIGNAL(changed()), postHermes, SLOT(refreshAsync()));
+    connect(postprocessorWidget, SIGNAL(apply()), postHermes, SLOT(refreshAsync()));
     currentPythonEngineAgros()->setPostHermes(postHermes);
 
     connect(Agros2D::problem(), SIGNAL(meshed()), this, SLOT(setControls()));
@@ -1229,7 +1229,7 @@ void MainWindow::doOptions()
     if (configDialog.exec())
     {
         sceneViewPreprocessor->refresh();
-        postHermes->refresh();
+        postHermes->refreshAsync();
         // setControls();
     }
 }
@@ -47,6 +47,24 @@ MeshGenerator::~MeshGenerator()
 
 using namespace Hermes::Hermes2D;
 
+MeshGeneratorCached::MeshGeneratorCached(Hermes::vector<MeshSharedPtr> meshes) : MeshGenerator()
+{
+    m_meshes = copyMeshes(meshes);
+}
+
+Hermes::vector<MeshSharedPtr> MeshGeneratorCached::copyMeshes(Hermes::vector<MeshSharedPtr> meshes)
+{
+    Hermes::vector<MeshSharedPtr> copies;
+    for (int i = 0; i < meshes.size(); i++)
+    {
+        MeshSharedPtr mesh(new Mesh());
+        mesh->copy(meshes[i]);
+        copies.push_back(mesh);
+    }
+
+    return copies;
+}
+
 void MeshGenerator::moveNodesOnCurvedEdges()
 {
     // move nodes (arcs)
@@ -218,4 +218,16 @@ protected:
     Hermes::vector<Hermes::Hermes2D::MeshSharedPtr> m_meshes;
 };
 
+/// Mesh "generator" returning copies of previously generated meshes (geometry unchanged).
+class AGROS_LIBRARY_API MeshGeneratorCached : public MeshGenerator
+{
+public:
+    MeshGeneratorCached(Hermes::vector<Hermes::Hermes2D::MeshSharedPtr> meshes);
+
+    virtual bool mesh() { return true; }
+
+    /// Deep copy - initial meshes are refined in place.
+    static Hermes::vector<Hermes::Hermes2D::MeshSharedPtr> copyMeshes(Hermes::vector<Hermes::Hermes2D::MeshSharedPtr> meshes);
+};
+
 #endif //MESHGENERATOR_H
@@ -148,11 +148,13 @@ void FieldWidget::createContent()
     cmbAnalysisType = new QComboBox();
     cmbLinearityType = new QComboBox();
     cmbLinearSolver = new QComboBox();
+    chkLinearSolverAutomatic = new QCheckBox(tr("Automatic selection"));
 
     connect(cmbAdaptivityType, SIGNAL(currentIndexChanged(int)), this, SLOT(doAdaptivityChanged(int)));
     connect(cmbAnalysisType, SIGNAL(currentIndexChanged(int)), this, SLOT(doAnalysisTypeChanged(int)));
     connect(cmbLinearityType, SIGNAL(currentIndexChanged(int)), this, SLOT(doLinearityTypeChanged(int)));
     connect(cmbLinearSolver, SIGNAL(currentIndexChanged(int)), this, SLOT(doLinearSolverChanged(int)));
+    connect(chkLinearSolverAutomatic, SIGNAL(stateChanged(int)), this, SLOT(doLinearSolverChanged(int)));
 
     // mesh
     txtNumberOfRefinements = new QSpinBox(this);
@@ -172,6 +174,7 @@ void FieldWidget::createContent()
     layoutGeneral->addWidget(cmbLinearityType, 1, 1);
     layoutGeneral->addWidget(new QLabel(tr("Matrix solver:")), 2, 0);
     layoutGeneral->addWidget(cmbLinearSolver, 2, 1);
+    layoutGeneral->addWidget(chkLinearSolverAutomatic, 3, 1);
 
     QGroupBox *grpGeneral = new QGroupBox(tr("General"));
     grpGeneral->setLayout(layoutGeneral);
@@ -462,6 +465,13 @@ QWidget *FieldWidget::createLinearSolverWidget()
     txtIterLinearSolverIters = new QSpinBox();
     txtIterLinearSolverIters->setMinimum(1);
     txtIterLinearSolverIters->setMaximum(10000);
+    txtIterLinearSolverAMGReuseSolves = new QSpinBox();
+    txtIterLinearSolverAMGReuseSolves->setMinimum(0);
+    txtIterLinearSolverAMGReuseSolves->setMaximum(1000);
+    txtIterLinearSolverAMGReuseIters = new QSpinBox();
+    txtIterLinearSolverAMGReuseIters->setMinimum(1);
+    txtIterLinearSolverAMGReuseIters->setMaximum(10000);
+    chkIterLinearSolverMixedPrecision = new QCheckBox(tr("Mixed precision (single precision inner solver)"));
 
     QGridLayout *iterSolverLayout = new QGridLayout();
     iterSolverLayout->addWidget(new QLabel(tr("Method:")), 0, 0);
@@ -472,6 +482,11 @@ QWidget *FieldWidget::createLinearSolverWidget()
     iterSolverLayout->addWidget(txtIterLinearSolverToleranceAbsolute, 2, 1);
     iterSolverLayout->addWidget(new QLabel(tr("Maximum number of iterations:")), 3, 0);
     iterSolverLayout->addWidget(txtIterLinearSolverIters, 3, 1);
+    iterSolverLayout->addWidget(new QLabel(tr("AMG hierarchy reused in solves:")), 4, 0);
+    iterSolverLayout->addWidget(txtIterLinearSolverAMGReuseSolves, 4, 1);
+    iterSolverLayout->addWidget(new QLabel(tr("AMG hierarchy rebuilt above iterations:")), 5, 0);
+    iterSolverLayout->addWidget(txtIterLinearSolverAMGReuseIters, 5, 1);
+    iterSolverLayout->addWidget(chkIterLinearSolverMixedPrecision, 6, 1);
 
     QGroupBox *iterSolverGroup = new QGroupBox(tr("Iterative solver"));
     iterSolverGroup->setLayout(iterSolverLayout);
@@ -565,6 +580,7 @@ void FieldWidget::load()
     txtAdaptivityRedoneEach->setValue(m_fieldInfo->value(FieldInfo::AdaptivityTransientRedoneEach).toInt());
     // matrix solver
     cmbLinearSolver->setCurrentIndex(cmbLinearSolver->findData(m_fieldInfo->matrixSolver()));
+    chkLinearSolverAutomatic->setChecked(m_fieldInfo->value(FieldInfo::LinearSolverAutomatic).toBool());
     //mesh
     txtNumberOfRefinements->setValue(m_fieldInfo->value(FieldInfo::SpaceNumberOfRefinements).toInt());
     txtPolynomialOrder->setValue(m_fieldInfo->value(FieldInfo::SpacePolynomialOrder).toInt());
@@ -592,6 +608,9 @@ void FieldWidget::load()
     cmbIterLinearSolverPreconditioner->setCurrentIndex((Hermes::Solvers::PreconditionerType) cmbIterLinearSolverPreconditioner->findData(m_fieldInfo->value(FieldInfo::LinearSolverIterPreconditioner).toInt()));
     txtIterLinearSolverToleranceAbsolute->setValue(m_fieldInfo->value(FieldInfo::LinearSolverIterToleranceAbsolute).toDouble());
     txtIterLinearSolverIters->setValue(m_fieldInfo->value(FieldInfo::LinearSolverIterIters).toInt());
+    txtIterLinearSolverAMGReuseSolves->setValue(m_fieldInfo->value(FieldInfo::LinearSolverAMGReuseSolves).toInt());
+    txtIterLinearSolverAMGReuseIters->setValue(m_fieldInfo->value(FieldInfo::LinearSolverAMGReuseIters).toInt());
+    chkIterLinearSolverMixedPrecision->setChecked(m_fieldInfo->value(FieldInfo::LinearSolverMixedPrecision).toBool());
 
     doAnalysisTypeChanged(cmbAnalysisType->currentIndex());
 }
@@ -615,6 +634,7 @@ bool FieldWidget::save()
     m_fieldInfo->setValue(FieldInfo::AdaptivityTransientRedoneEach, txtAdaptivityRedoneEach->value());
     // matrix solver
     m_fieldInfo->setMatrixSolver((Hermes::MatrixSolverType) cmbLinearSolver->itemData(cmbLinearSolver->currentIndex()).toInt());
+    m_fieldInfo->setValue(FieldInfo::LinearSolverAutomatic, chkLinearSolverAutomatic->isChecked());
     //mesh
     m_fieldInfo->setValue(FieldInfo::SpaceNumberOfRefinements, txtNumberOfRefinements->value());
     m_fieldInfo->setValue(FieldInfo::SpacePolynomialOrder, txtPolynomialOrder->value());
@@ -640,6 +660,9 @@ bool FieldWidget::save()
     m_fieldInfo->setValue(FieldInfo::LinearSolverIterPreconditioner, cmbIterLinearSolverPreconditioner->itemData(cmbIterLinearSolverPreconditioner->currentIndex()).toInt());
     m_fieldInfo->setValue(FieldInfo::LinearSolverIterToleranceAbsolute, txtIterLinearSolverToleranceAbsolute->value());
     m_fieldInfo->setValue(FieldInfo::LinearSolverIterIters, txtIterLinearSolverIters->value());
+    m_fieldInfo->setValue(FieldInfo::LinearSolverAMGReuseSolves, txtIterLinearSolverAMGReuseSolves->value());
+    m_fieldInfo->setValue(FieldInfo::LinearSolverAMGReuseIters, txtIterLinearSolverAMGReuseIters->value());
+    m_fieldInfo->setValue(FieldInfo::LinearSolverMixedPrecision, chkIterLinearSolverMixedPrecision->isChecked());
 
     return true;
 }
@@ -738,12 +761,17 @@ void FieldWidget::doLinearityTypeChanged(int index)
 void FieldWidget::doLinearSolverChanged(int index)
 {
     Hermes::MatrixSolverType solverType = (Hermes::MatrixSolverType) cmbLinearSolver->itemData(cmbLinearSolver->currentIndex()).toInt();
-    bool isIterative = ((solverType == Hermes::SOLVER_PARALUTION_ITERATIVE) || (solverType == Hermes::SOLVER_PARALUTION_AMG));
+    bool isAutomatic = chkLinearSolverAutomatic->isChecked();
+    bool isIterative = !isAutomatic && ((solverType == Hermes::SOLVER_PARALUTION_ITERATIVE) || (solverType == Hermes::SOLVER_PARALUTION_AMG));
 
+    cmbLinearSolver->setEnabled(!isAutomatic);
     cmbIterLinearSolverMethod->setEnabled(isIterative);
     cmbIterLinearSolverPreconditioner->setEnabled(isIterative);
     txtIterLinearSolverToleranceAbsolute->setEnabled(isIterative);
     txtIterLinearSolverIters->setEnabled(isIterative);
+    txtIterLinearSolverAMGReuseSolves->setEnabled(isAutomatic || solverType == Hermes::SOLVER_PARALUTION_AMG);
+    txtIterLinearSolverAMGReuseIters->setEnabled(isAutomatic || solverType == Hermes::SOLVER_PARALUTION_AMG);
+    chkIterLinearSolverMixedPrecision->setEnabled(isAutomatic || isIterative);
 }
 
 void FieldWidget::doNonlinearDampingChanged(int index)
@@ -1168,6 +1196,7 @@ void ProblemWidget::createControls()
 
     // transient
     cmbTransientMethod = new QComboBox();
+    cmbTransientEstimator = new QComboBox();
     txtTransientOrder = new QSpinBox();
     txtTransientOrder->setMinimum(1);
     txtTransientOrder->setMaximum(3);
@@ -1195,15 +1224,17 @@ void ProblemWidget::createControls()
     layoutTransientAnalysis->addWidget(txtTransientOrder, 1, 2);
     layoutTransientAnalysis->addWidget(new QLabel(tr("Tolerance:")), 2, 0, 1, 2);
     layoutTransientAnalysis->addWidget(txtTransientTolerance, 2, 2);
-    layoutTransientAnalysis->addWidget(lblTransientTimeTotal, 3, 0, 1, 2);
-    layoutTransientAnalysis->addWidget(txtTransientTimeTotal, 3, 2);
-    layoutTransientAnalysis->addWidget(lblTransientSteps, 4, 0, 1, 2);
-    layoutTransientAnalysis->addWidget(txtTransientSteps, 4, 2);
-    layoutTransientAnalysis->addWidget(new QLabel(tr("Initial time step:")), 5, 0);
-    layoutTransientAnalysis->addWidget(chkTransientInitialStepSize, 5, 1, 1, 1, Qt::AlignRight);
-    layoutTransientAnalysis->addWidget(txtTransientInitialStepSize, 5, 2);
-    layoutTransientAnalysis->addWidget(new QLabel(tr("Constant time step:")), 6, 0, 1, 2);
-    layoutTransientAnalysis->addWidget(lblTransientTimeStep, 6, 2);
+    layoutTransientAnalysis->addWidget(new QLabel(tr("Error estimator:")), 3, 0, 1, 2);
+    layoutTransientAnalysis->addWidget(cmbTransientEstimator, 3, 2);
+    layoutTransientAnalysis->addWidget(lblTransientTimeTotal, 4, 0, 1, 2);
+    layoutTransientAnalysis->addWidget(txtTransientTimeTotal, 4, 2);
+    layoutTransientAnalysis->addWidget(lblTransientSteps, 5, 0, 1, 2);
+    layoutTransientAnalysis->addWidget(txtTransientSteps, 5, 2);
+    layoutTransientAnalysis->addWidget(new QLabel(tr("Initial time step:")), 6, 0);
+    layoutTransientAnalysis->addWidget(chkTransientInitialStepSize, 6, 1, 1, 1, Qt::AlignRight);
+    layoutTransientAnalysis->addWidget(txtTransientInitialStepSize, 6, 2);
+    layoutTransientAnalysis->addWidget(new QLabel(tr("Constant time step:")), 7, 0, 1, 2);
+    layoutTransientAnalysis->addWidget(lblTransientTimeStep, 7, 2);
 
     grpTransientAnalysis = new QGroupBox(tr("Transient analysis"));
     grpTransientAnalysis->setLayout(layoutTransientAnalysis);
@@ -1302,6 +1333,10 @@ void ProblemWidget::fillComboBox()
     cmbTransientMethod->addItem(timeStepMethodString(TimeStepMethod_Fixed), TimeStepMethod_Fixed);
     cmbTransientMethod->addItem(timeStepMethodString(TimeStepMethod_BDFTolerance), TimeStepMethod_BDFTolerance);
     cmbTransientMethod->addItem(timeStepMethodString(TimeStepMethod_BDFNumSteps), TimeStepMethod_BDFNumSteps);
+
+    cmbTransientEstimator->clear();
+    cmbTransientEstimator->addItem(timeStepEstimatorString(TimeStepEstimator_LowerOrder), TimeStepEstimator_LowerOrder);
+    cmbTransientEstimator->addItem(timeStepEstimatorString(TimeStepEstimator_Extrapolation), TimeStepEstimator_Extrapolation);
 }
 
 void ProblemWidget::updateControls()
@@ -1346,6 +1381,9 @@ void ProblemWidget::updateControls()
     cmbTransientMethod->setCurrentIndex(cmbTransientMethod->findData((TimeStepMethod) Agros2D::problem()->config()->value(ProblemConfig::TimeMethod).toInt()));
     if (cmbTransientMethod->currentIndex() == -1)
         cmbTransientMethod->setCurrentIndex(0);
+    cmbTransientEstimator->setCurrentIndex(cmbTransientEstimator->findData((TimeStepEstimator) Agros2D::problem()->config()->value(ProblemConfig::TimeMethodEstimator).toInt()));
+    if (cmbTransientEstimator->currentIndex() == -1)
+        cmbTransientEstimator->setCurrentIndex(0);
 
     lblTransientTimeTotal->setText(QString("Total time (%1)").arg(Agros2D::problem()->timeUnit()));
 
@@ -1369,6 +1407,7 @@ void ProblemWidget::updateControls()
 
     // transient
     connect(cmbTransientMethod, SIGNAL(currentIndexChanged(int)), this, SLOT(changedWithClear()));
+    connect(cmbTransientEstimator, SIGNAL(currentIndexChanged(int)), this, SLOT(changedWithClear()));
     connect(txtTransientSteps, SIGNAL(valueChanged(int)), this, SLOT(changedWithClear()));
     connect(txtTransientTimeTotal, SIGNAL(textChanged(QString)), this, SLOT(changedWithClear()));
     connect(txtTransientOrder, SIGNAL(valueChanged(int)), this, SLOT(changedWithClear()));
@@ -1397,6 +1436,7 @@ void ProblemWidget::changedWithClear()
     Agros2D::problem()->config()->setValue(ProblemConfig::TimeMethod, (TimeStepMethod) cmbTransientMethod->itemData(cmbTransientMethod->currentIndex()).toInt());
     Agros2D::problem()->config()->setValue(ProblemConfig::TimeOrder, txtTransientOrder->value());
     Agros2D::problem()->config()->setValue(ProblemConfig::TimeMethodTolerance, txtTransientTolerance->value());
+    Agros2D::problem()->config()->setValue(ProblemConfig::TimeMethodEstimator, (TimeStepEstimator) cmbTransientEstimator->itemData(cmbTransientEstimator->currentIndex()).toInt());
     Agros2D::problem()->config()->setValue(ProblemConfig::TimeConstantTimeSteps, txtTransientSteps->value());
     Agros2D::problem()->config()->setValue(ProblemConfig::TimeTotal, txtTransientTimeTotal->value());
     txtTransientInitialStepSize->setEnabled(chkTransientInitialStepSize->isChecked());
@@ -1428,6 +1468,7 @@ void ProblemWidget::transientChanged()
         chkTransientInitialStepSize->setEnabled(false);
         txtTransientInitialStepSize->setEnabled(false);
         txtTransientTolerance->setEnabled(false);
+        cmbTransientEstimator->setEnabled(false);
         txtTransientSteps->setEnabled(true);
 
     }
@@ -1435,12 +1476,14 @@ void ProblemWidget::transientChanged()
     {
         chkTransientInitialStepSize->setEnabled(true);
         txtTransientTolerance->setEnabled(true);
+        cmbTransientEstimator->setEnabled(true);
         txtTransientSteps->setEnabled(false);
     }
     else if (((TimeStepMethod) Agros2D::problem()->config()->value(ProblemConfig::TimeMethod).toInt()) == TimeStepMethod_BDFNumSteps)
     {
         chkTransientInitialStepSize->setEnabled(true);
         txtTransientTolerance->setEnabled(false);
+        cmbTransientEstimator->setEnabled(true);
         txtTransientSteps->setEnabled(true);
     }
 
@@ -122,6 +122,7 @@ private:
 
     QComboBox *cmbLinearityType;
     QComboBox *cmbLinearSolver;
+    QCheckBox *chkLinearSolverAutomatic;
 
     // mesh
     QSpinBox *txtNumberOfRefinements;
@@ -156,6 +157,9 @@ private:
     QComboBox *cmbIterLinearSolverPreconditioner;
     LineEditDouble *txtIterLinearSolverToleranceAbsolute;
     QSpinBox *txtIterLinearSolverIters;
+    QSpinBox *txtIterLinearSolverAMGReuseSolves;
+    QSpinBox *txtIterLinearSolverAMGReuseIters;
+    QCheckBox *chkIterLinearSolverMixedPrecision;
 
     // equation
     // LaTeXViewer *equationLaTeX;
@@ -257,6 +261,7 @@ private:
     QLabel *lblTransientTimeTotal;
     QSpinBox *txtTransientOrder;
     QComboBox *cmbTransientMethod;
+    QComboBox *cmbTransientEstimator;
     QLabel *lblTransientTimeStep;
 
     // couplings
@@ -100,6 +100,14 @@ void PyProblem::setTimeMethodTolerance(double timeMethodTolerance)
         throw out_of_range(QObject::tr("The time method tolerance must be positive.").toStdString());
 }
 
+void PyProblem::setTimeStepEstimator(const std::string &timeStepEstimator)
+{
+    if (timeStepEstimatorStringKeys().contains(QString::fromStdString(timeStepEstimator)))
+        Agros2D::problem()->config()->setValue(ProblemConfig::TimeMethodEstimator, (TimeStepEstimator) timeStepEstimatorFromStringKey(QString::fromStdString(timeStepEstimator)));
+    else
+        throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(timeStepEstimatorStringKeys())).toStdString());
+}
+
 void PyProblem::setTimeInitialTimeStep(double timeInitialTimeStep)
 {
     if (timeInitialTimeStep > 0.0)
@@ -59,6 +59,10 @@ class PyProblem
         inline double getTimeMethodTolerance() const { return Agros2D::problem()->config()->value(ProblemConfig::TimeMethodTolerance).toDouble(); }
         void setTimeMethodTolerance(double timeMethodTolerance);
 
+        // time step error estimator
+        inline std::string getTimeStepEstimator() const { return timeStepEstimatorToStringKey((TimeStepEstimator) Agros2D::problem()->config()->value(ProblemConfig::TimeMethodEstimator).toInt()).toStdString(); }
+        void setTimeStepEstimator(const std::string &timeStepEstimator);
+
         // initial time step
         inline double getTimeInitialTimeStep() const { return Agros2D::problem()->config()->value(ProblemConfig::TimeInitialStepSize).toDouble(); }
         void setTimeInitialTimeStep(double timeInitialTimeStep);
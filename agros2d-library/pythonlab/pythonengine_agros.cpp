@@ -22,6 +22,10 @@
 #include "logview.h"
 #include "hermes2d/plugin_interface.h"
 #include "hermes2d/module.h"
+#include "sceneview_geometry.h"
+#include "sceneview_mesh.h"
+#include "sceneview_post2d.h"
+#include "sceneview_post3d.h"
 #ifdef _MSC_VER
 # ifdef _DEBUG
 #  undef _DEBUG
@@ -82,6 +86,45 @@ void PythonEngineAgros::abortScript()
     PythonEngine::abortScript();
 }
 
+PostHermes *PythonEngineAgros::postHermes()
+{
+    // settings of the views are processed without OpenGL context (solver)
+    if (!m_postHermes)
+    {
+        m_postHermes = new PostHermes();
+
+        // problem was meshed or solved before the views were created
+        if (Agros2D::problem()->isMeshed())
+            m_postHermes->problemMeshed();
+        if (Agros2D::problem()->isSolved())
+            m_postHermes->problemSolved();
+    }
+
+    return m_postHermes;
+}
+
+void PythonEngineAgros::createOffscreenSceneViews()
+{
+    if (hasSceneViews())
+        return;
+
+    m_sceneViewPreprocessor = new SceneViewPreprocessor();
+    m_sceneViewMesh = new SceneViewMesh(postHermes());
+    m_sceneViewPost2D = new SceneViewPost2D(postHermes());
+    m_sceneViewPost3D = new SceneViewPost3D(postHermes());
+    m_sceneViewParticleTracing = new SceneViewParticleTracing(postHermes());
+
+    QList<SceneViewCommon *> sceneViews;
+    sceneViews << m_sceneViewPreprocessor << m_sceneViewMesh << m_sceneViewPost2D << m_sceneViewPost3D << m_sceneViewParticleTracing;
+    foreach (SceneViewCommon *sceneView, sceneViews)
+    {
+        // window system is needed for the OpenGL context only
+        sceneView->setAttribute(Qt::WA_DontShowOnScreen);
+        sceneView->resize(800, 600);
+        sceneView->show();
+    }
+}
+
 void PythonEngineAgros::materialValues(const QString &function, double from, double to,
                                        QVector<double> *keys, QVector<double> *values, int count)
 {
@@ -296,6 +339,10 @@ QString createPythonFromModel()
             str += QString("problem.time_steps = %1\n").
                     arg(Agros2D::problem()->config()->value(ProblemConfig::TimeConstantTimeSteps).toInt());
         }
+        if (((TimeStepMethod) Agros2D::problem()->config()->value(ProblemConfig::TimeMethod).toInt()) != TimeStepMethod_Fixed &&
+                ((TimeStepEstimator) Agros2D::problem()->config()->value(ProblemConfig::TimeMethodEstimator).toInt()) != TimeStepEstimator_Extrapolation)
+            str += QString("problem.time_step_estimator = \"%1\"\n").
+                    arg(timeStepEstimatorToStringKey((TimeStepEstimator) Agros2D::problem()->config()->value(ProblemConfig::TimeMethodEstimator).toInt()));
         if (((TimeStepMethod) Agros2D::problem()->config()->value(ProblemConfig::TimeMethod).toInt()) != TimeStepMethod_Fixed &&
                 (Agros2D::problem()->config()->value(ProblemConfig::TimeInitialStepSize).toDouble() > 0.0))
             str += QString("problem.time_initial_time_step = %1\n").
@@ -318,6 +365,9 @@ QString createPythonFromModel()
         str += QString("%1.matrix_solver = \"%2\"\n").
                 arg(fieldInfo->fieldId()).
                 arg(matrixSolverTypeToStringKey(fieldInfo->matrixSolver()));
+        if (fieldInfo->value(FieldInfo::LinearSolverAutomatic).toBool())
+            str += QString("%1.matrix_solver_parameters['automatic'] = True\n").
+                    arg(fieldInfo->fieldId());
 
         if ((fieldInfo->matrixSolver() == Hermes::SOLVER_PARALUTION_ITERATIVE) || (fieldInfo->matrixSolver() == Hermes::SOLVER_PARALUTION_AMG))
         {
@@ -334,6 +384,9 @@ QString createPythonFromModel()
                     arg(fieldInfo->fieldId()).
                     arg(fieldInfo->value(FieldInfo::LinearSolverIterIters).toInt());
         }
+        if (fieldInfo->value(FieldInfo::LinearSolverMixedPrecision).toBool())
+            str += QString("%1.matrix_solver_parameters['mixed_precision'] = True\n").
+                    arg(fieldInfo->fieldId());
 
         if (Agros2D::problem()->isTransient())
         {
@@ -44,20 +44,25 @@ class AGROS_LIBRARY_API PythonEngineAgros : public PythonEngine
     Q_OBJECT
 public:
     PythonEngineAgros() : PythonEngine(),
-        m_sceneViewPreprocessor(NULL), m_sceneViewMesh(NULL), m_sceneViewPost2D(NULL), m_sceneViewPost3D(NULL) {}
+        m_sceneViewPreprocessor(NULL), m_sceneViewMesh(NULL), m_sceneViewPost2D(NULL), m_sceneViewPost3D(NULL),
+        m_sceneViewParticleTracing(NULL), m_postHermes(NULL) {}
 
     inline void setSceneViewPreprocessor(SceneViewPreprocessor *sceneViewPreprocessor) { assert(sceneViewPreprocessor); m_sceneViewPreprocessor = sceneViewPreprocessor; }
-    inline SceneViewPreprocessor *sceneViewPreprocessor() { assert(m_sceneViewPreprocessor); return m_sceneViewPreprocessor; }
+    inline SceneViewPreprocessor *sceneViewPreprocessor() { createOffscreenSceneViews(); assert(m_sceneViewPreprocessor); return m_sceneViewPreprocessor; }
     inline void setSceneViewMesh(SceneViewMesh *sceneViewMesh) { assert(sceneViewMesh); m_sceneViewMesh = sceneViewMesh; }
-    inline SceneViewMesh *sceneViewMesh() { assert(m_sceneViewMesh); return m_sceneViewMesh; }
+    inline SceneViewMesh *sceneViewMesh() { createOffscreenSceneViews(); assert(m_sceneViewMesh); return m_sceneViewMesh; }
     inline void setSceneViewPost2D(SceneViewPost2D *sceneViewPost2D) { assert(sceneViewPost2D); m_sceneViewPost2D = sceneViewPost2D; }
-    inline SceneViewPost2D *sceneViewPost2D() {assert(m_sceneViewPost2D); return m_sceneViewPost2D; }
+    inline SceneViewPost2D *sceneViewPost2D() { createOffscreenSceneViews(); assert(m_sceneViewPost2D); return m_sceneViewPost2D; }
     inline void setSceneViewPost3D(SceneViewPost3D *sceneViewPost3D) { assert(sceneViewPost3D); m_sceneViewPost3D = sceneViewPost3D; }
-    inline SceneViewPost3D *sceneViewPost3D() { assert(m_sceneViewPost3D); return m_sceneViewPost3D; }
+    inline SceneViewPost3D *sceneViewPost3D() { createOffscreenSceneViews(); assert(m_sceneViewPost3D); return m_sceneViewPost3D; }
     inline void setSceneViewParticleTracing(SceneViewParticleTracing *sceneViewParticleTracing) { assert(sceneViewParticleTracing); m_sceneViewParticleTracing = sceneViewParticleTracing; }
-    inline SceneViewParticleTracing *sceneViewParticleTracing() { assert(m_sceneViewParticleTracing); return m_sceneViewParticleTracing; }
+    inline SceneViewParticleTracing *sceneViewParticleTracing() { createOffscreenSceneViews(); assert(m_sceneViewParticleTracing); return m_sceneViewParticleTracing; }
     inline void setPostHermes(PostHermes *postHermes) { assert(postHermes); m_postHermes = postHermes; }
-    inline PostHermes *postHermes() { assert(m_postHermes); return m_postHermes; }
+    PostHermes *postHermes();
+
+    // solver has no main window, views are created on first use and scene views are rendered offscreen
+    inline bool hasSceneViews() const { return m_sceneViewPreprocessor; }
+    void createOffscreenSceneViews();
 
     inline void setConsole(PythonScriptingConsole *console) { m_console = console; }
     inline void resetConsole() { m_console = NULL; }
@@ -32,6 +32,17 @@
 
 SceneViewCommon* PyView::currentSceneViewMode()
 {
+    // offscreen views (solver) follow the state of the problem
+    if (silentMode())
+    {
+        if (Agros2D::problem()->isSolved())
+            return currentPythonEngineAgros()->sceneViewPost2D();
+        else if (Agros2D::problem()->isMeshed())
+            return currentPythonEngineAgros()->sceneViewMesh();
+        else
+            return currentPythonEngineAgros()->sceneViewPreprocessor();
+    }
+
     if (currentPythonEngineAgros()->sceneViewMesh()->actSceneModeMesh->isChecked())
         return currentPythonEngineAgros()->sceneViewMesh();
     else if (currentPythonEngineAgros()->sceneViewPost2D()->actSceneModePost2D->isChecked())
@@ -47,8 +58,11 @@ SceneViewCommon* PyView::currentSceneViewMode()
 
 void PyView::saveImageToFile(const std::string &file, int width, int height)
 {
-    if (!silentMode())
-        currentSceneViewMode()->saveImageToFile(QString::fromStdString(file), width, height);
+    // views changed by the script are processed before export (solver - scene is rendered offscreen)
+    if (Agros2D::problem()->isMeshed())
+        currentPythonEngineAgros()->postHermes()->refresh();
+
+    currentSceneViewMode()->saveImageToFile(QString::fromStdString(file), width, height);
 }
 
 void PyView::zoomBestFit()
@@ -79,9 +93,6 @@ void PyView::zoomRegion(double x1, double y1, double x2, double y2)
 
 void PyViewConfig::setFontFamily(Config::Type type, const std::string &family)
 {
-    if (silentMode())
-        return;
-
     QStringList filter;
     filter << "*.ttf";
     QStringList list = QDir(datadir() + "/resources/fonts").entryList(filter);
@@ -112,9 +123,6 @@ void PyViewMeshAndPost::setActiveTimeStep(int timeStep)
     if (timeStep < 0 || timeStep >= Agros2D::problem()->numTimeLevels())
         throw out_of_range(QObject::tr("Time step must be in the range from 0 to %1.").arg(Agros2D::problem()->numTimeLevels() - 1).toStdString());
 
-    if (silentMode())
-        return;
-
     FieldInfo *fieldInfo = currentPythonEngineAgros()->postHermes()->activeViewField();
     if (!Agros2D::solutionStore()->timeLevels(fieldInfo).contains(Agros2D::problem()->timeStepToTotalTime(timeStep)))
         throw out_of_range(QObject::tr("Field '%1' does not have solution for time step %2 (%3 s).").arg(fieldInfo->fieldId()).
@@ -125,7 +133,6 @@ void PyViewMeshAndPost::setActiveTimeStep(int timeStep)
 
     currentPythonEngineAgros()->postHermes()->setActiveTimeStep(timeStep);
     currentPythonEngineAgros()->postHermes()->setActiveAdaptivityStep(adaptivityStep);
-    currentPythonEngineAgros()->postHermes()->refresh();
 }
 
 void PyViewMeshAndPost::setActiveAdaptivityStep(int adaptivityStep)
@@ -142,11 +149,7 @@ void PyViewMeshAndPost::setActiveAdaptivityStep(int adaptivityStep)
                            .arg(currentPythonEngineAgros()->postHermes()->activeViewField()->fieldId())
                            .arg(last_step + 1).toStdString());
 
-    if (!silentMode())
-    {
-        currentPythonEngineAgros()->postHermes()->setActiveAdaptivityStep(adaptivityStep - 1);
-        currentPythonEngineAgros()->postHermes()->refresh();
-    }
+    currentPythonEngineAgros()->postHermes()->setActiveAdaptivityStep(adaptivityStep - 1);
 }
 
 void PyViewMeshAndPost::setActiveSolutionType(const std::string &solutionType)
@@ -161,11 +164,7 @@ void PyViewMeshAndPost::setActiveSolutionType(const std::string &solutionType)
         throw logic_error(QObject::tr("Field '%1' was not solved with space adaptivity.").
                           arg(currentPythonEngineAgros()->postHermes()->activeViewField()->fieldId()).toStdString());
 
-    if (!silentMode())
-    {
-        currentPythonEngineAgros()->postHermes()->setActiveAdaptivitySolutionType(solutionTypeFromStringKey(QString::fromStdString(solutionType)));
-        currentPythonEngineAgros()->postHermes()->refresh();
-    }
+    currentPythonEngineAgros()->postHermes()->setActiveAdaptivitySolutionType(solutionTypeFromStringKey(QString::fromStdString(solutionType)));
 }
 
 // ************************************************************************************
@@ -180,19 +179,17 @@ void PyViewMesh::setProblemSetting(ProblemSetting::Type type, bool value)
 {
     checkExistingMesh();
 
-    if (!silentMode())
-        Agros2D::problem()->setting()->setValue(type, value);
+    Agros2D::problem()->setting()->setValue(type, value);
+    currentPythonEngineAgros()->postHermes()->invalidate();
 }
 
 void PyViewMesh::activate()
 {
     checkExistingMesh();
 
+    // views are processed before the view is painted
     if (!silentMode())
-    {
         currentPythonEngineAgros()->sceneViewMesh()->actSceneModeMesh->trigger();
-        currentPythonEngineAgros()->postHermes()->refresh();
-    }
 }
 
 void PyViewMesh::refresh()
@@ -210,13 +207,9 @@ void PyViewMesh::setField(const std::string &fieldId)
     if (!Agros2D::problem()->hasField(QString::fromStdString(fieldId)))
         throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(Agros2D::problem()->fieldInfos().keys())).toStdString());
 
-    if (silentMode())
-        return;
-
     FieldInfo *fieldInfo = Agros2D::problem()->fieldInfo(QString::fromStdString(fieldId));
 
     currentPythonEngineAgros()->postHermes()->setActiveViewField(fieldInfo);
-    currentPythonEngineAgros()->postHermes()->refresh();
 }
 
 void PyViewMesh::setOrderViewPalette(const std::string &palette)
@@ -226,8 +219,7 @@ void PyViewMesh::setOrderViewPalette(const std::string &palette)
     if (!paletteOrderTypeStringKeys().contains(QString::fromStdString(palette)))
         throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(paletteOrderTypeStringKeys())).toStdString());
 
-    if (!silentMode())
-        Agros2D::problem()->setting()->setValue(ProblemSetting::View_OrderPaletteOrderType, paletteOrderTypeFromStringKey(QString::fromStdString(palette)));
+    Agros2D::problem()->setting()->setValue(ProblemSetting::View_OrderPaletteOrderType, paletteOrderTypeFromStringKey(QString::fromStdString(palette)));
 }
 
 void PyViewMesh::setComponent(int component)
@@ -237,8 +229,8 @@ void PyViewMesh::setComponent(int component)
     if (component < 1 && component > currentPythonEngineAgros()->postHermes()->activeViewField()->numberOfSolutions())
         throw out_of_range(QObject::tr("Component must be in the range from 1 to %1.").arg(currentPythonEngineAgros()->postHermes()->activeViewField()->numberOfSolutions()).toStdString());
 
-    if (!silentMode())
-        Agros2D::problem()->setting()->setValue(ProblemSetting::View_OrderComponent, component);
+    Agros2D::problem()->setting()->setValue(ProblemSetting::View_OrderComponent, component);
+    currentPythonEngineAgros()->postHermes()->invalidate(PostHermes::ViewType_SolutionMesh | PostHermes::ViewType_Order);
 }
 
 // ************************************************************************************
@@ -253,8 +245,8 @@ void PyViewPost::setProblemSetting(ProblemSetting::Type type, bool value)
 {
     checkExistingSolution();
 
-    if (!silentMode())
-        Agros2D::problem()->setting()->setValue(type, value);
+    Agros2D::problem()->setting()->setValue(type, value);
+    currentPythonEngineAgros()->postHermes()->invalidate();
 }
 
 void PyViewPost::setField(const std::string &fieldId)
@@ -264,9 +256,6 @@ void PyViewPost::setField(const std::string &fieldId)
     if (!Agros2D::problem()->hasField(QString::fromStdString(fieldId)))
         throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(Agros2D::problem()->fieldInfos().keys())).toStdString());
 
-    if (silentMode())
-        return;
-
     FieldInfo *fieldInfo = Agros2D::problem()->fieldInfo(QString::fromStdString(fieldId));
     SolutionMode solutionType = currentPythonEngineAgros()->postHermes()->activeAdaptivitySolutionType();
     int timeStep = currentPythonEngineAgros()->postHermes()->activeTimeStep();
@@ -284,7 +273,6 @@ void PyViewPost::setField(const std::string &fieldId)
     currentPythonEngineAgros()->postHermes()->setActiveTimeStep(timeStep);
     currentPythonEngineAgros()->postHermes()->setActiveAdaptivityStep(adaptivityStep);
     currentPythonEngineAgros()->postHermes()->setActiveAdaptivitySolutionType(solutionType);
-    currentPythonEngineAgros()->postHermes()->refresh();
 }
 
 void PyViewPost::setScalarViewVariable(const std::string &var)
@@ -297,11 +285,9 @@ void PyViewPost::setScalarViewVariable(const std::string &var)
         list.append(variable.id());
         if (variable.id() == QString::fromStdString(var))
         {
-            if (!silentMode())
-            {
-                Agros2D::problem()->setting()->setValue(ProblemSetting::View_ScalarVariable, QString::fromStdString(var));
-                return;
-            }
+            Agros2D::problem()->setting()->setValue(ProblemSetting::View_ScalarVariable, QString::fromStdString(var));
+            currentPythonEngineAgros()->postHermes()->invalidate(PostHermes::ViewType_Scalar);
+            return;
         }
     }
 
@@ -315,8 +301,8 @@ void PyViewPost::setScalarViewVariableComp(const std::string &component)
     if (!physicFieldVariableCompTypeStringKeys().contains(QString::fromStdString(component)))
         throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(physicFieldVariableCompTypeStringKeys())).toStdString());
 
-    if (!silentMode())
-        Agros2D::problem()->setting()->setValue(ProblemSetting::View_ScalarVariableComp, physicFieldVariableCompFromStringKey(QString::fromStdString(component)));
+    Agros2D::problem()->setting()->setValue(ProblemSetting::View_ScalarVariableComp, physicFieldVariableCompFromStringKey(QString::fromStdString(component)));
+    currentPythonEngineAgros()->postHermes()->invalidate(PostHermes::ViewType_Scalar);
 }
 
 void PyViewPost::setScalarViewPalette(const std::string &palette)
@@ -326,8 +312,7 @@ void PyViewPost::setScalarViewPalette(const std::string &palette)
     if (!paletteTypeStringKeys().contains(QString::fromStdString(palette)))
         throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(paletteTypeStringKeys())).toStdString());
 
-    if (!silentMode())
-        Agros2D::problem()->setting()->setValue(ProblemSetting::View_PaletteType, paletteTypeFromStringKey(QString::fromStdString(palette)));
+    Agros2D::problem()->setting()->setValue(ProblemSetting::View_PaletteType, paletteTypeFromStringKey(QString::fromStdString(palette)));
 }
 
 // ************************************************************************************
@@ -336,11 +321,9 @@ void PyViewPost2D::activate()
 {
     checkExistingSolution();
 
+    // views are processed before the view is painted
     if (!silentMode())
-    {
         currentPythonEngineAgros()->sceneViewPost2D()->actSceneModePost2D->trigger();
-        currentPythonEngineAgros()->postHermes()->refresh();
-    }
 }
 
 void PyViewPost2D::refresh()
@@ -364,11 +347,9 @@ void PyViewPost2D::setContourVariable(const std::string &var)
 
             if (variable.id() == QString::fromStdString(var))
             {
-                if (!silentMode())
-                {
-                    Agros2D::problem()->setting()->setValue(ProblemSetting::View_ContourVariable, QString::fromStdString(var));
-                    return;
-                }
+                Agros2D::problem()->setting()->setValue(ProblemSetting::View_ContourVariable, QString::fromStdString(var));
+                currentPythonEngineAgros()->postHermes()->invalidate(PostHermes::ViewType_Contour);
+                return;
             }
         }
     }
@@ -400,11 +381,9 @@ void PyViewPost2D::setVectorVariable(const std::string &var)
         list.append(variable.id());
         if (variable.id() == QString::fromStdString(var))
         {
-            if (!silentMode())
-            {
-                Agros2D::problem()->setting()->setValue(ProblemSetting::View_VectorVariable, QString::fromStdString(var));
-                return;
-            }
+            Agros2D::problem()->setting()->setValue(ProblemSetting::View_VectorVariable, QString::fromStdString(var));
+            currentPythonEngineAgros()->postHermes()->invalidate(PostHermes::ViewType_Vector);
+            return;
         }
     }
 
@@ -418,8 +397,7 @@ void PyViewPost2D::setVectorType(const std::string &type)
     if (!vectorTypeStringKeys().contains(QString::fromStdString(type)))
         throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(vectorTypeStringKeys())).toStdString());
 
-    if (!silentMode())
-        Agros2D::problem()->setting()->setValue(ProblemSetting::View_VectorType, vectorTypeFromStringKey(QString::fromStdString(type)));
+    Agros2D::problem()->setting()->setValue(ProblemSetting::View_VectorType, vectorTypeFromStringKey(QString::fromStdString(type)));
 }
 
 void PyViewPost2D::setVectorCenter(const std::string &center)
@@ -429,8 +407,7 @@ void PyViewPost2D::setVectorCenter(const std::string &center)
     if (!vectorCenterStringKeys().contains(QString::fromStdString(center)))
         throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(vectorCenterStringKeys())).toStdString());
 
-    if (!silentMode())
-        Agros2D::problem()->setting()->setValue(ProblemSetting::View_VectorCenter, vectorCenterFromStringKey(QString::fromStdString(center)));
+    Agros2D::problem()->setting()->setValue(ProblemSetting::View_VectorCenter, vectorCenterFromStringKey(QString::fromStdString(center)));
 }
 
 // ************************************************************************************
@@ -439,11 +416,9 @@ void PyViewPost3D::activate()
 {
     checkExistingSolution();
 
+    // views are processed before the view is painted
     if (!silentMode())
-    {
         currentPythonEngineAgros()->sceneViewPost3D()->actSceneModePost3D->trigger();
-        currentPythonEngineAgros()->postHermes()->refresh();
-    }
 }
 
 void PyViewPost3D::refresh()
@@ -459,8 +434,8 @@ void PyViewPost3D::setPost3DMode(const std::string &mode)
     if (!sceneViewPost3DModeStringKeys().contains(QString::fromStdString(mode)))
         throw invalid_argument(QObject::tr("Invalid argument. Valid keys: %1").arg(stringListToString(sceneViewPost3DModeStringKeys())).toStdString());
 
-    if (!silentMode())
-        Agros2D::problem()->setting()->setValue(ProblemSetting::View_ScalarView3DMode, sceneViewPost3DModeFromStringKey(QString::fromStdString(mode)));
+    Agros2D::problem()->setting()->setValue(ProblemSetting::View_ScalarView3DMode, sceneViewPost3DModeFromStringKey(QString::fromStdString(mode)));
+    currentPythonEngineAgros()->postHermes()->invalidate(PostHermes::ViewType_Scalar);
 }
 
 // ************************************************************************************
@@ -470,11 +445,9 @@ void PyViewParticleTracing::activate()
     if (!Agros2D::problem()->isSolved())
         throw logic_error(QObject::tr("Problem is not solved.").toStdString());
 
+    // views are processed before the view is painted
     if (!silentMode())
-    {
         currentPythonEngineAgros()->sceneViewParticleTracing()->actSceneModeParticleTracing->trigger();
-        currentPythonEngineAgros()->postHermes()->refresh();
-    }
 }
 
 void PyViewParticleTracing::refresh()
@@ -67,8 +67,7 @@ struct PyViewConfig : PyViewClass
     {
         ProblemSetting::Type type = Agros2D::problem()->setting()->stringKeyToType(QString::fromStdString(parameter));
 
-        if (!silentMode())
-            Agros2D::problem()->setting()->setValue(type, value);
+        Agros2D::problem()->setting()->setValue(type, value);
     }
 
     // fonts
@@ -114,8 +113,8 @@ struct PyViewMesh : PyViewMeshAndPost
         checkExistingMesh();
         ProblemSetting::Type type = Agros2D::problem()->setting()->stringKeyToType(QString::fromStdString(parameter));
 
-        if (!silentMode())
-            Agros2D::problem()->setting()->setValue(type, value);
+        Agros2D::problem()->setting()->setValue(type, value);
+        currentPythonEngineAgros()->postHermes()->invalidate();
     }
 
     void checkExistingMesh();
@@ -163,8 +162,8 @@ struct PyViewPost : PyViewMeshAndPost
         checkExistingSolution();
         ProblemSetting::Type type = Agros2D::problem()->setting()->stringKeyToType(QString::fromStdString(parameter));
 
-        if (!silentMode())
-            Agros2D::problem()->setting()->setValue(type, value);
+        Agros2D::problem()->setting()->setValue(type, value);
+        currentPythonEngineAgros()->postHermes()->invalidate();
     }
 
     void checkExistingSolution();
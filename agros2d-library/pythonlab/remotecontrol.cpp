@@ -17,17 +17,341 @@
 // University of Nevada, Reno (UNR) and University of West Bohemia, Pilsen
 // Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
 
+
 #include "remotecontrol.h"
 
 #include "pythonengine_agros.h"
 
 const QString OK_STRING = "\nOK\n";
 
-ScriptEngineRemote::ScriptEngineRemote() : m_tcpSocket(NULL)
+// number of jobs executed before control returns to the event loop
+const int JOBS_PER_EVENT = 1;
+
+QByteArray RemoteProtocol::handshake()
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << MAGIC << VERSION;
+
+    return data;
+}
+
+QByteArray RemoteProtocol::encode(const Message &message)
+{
+    QByteArray data;
+    data.reserve(4 + HEADER_SIZE - 4 + message.payload.size());
+
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << (quint32) (HEADER_SIZE - 4 + message.payload.size()) << message.type << message.id;
+    data.append(message.payload);
+
+    return data;
+}
+
+bool RemoteProtocol::decode(QByteArray &buffer, Message &message, bool *error)
+{
+    if (error)
+        *error = false;
+
+    if (buffer.size() < HEADER_SIZE)
+        return false;
+
+    QDataStream stream(buffer);
+    quint32 length;
+    stream >> length;
+
+    if (length < HEADER_SIZE - 4 || length > MAX_FRAME_SIZE)
+    {
+        if (error)
+            *error = true;
+        return false;
+    }
+
+    // incomplete frame
+    if ((quint32) buffer.size() < 4 + length)
+        return false;
+
+    stream >> message.type >> message.id;
+    message.payload = buffer.mid(HEADER_SIZE, length - (HEADER_SIZE - 4));
+    buffer.remove(0, 4 + length);
+
+    return true;
+}
+
+QByteArray RemoteProtocol::encodeArray(const QVector<double> &values)
+{
+    QByteArray data;
+    data.reserve(4 + values.size() * sizeof(double));
+
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    stream << (quint32) values.size();
+    foreach (double value, values)
+        stream << value;
+
+    return data;
+}
+
+QVector<double> RemoteProtocol::decodeArray(const QByteArray &payload)
+{
+    QDataStream stream(payload);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    quint32 count;
+    stream >> count;
+
+    QVector<double> values;
+    if (payload.size() < 4 + (qint64) count * (qint64) sizeof(double))
+        return values;
+
+    values.resize(count);
+    for (quint32 i = 0; i < count; i++)
+        stream >> values[i];
+
+    return values;
+}
+
+// *******************************************************************************************************
+
+RemoteSession::RemoteSession(RemoteServer *server, QTcpSocket *socket, quint32 id)
+    : QObject(server), m_server(server), m_socket(socket), m_id(id), m_handshake(false), m_legacy(false)
+{
+    m_socket->setParent(this);
+    m_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+    connect(m_socket, SIGNAL(readyRead()), this, SLOT(readData()));
+    connect(m_socket, SIGNAL(disconnected()), this, SLOT(disconnected()));
+}
+
+void RemoteSession::readData()
+{
+    m_buffer.append(m_socket->readAll());
+
+    if (!m_handshake && !m_legacy)
+    {
+        QByteArray magic = RemoteProtocol::handshake().left(4);
+
+        // old clients send the script directly
+        if (!magic.startsWith(m_buffer.left(4)))
+        {
+            m_legacy = true;
+
+            RemoteJob job;
+            job.session = m_id;
+            job.type = RemoteProtocol::Request_Script;
+            job.script = QString(m_buffer);
+            m_buffer.clear();
+
+            Hermes::Mixins::Loggable::Static::info(tr("Command: %1").arg(job.script).toLatin1());
+            m_server->enqueue(job);
+            return;
+        }
+
+        if (m_buffer.size() < RemoteProtocol::HANDSHAKE_SIZE)
+            return;
+
+        QDataStream stream(m_buffer);
+        quint32 magicValue, version;
+        stream >> magicValue >> version;
+        m_buffer.remove(0, RemoteProtocol::HANDSHAKE_SIZE);
+
+        if (version != RemoteProtocol::VERSION)
+        {
+            Hermes::Mixins::Loggable::Static::error(tr("Unsupported protocol version %1.").arg(version).toLatin1());
+            m_socket->close();
+            return;
+        }
+
+        m_handshake = true;
+        m_socket->write(RemoteProtocol::handshake());
+    }
+
+    if (m_legacy)
+        return;
+
+    // pipelined requests
+    RemoteProtocol::Message message;
+    bool error = false;
+    while (RemoteProtocol::decode(m_buffer, message, &error))
+        processMessage(message);
+
+    if (error)
+    {
+        Hermes::Mixins::Loggable::Static::error(tr("Invalid frame, closing session %1.").arg(m_id).toLatin1());
+        m_socket->close();
+    }
+}
+
+void RemoteSession::processMessage(const RemoteProtocol::Message &message)
+{
+    switch (message.type)
+    {
+    case RemoteProtocol::Request_Ping:
+    {
+        send(RemoteProtocol::Message(RemoteProtocol::Response_Ok, message.id));
+    }
+        break;
+    case RemoteProtocol::Request_Status:
+    {
+        QByteArray payload;
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream << (quint32) m_server->queuedJobs() << (quint32) m_server->m_running;
+
+        send(RemoteProtocol::Message(RemoteProtocol::Response_Status, message.id, payload));
+    }
+        break;
+    case RemoteProtocol::Request_Script:
+    case RemoteProtocol::Request_Array:
+    {
+        RemoteJob job;
+        job.session = m_id;
+        job.id = message.id;
+        job.type = message.type;
+
+        if (message.type == RemoteProtocol::Request_Script)
+        {
+            job.script = QString::fromUtf8(message.payload);
+        }
+        else
+        {
+            QDataStream stream(message.payload);
+            stream >> job.script >> job.variable;
+        }
+
+        m_server->enqueue(job);
+    }
+        break;
+    default:
+        send(RemoteProtocol::Message(RemoteProtocol::Response_Error, message.id,
+                                     tr("Unknown request type %1.").arg(message.type).toUtf8()));
+    }
+}
+
+void RemoteSession::send(const RemoteProtocol::Message &message)
+{
+    if (m_legacy)
+    {
+        // legacy protocol - text output and close
+        QString out = QString::fromUtf8(message.payload).trimmed();
+        m_socket->write((out.isEmpty() ? OK_STRING : out + OK_STRING).toLatin1());
+        m_socket->close();
+        return;
+    }
+
+    m_socket->write(RemoteProtocol::encode(message));
+}
+
+void RemoteSession::disconnected()
+{
+    emit closed(m_id);
+}
+
+// *******************************************************************************************************
+
+RemoteServer::RemoteServer(QObject *parent) : QTcpServer(parent), m_lastSessionId(0), m_lastServedSession(0), m_running(0)
+{
+    connect(this, SIGNAL(newConnection()), this, SLOT(connected()));
+}
+
+bool RemoteServer::start()
+{
+    return listen();
+}
+
+void RemoteServer::connected()
+{
+    while (hasPendingConnections())
+    {
+        RemoteSession *session = new RemoteSession(this, nextPendingConnection(), ++m_lastSessionId);
+        connect(session, SIGNAL(closed(quint32)), this, SLOT(sessionClosed(quint32)));
+
+        m_sessions[session->id()] = session;
+    }
+}
+
+void RemoteServer::sessionClosed(quint32 session)
+{
+    if (!m_sessions.contains(session))
+        return;
+
+    // drop pending jobs of the session
+    {
+        QMutexLocker locker(&m_queueMutex);
+        m_queues.remove(session);
+    }
+
+    m_sessions.take(session)->deleteLater();
+}
+
+void RemoteServer::sendResponse(quint32 session, const RemoteProtocol::Message &message)
+{
+    // client could be already disconnected
+    if (m_sessions.contains(session))
+        m_sessions[session]->send(message);
+}
+
+void RemoteServer::enqueue(const RemoteJob &job)
+{
+    {
+        QMutexLocker locker(&m_queueMutex);
+        m_queues[job.session].enqueue(job);
+    }
+
+    emit jobQueued();
+}
+
+bool RemoteServer::takeJob(RemoteJob &job)
+{
+    QMutexLocker locker(&m_queueMutex);
+
+    if (m_queues.isEmpty())
+        return false;
+
+    // next session after the last served one
+    QMap<quint32, QQueue<RemoteJob> >::iterator it = m_queues.upperBound(m_lastServedSession);
+    if (it == m_queues.end())
+        it = m_queues.begin();
+
+    job = it.value().dequeue();
+    m_lastServedSession = it.key();
+
+    if (it.value().isEmpty())
+        m_queues.erase(it);
+
+    return true;
+}
+
+int RemoteServer::queuedJobs()
+{
+    QMutexLocker locker(&m_queueMutex);
+
+    int count = 0;
+    foreach (QQueue<RemoteJob> queue, m_queues)
+        count += queue.count();
+
+    return count;
+}
+
+// *******************************************************************************************************
+
+ScriptEngineRemote::ScriptEngineRemote() : QObject(), m_isRunning(false)
 {  
-    if (!listen())
+    qRegisterMetaType<RemoteProtocol::Message>("RemoteProtocol::Message");
+
+    m_networkThread = new QThread(this);
+    m_server = new RemoteServer();
+    m_server->moveToThread(m_networkThread);
+    connect(m_networkThread, SIGNAL(finished()), m_server, SLOT(deleteLater()));
+    m_networkThread->start();
+
+    bool listening = false;
+    QMetaObject::invokeMethod(m_server, "start", Qt::BlockingQueuedConnection, Q_RETURN_ARG(bool, listening));
+    if (!listening)
     {
-        Hermes::Mixins::Loggable::Static::error(tr("Error: Unable to start the server (agros2d-server): %1.").arg(errorString()).toLatin1());
+        Hermes::Mixins::Loggable::Static::error(tr("Error: Unable to start the server (agros2d-server): %1.").arg(m_server->errorString()).toLatin1());
         return;
     }
 
@@ -44,91 +368,101 @@ ScriptEngineRemote::ScriptEngineRemote() : m_tcpSocket(NULL)
     // if we did not find one, use IPv4 localhost
     if (ipAddress.isEmpty())
         ipAddress = QHostAddress(QHostAddress::LocalHost).toString();
-    Hermes::Mixins::Loggable::Static::warn(tr("The server '%1' is running on IP: %2, port: %3").arg(serverName()).arg(ipAddress).arg(serverPort()).toLatin1());
+    Hermes::Mixins::Loggable::Static::warn(tr("The server '%1' is running on IP: %2, port: %3").arg(serverName()).arg(ipAddress).arg(m_server->serverPort()).toLatin1());
 
-    connect(this, SIGNAL(newConnection()), this, SLOT(connected()));
+    // network thread -> job queue -> GUI thread
+    connect(m_server, SIGNAL(jobQueued()), this, SLOT(runJobs()), Qt::QueuedConnection);
+    connect(this, SIGNAL(response(quint32, RemoteProtocol::Message)), m_server, SLOT(sendResponse(quint32, RemoteProtocol::Message)), Qt::QueuedConnection);
+    connect(this, SIGNAL(runningJobs(int)), m_server, SLOT(setRunningJobs(int)), Qt::QueuedConnection);
+
+    connect(currentPythonEngineAgros(), SIGNAL(pythonShowMessage(QString)), this, SLOT(stdOut(QString)));
+    connect(currentPythonEngineAgros(), SIGNAL(pythonShowHtml(QString)), this, SLOT(stdHtml(QString)));
 }
 
 ScriptEngineRemote::~ScriptEngineRemote()
 {
+    m_networkThread->quit();
+    m_networkThread->wait();
 }
 
-void ScriptEngineRemote::connected()
+void ScriptEngineRemote::runJobs()
 {
-    if (m_tcpSocket)
-    {
-        Hermes::Mixins::Loggable::Static::error(tr("Server is busy.").toLatin1());
+    // script can process events
+    if (m_isRunning)
         return;
-    }
 
-    // qDebug() << tr("Client connected");
+    m_isRunning = true;
+    emit runningJobs(1);
 
-    m_tcpSocket = nextPendingConnection();
-    connect(m_tcpSocket, SIGNAL(readyRead()), this, SLOT(readCommand()));
-    connect(m_tcpSocket, SIGNAL(disconnected()), this, SLOT(disconnected()));
+    RemoteJob job;
+    int executed = 0;
+    while (executed < JOBS_PER_EVENT && m_server->takeJob(job))
+    {
+        emit response(job.session, runJob(job));
+        executed++;
+    }
 
-    connect(currentPythonEngineAgros(), SIGNAL(pythonShowMessage(QString)), this, SLOT(stdOut(QString)));
-    connect(currentPythonEngineAgros(), SIGNAL(pythonShowHtml(QString)), this, SLOT(stdHtml(QString)));
+    emit runningJobs(0);
+    m_isRunning = false;
+
+    // keep GUI responsive between jobs
+    if (m_server->queuedJobs() > 0)
+        QTimer::singleShot(0, this, SLOT(runJobs()));
 }
 
-void ScriptEngineRemote::readCommand()
+RemoteProtocol::Message ScriptEngineRemote::runJob(const RemoteJob &job)
 {
-    if (m_tcpSocket->bytesAvailable() > 0)
+    m_stdout.clear();
+
+    bool successful = job.script.trimmed().isEmpty() || currentPythonEngineAgros()->runScript(job.script);
+    if (!successful)
+    {
+        ErrorResult result = currentPythonEngineAgros()->parseError();
+        Hermes::Mixins::Loggable::Static::error(tr("Error: %1").arg(result.error().trimmed()).toLatin1());
+
+        return RemoteProtocol::Message(RemoteProtocol::Response_Error, job.id, result.error().trimmed().toUtf8());
+    }
+
+    if (job.type == RemoteProtocol::Request_Array)
     {
-        m_command = QString(m_tcpSocket->readAll());
-        Hermes::Mixins::Loggable::Static::info(tr("Command: %1").arg(m_command).toLatin1());
+        // binary result
+        PyObject *result = PyDict_GetItemString(currentPythonEngine()->dict(), job.variable.toLatin1().data());
+        if (!result)
+            return RemoteProtocol::Message(RemoteProtocol::Response_Error, job.id, tr("Variable '%1' not found.").arg(job.variable).toUtf8());
 
-        bool successful = currentPythonEngineAgros()->runScript(m_command);
+        QVector<double> values;
 
-        if (successful)
+        Py_INCREF(result);
+        if (PySequence_Check(result))
         {
-            if (!m_stdout.trimmed().isEmpty())
-            {
-                Hermes::Mixins::Loggable::Static::warn(tr("Stdout: %1").arg(m_stdout.trimmed()).toLatin1());
-                m_tcpSocket->write((m_stdout.trimmed() + OK_STRING).toLatin1());
-            }
-            else
-            {
-                m_tcpSocket->write(OK_STRING.toLatin1());
-            }
+            PyObject *sequence = PySequence_Fast(result, "");
+            int count = PySequence_Fast_GET_SIZE(sequence);
+
+            values.reserve(count);
+            for (int i = 0; i < count; i++)
+                values.append(PyFloat_AsDouble(PySequence_Fast_GET_ITEM(sequence, i)));
+
+            Py_XDECREF(sequence);
         }
         else
         {
-            ErrorResult result = currentPythonEngineAgros()->parseError();
-            Hermes::Mixins::Loggable::Static::error(tr("Error: %1").arg(result.error().trimmed()).toLatin1());
-            m_tcpSocket->write((result.error().trimmed() + OK_STRING).toLatin1());
+            values.append(PyFloat_AsDouble(result));
         }
-    }
-    else
-    {
-        m_tcpSocket->write(OK_STRING.toLatin1());
-    }
-    m_tcpSocket->close();
-}
+        Py_XDECREF(result);
 
-void ScriptEngineRemote::disconnected()
-{
-    m_tcpSocket = NULL;
-    m_stdout = "";
+        if (PyErr_Occurred())
+        {
+            PyErr_Clear();
+            return RemoteProtocol::Message(RemoteProtocol::Response_Error, job.id, tr("Variable '%1' is not a number or a sequence of numbers.").arg(job.variable).toUtf8());
+        }
 
-    disconnect(currentPythonEngineAgros(), SIGNAL(pythonShowMessage(QString)), this, SLOT(stdOut(QString)));
-    disconnect(currentPythonEngineAgros(), SIGNAL(pythonShowHtml(QString)), this, SLOT(stdHtml(QString)));
+        return RemoteProtocol::Message(RemoteProtocol::Response_Array, job.id, RemoteProtocol::encodeArray(values));
+    }
 
-    // qDebug() << tr("Client disconnected");
-}
+    if (!m_stdout.trimmed().isEmpty())
+        Hermes::Mixins::Loggable::Static::warn(tr("Stdout: %1").arg(m_stdout.trimmed()).toLatin1());
 
-void ScriptEngineRemote::displayError(QLocalSocket::LocalSocketError socketError)
-{
-    switch (socketError) {
-    case QLocalSocket::ServerNotFoundError:
-        Hermes::Mixins::Loggable::Static::error(tr("Server error: The host was not found.").toLatin1());
-        break;
-    case QLocalSocket::ConnectionRefusedError:
-        Hermes::Mixins::Loggable::Static::error(tr("Server error: The connection was refused by the peer. Make sure the agros2d-client server is running.").toLatin1());
-        break;
-    default:
-        Hermes::Mixins::Loggable::Static::error(tr("Server error: The following error occurred: %1.").arg(m_tcpSocket->errorString()).toLatin1());
-    }
+    return RemoteProtocol::Message(RemoteProtocol::Response_Ok, job.id, m_stdout.trimmed().toUtf8());
 }
 
 QString ScriptEngineRemote::serverName()
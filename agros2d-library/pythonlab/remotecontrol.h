@@ -17,34 +17,169 @@
 // University of Nevada, Reno (UNR) and University of West Bohemia, Pilsen
 // Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
 
+
 #ifndef REMOTECONTROL_H
 #define REMOTECONTROL_H
 
 #include "../util/util.h"
 
-class AGROS_LIBRARY_API ScriptEngineRemote : public QTcpServer
+// framed remote protocol
+// handshake: client and server exchange MAGIC and VERSION (quint32, big endian)
+// frame: quint32 length, quint8 type, quint32 request id, payload (length = 5 + payload size)
+// clients sending anything else than MAGIC are served by the legacy protocol (one script per connection)
+namespace RemoteProtocol
+{
+    // "A2DP"
+    const quint32 MAGIC = 0x41324450;
+    const quint32 VERSION = 1;
+    const int HANDSHAKE_SIZE = 8;
+    const int HEADER_SIZE = 9;
+    const quint32 MAX_FRAME_SIZE = 256 * 1024 * 1024;
+
+    enum MessageType
+    {
+        // requests
+        Request_Ping = 1,
+        Request_Script = 2,  // payload: UTF-8 script
+        Request_Array = 3,   // payload: QDataStream(script, variable)
+        Request_Status = 4,  // queued jobs (answered without waiting for the queue)
+        // responses
+        Response_Ok = 64,    // payload: UTF-8 stdout
+        Response_Error = 65, // payload: UTF-8 error
+        Response_Array = 66, // payload: quint32 count, count * double (little endian)
+        Response_Status = 67 // payload: QDataStream(quint32 queued, quint32 running)
+    };
+
+    struct Message
+    {
+        Message() : type(0), id(0) {}
+        Message(quint8 type, quint32 id, const QByteArray &payload = QByteArray()) : type(type), id(id), payload(payload) {}
+
+        quint8 type;
+        quint32 id;
+        QByteArray payload;
+    };
+
+    AGROS_LIBRARY_API QByteArray handshake();
+    AGROS_LIBRARY_API QByteArray encode(const Message &message);
+    // extracts one complete frame from the beginning of buffer, returns false if incomplete
+    AGROS_LIBRARY_API bool decode(QByteArray &buffer, Message &message, bool *error = NULL);
+
+    AGROS_LIBRARY_API QByteArray encodeArray(const QVector<double> &values);
+    AGROS_LIBRARY_API QVector<double> decodeArray(const QByteArray &payload);
+}
+
+// job executed by the Python engine
+struct RemoteJob
+{
+    RemoteJob() : session(0), id(0), type(0) {}
+
+    // server side session and request
+    quint32 session;
+    quint32 id;
+    quint8 type;
+    QString script;
+    QString variable;
+};
+
+class RemoteSession;
+
+// network part of the server, lives in its own thread
+// sessions are persistent and pipelined, scripts go to the job queue of ScriptEngineRemote
+class RemoteServer : public QTcpServer
 {
     Q_OBJECT
 public:
-    ScriptEngineRemote();
-    ~ScriptEngineRemote();
+    RemoteServer(QObject *parent = 0);
+
+    // called from the GUI thread
+    bool takeJob(RemoteJob &job);
+    int queuedJobs();
+
+signals:
+    void jobQueued();
+
+public slots:
+    bool start();
+    void sendResponse(quint32 session, const RemoteProtocol::Message &message);
+    void setRunningJobs(int running) { m_running = running; }
 
 private slots:
     void connected();
-    void readCommand();
+    void sessionClosed(quint32 session);
+
+private:
+    QMap<quint32, RemoteSession *> m_sessions;
+    quint32 m_lastSessionId;
+
+    // job queue per session, sessions are served round robin
+    QMutex m_queueMutex;
+    QMap<quint32, QQueue<RemoteJob> > m_queues;
+    quint32 m_lastServedSession;
+    int m_running;
+
+    void enqueue(const RemoteJob &job);
+
+    friend class RemoteSession;
+};
+
+class RemoteSession : public QObject
+{
+    Q_OBJECT
+public:
+    RemoteSession(RemoteServer *server, QTcpSocket *socket, quint32 id);
+
+    inline quint32 id() const { return m_id; }
+    void send(const RemoteProtocol::Message &message);
+
+signals:
+    void closed(quint32 session);
+
+private slots:
+    void readData();
     void disconnected();
 
-    void displayError(QLocalSocket::LocalSocketError socketError);
+private:
+    RemoteServer *m_server;
+    QTcpSocket *m_socket;
+    quint32 m_id;
+
+    QByteArray m_buffer;
+    bool m_handshake;
+    bool m_legacy;
+
+    void processMessage(const RemoteProtocol::Message &message);
+};
+
+// executes queued jobs in the GUI thread (Python engine is not thread safe)
+class AGROS_LIBRARY_API ScriptEngineRemote : public QObject
+{
+    Q_OBJECT
+public:
+    ScriptEngineRemote();
+    ~ScriptEngineRemote();
+
+signals:
+    void response(quint32 session, const RemoteProtocol::Message &message);
+    void runningJobs(int running);
+
+private slots:
+    void runJobs();
 
     void stdOut(const QString &str);
     void stdHtml(const QString &str);
 
 private:
-    QString m_command;
-    QTcpSocket *m_tcpSocket;
+    QThread *m_networkThread;
+    RemoteServer *m_server;
+
     QString m_stdout;
+    bool m_isRunning;
 
+    RemoteProtocol::Message runJob(const RemoteJob &job);
     QString serverName();
 };
 
+Q_DECLARE_METATYPE(RemoteProtocol::Message)
+
 #endif // REMOTECONTROL_H
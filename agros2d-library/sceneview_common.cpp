@@ -25,6 +25,8 @@
 
 #include "sceneview_common.h"
 
+#include <QGLFramebufferObject>
+
 #include "util/global.h"
 #include "logview.h"
 
@@ -50,6 +52,8 @@
 #endif
 
 static const int TEXTURE_SIZE = 512;
+// maximum number of cached text layouts (per font)
+static const int TEXT_RUNS_CACHE_SIZE = 4096;
 
 SceneViewCommon::SceneViewCommon(QWidget *parent)
     : QGLWidget(parent),
@@ -159,28 +163,176 @@ void SceneViewCommon::setupViewport(int w, int h)
 
 void SceneViewCommon::printRulersAt(int penX, int penY, const QString &text)
 {
-    glColor3d(COLORCROSS[0] * 2.0/3.0, COLORCROSS[1] * 2.0/3.0, COLORCROSS[2] * 2.0/3.0);
-    glBindTexture(GL_TEXTURE_2D, m_textureLabelRulers);
-    printAt(penX, penY, text, m_charDataRulers);
+    printAt(penX, penY, text, m_charDataRulers, m_textRulers);
 }
 
 void SceneViewCommon::printPostAt(int penX, int penY, const QString &text)
 {
-    glColor3d(0.0, 0.0, 0.0);
+    printAt(penX, penY, text, m_charDataPost, m_textPost);
+}
+
+void SceneViewCommon::flushText()
+{
+    if (m_textRulers.positions.isEmpty() && m_textPost.positions.isEmpty())
+        return;
+
+    // text is placed in window coordinates
+    loadProjectionViewPort();
+
+    glScaled(2.0 / width(), 2.0 / height(), 1.0);
+    glTranslated(- width() / 2.0, -height() / 2.0, 0.0);
+
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glDisable(GL_DEPTH_TEST);
+
+    glEnable(GL_TEXTURE_2D);
+    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    if (!m_textRulers.positions.isEmpty())
+    {
+        glColor3d(COLORCROSS[0] * 2.0/3.0, COLORCROSS[1] * 2.0/3.0, COLORCROSS[2] * 2.0/3.0);
+        glBindTexture(GL_TEXTURE_2D, m_textureLabelRulers);
+
+        glVertexPointer(2, GL_FLOAT, 0, m_textRulers.positions.constData());
+        glTexCoordPointer(2, GL_FLOAT, 0, m_textRulers.texCoords.constData());
+        glDrawArrays(GL_TRIANGLES, 0, m_textRulers.positions.count());
+
+        // capacity is kept for the next frame
+        m_textRulers.positions.resize(0);
+        m_textRulers.texCoords.resize(0);
+    }
+
+    if (!m_textPost.positions.isEmpty())
+    {
+        glColor3d(0.0, 0.0, 0.0);
+        glBindTexture(GL_TEXTURE_2D, m_textureLabelPost);
 
-    glBindTexture(GL_TEXTURE_2D, m_textureLabelPost);
-    printAt(penX, penY, text, m_charDataPost);
+        glVertexPointer(2, GL_FLOAT, 0, m_textPost.positions.constData());
+        glTexCoordPointer(2, GL_FLOAT, 0, m_textPost.texCoords.constData());
+        glDrawArrays(GL_TRIANGLES, 0, m_textPost.positions.count());
+
+        m_textPost.positions.resize(0);
+        m_textPost.texCoords.resize(0);
+    }
+
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    glDisable(GL_BLEND);
+    glDisable(GL_TEXTURE_2D);
+
+    if (depthTest)
+        glEnable(GL_DEPTH_TEST);
 }
 
 QPixmap SceneViewCommon::renderScenePixmap(int w, int h, bool useContext)
 {
-    return QPixmap::fromImage(grabFrameBuffer(false));
+    return QPixmap::fromImage(renderSceneImage(w, h));
+}
+
+QImage SceneViewCommon::renderSceneImage(int w, int h)
+{
+    if (w == 0) w = width();
+    if (h == 0) h = height();
+
+    makeCurrent();
+
+    // framebuffer objects are not supported
+    if (!QGLFramebufferObject::hasOpenGLFramebufferObjects())
+    {
+        Agros2D::log()->printWarning(tr("Image"), tr("Framebuffer objects are not supported, image of the window is used."));
+        return grabFrameBuffer(false);
+    }
+
+    // maximum size of the tile
+    GLint maxViewportDims[2];
+    glGetIntegerv(GL_MAX_VIEWPORT_DIMS, maxViewportDims);
+    GLint maxTextureSize;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+
+    int tileWidth = qMin(w, qMin((int) maxViewportDims[0], (int) maxTextureSize));
+    int tileHeight = qMin(h, qMin((int) maxViewportDims[1], (int) maxTextureSize));
+
+    QGLFramebufferObjectFormat format;
+    format.setAttachment(QGLFramebufferObject::CombinedDepthStencil);
+    QGLFramebufferObject fbo(tileWidth, tileHeight, format);
+    if (!fbo.isValid())
+    {
+        Agros2D::log()->printWarning(tr("Image"), tr("Framebuffer object (%1 x %2) cannot be created, image of the window is used.").arg(tileWidth).arg(tileHeight));
+        return grabFrameBuffer(false);
+    }
+
+    // scene is laid out for the requested size (aspect ratio, rulers and labels)
+    QSize widgetSize = size();
+    QSize widgetMinimumSize = minimumSize();
+    bool widgetUpdatesEnabled = updatesEnabled();
+
+    setUpdatesEnabled(false);
+    setMinimumSize(0, 0);
+    resize(w, h);
+
+    QImage image(w, h, QImage::Format_RGB32);
+    image.fill(Qt::white);
+
+    QPainter painter(&image);
+    for (int y = 0; y < h; y += tileHeight)
+    {
+        for (int x = 0; x < w; x += tileWidth)
+        {
+            m_renderTile = QRect(x, y, qMin(tileWidth, w - x), qMin(tileHeight, h - y));
+
+            fbo.bind();
+            resizeGL(m_renderTile.width(), m_renderTile.height());
+            paintGL();
+            glFinish();
+            fbo.release();
+
+            // window coordinates have origin in the bottom left corner
+            painter.drawImage(QPoint(x, h - y - m_renderTile.height()), fbo.toImage(),
+                              QRect(0, tileHeight - m_renderTile.height(), m_renderTile.width(), m_renderTile.height()));
+        }
+    }
+    painter.end();
+
+    m_renderTile = QRect();
+
+    resize(widgetSize);
+    setMinimumSize(widgetMinimumSize);
+    setUpdatesEnabled(widgetUpdatesEnabled);
+
+    makeCurrent();
+    resizeGL(width(), height());
+
+    return image;
+}
+
+void SceneViewCommon::loadTileProjection()
+{
+    glLoadIdentity();
+
+    if (m_renderTile.isNull())
+        return;
+
+    // tile in normalized device coordinates is stretched to the whole viewport
+    double x0 = 2.0 * m_renderTile.left() / width() - 1.0;
+    double x1 = 2.0 * (m_renderTile.left() + m_renderTile.width()) / width() - 1.0;
+    double y0 = 2.0 * m_renderTile.top() / height() - 1.0;
+    double y1 = 2.0 * (m_renderTile.top() + m_renderTile.height()) / height() - 1.0;
+
+    glScaled(2.0 / (x1 - x0), 2.0 / (y1 - y0), 1.0);
+    glTranslated(- (x0 + x1) / 2.0, - (y0 + y1) / 2.0, 0.0);
 }
 
 void SceneViewCommon::loadProjectionViewPort()
 {
     glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
+    loadTileProjection();
 
     glOrtho(-1.0, 1.0, -1.0, 1.0, -1.0, 1.0);
 
@@ -194,60 +346,53 @@ void getBakedQuad(stbtt_bakedchar *chardata, int pw, int ph, int char_index,
 
 }
 
-void SceneViewCommon::printAt(int penX, int penY, const QString &text, stbtt_bakedchar *fnt)
-{   
-    glEnable(GL_TEXTURE_2D);
-    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    double xpos = 0.0;
-
-    glBegin(GL_TRIANGLES);
-    for (int i = 0; i < text.length(); ++i)
+void SceneViewCommon::printAt(int penX, int penY, const QString &text, stbtt_bakedchar *fnt, TextBatch &batch)
+{
+    // layout relative to the pen is cached (tick labels and markers repeat between frames)
+    QHash<QString, TextRun>::const_iterator it = batch.runs.constFind(text);
+    if (it == batch.runs.constEnd())
     {
-        ushort c = text.at(i).unicode();
+        if (batch.runs.count() > TEXT_RUNS_CACHE_SIZE)
+            batch.runs.clear();
 
-        if (c >= 32 && c < 128)
+        TextRun run;
+
+        double xpos = 0.0;
+        for (int i = 0; i < text.length(); ++i)
         {
-            stbtt_aligned_quad q;
-
-            stbtt_bakedchar *b = fnt + c - 32;
-
-            int round_x = std::floor(penX + b->xoff);
-            int round_y = std::floor(penY - b->yoff);
-
-            q.x0 = (float) round_x + xpos;
-            q.y0 = (float) round_y;
-            q.x1 = (float) round_x + b->x1 - b->x0 + xpos;
-            q.y1 = (float) round_y - b->y1 + b->y0;
-
-            q.s0 = b->x0 / (float) TEXTURE_SIZE;
-            q.t0 = b->y0 / (float) TEXTURE_SIZE;
-            q.s1 = b->x1 / (float) TEXTURE_SIZE;
-            q.t1 = b->y1 / (float) TEXTURE_SIZE;
-
-            xpos += b->xadvance;
-
-            glTexCoord2f(q.s0, q.t0);
-            glVertex2i(q.x0, q.y0);
-            glTexCoord2f(q.s1, q.t1);
-            glVertex2i(q.x1, q.y1);
-            glTexCoord2f(q.s1, q.t0);
-            glVertex2i(q.x1, q.y0);
-
-            glTexCoord2f(q.s0, q.t0);
-            glVertex2i(q.x0, q.y0);
-            glTexCoord2f(q.s0, q.t1);
-            glVertex2i(q.x0, q.y1);
-            glTexCoord2f(q.s1, q.t1);
-            glVertex2i(q.x1, q.y1);
+            ushort c = text.at(i).unicode();
+
+            if (c >= 32 && c < 128)
+            {
+                stbtt_bakedchar *b = fnt + c - 32;
+
+                float x0 = std::floor(b->xoff) + xpos;
+                float y0 = std::floor(- b->yoff);
+                float x1 = x0 + b->x1 - b->x0;
+                float y1 = y0 - b->y1 + b->y0;
+
+                float s0 = b->x0 / (float) TEXTURE_SIZE;
+                float t0 = b->y0 / (float) TEXTURE_SIZE;
+                float s1 = b->x1 / (float) TEXTURE_SIZE;
+                float t1 = b->y1 / (float) TEXTURE_SIZE;
+
+                xpos += b->xadvance;
+
+                run.positions << QVector2D(x0, y0) << QVector2D(x1, y1) << QVector2D(x1, y0)
+                              << QVector2D(x0, y0) << QVector2D(x0, y1) << QVector2D(x1, y1);
+                run.texCoords << QVector2D(s0, t0) << QVector2D(s1, t1) << QVector2D(s1, t0)
+                              << QVector2D(s0, t0) << QVector2D(s0, t1) << QVector2D(s1, t1);
+            }
         }
+
+        it = batch.runs.insert(text, run);
     }
-    glEnd();
 
-    glDisable(GL_BLEND);
-    glDisable(GL_TEXTURE_2D);
+    // glyphs are aligned to pixels
+    const TextRun &run = it.value();
+    for (int i = 0; i < run.positions.count(); i++)
+        batch.positions.append(QVector2D((int) (penX + run.positions[i].x()), (int) (penY + run.positions[i].y())));
+    batch.texCoords += run.texCoords;
 }
 
 void SceneViewCommon::initFont(GLuint &textureID, stbtt_bakedchar *fnt, const QString fontName, int pointSize)
@@ -272,6 +417,12 @@ void SceneViewCommon::initFont(GLuint &textureID, stbtt_bakedchar *fnt, const QS
 
     stbtt_BakeFontBitmap(ttfBuffer, 0, pointSize, bmap, TEXTURE_SIZE, TEXTURE_SIZE, 32, 96, fnt);
 
+    // cached layouts belong to the previous font
+    if (fnt == m_charDataRulers)
+        m_textRulers.runs.clear();
+    if (fnt == m_charDataPost)
+        m_textPost.runs.clear();
+
     // can free ttf_buffer at this point
     glBindTexture(GL_TEXTURE_2D, textureID);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, TEXTURE_SIZE, TEXTURE_SIZE, 0, GL_ALPHA, GL_UNSIGNED_BYTE, bmap);
@@ -391,7 +542,7 @@ void SceneViewCommon::drawBlend(Point start, Point end, double red, double green
 
 void SceneViewCommon::saveImageToFile(const QString &fileName, int w, int h)
 {
-    QPixmap pixmap = renderScenePixmap(w, h);
-    if (!pixmap.save(fileName, "PNG"))
+    QImage image = renderSceneImage(w, h);
+    if (!image.save(fileName, "PNG"))
         Agros2D::log()->printError(tr("Problem"), tr("Image cannot be saved to the file '%1'.").arg(fileName));
 }
@@ -64,6 +64,8 @@ public:
 
     void saveImageToFile(const QString &fileName, int w = 0, int h = 0);
     QPixmap renderScenePixmap(int w = 0, int h = 0, bool useContext = false);
+    // offscreen rendering (framebuffer object), large images are rendered in tiles
+    QImage renderSceneImage(int w = 0, int h = 0);
 
     virtual QIcon iconView() { return QIcon(); }
     virtual QString labelView() { return ""; }
@@ -96,7 +98,24 @@ protected:
     void drawArc(const Point &point, double r, double startAngle, double arcAngle, int segments = -1) const;
     void drawBlend(Point start, Point end, double red = 1.0, double green = 1.0, double blue = 1.0, double alpha = 0.75) const;
 
-    void printAt(int penX, int penY, const QString &text, stbtt_bakedchar *fnt);
+    // text - strings are laid out once and queued, flushText() draws them by one call per atlas
+    struct TextRun
+    {
+        QVector<QVector2D> positions;
+        QVector<QVector2D> texCoords;
+    };
+
+    struct TextBatch
+    {
+        QHash<QString, TextRun> runs;
+        QVector<QVector2D> positions;
+        QVector<QVector2D> texCoords;
+    };
+
+    TextBatch m_textRulers;
+    TextBatch m_textPost;
+
+    void printAt(int penX, int penY, const QString &text, stbtt_bakedchar *fnt, TextBatch &batch);
     void initFont(GLuint &textureID, stbtt_bakedchar *fnt, const QString fontName, int pointSize);
     void createFontTexture();
 
@@ -111,6 +130,8 @@ protected:
 
     void printRulersAt(int penX, int penY, const QString &text);
     void printPostAt(int penX, int penY, const QString &text);
+    // draws queued text in window coordinates (end of paintGL)
+    void flushText();
 
     virtual void setZoom(double power) = 0;
 
@@ -119,11 +140,17 @@ protected:
     virtual void paintGL() = 0;    
     void setupViewport(int w, int h);
     void loadProjectionViewPort();
+    // replaces glLoadIdentity() of the projection matrix (part of the scene covered by the rendered tile)
+    void loadTileProjection();
 
     void closeEvent(QCloseEvent *event);
 
     inline double aspect() const { return (double) width() / (double) height(); }
 
+private:
+    // rendered tile in window coordinates, null if the whole scene is rendered
+    QRect m_renderTile;
+
 private slots:
     void doMaterialGroup(QAction *action);
     void doBoundaryGroup(QAction *action);
@@ -81,7 +81,7 @@ Point SceneViewCommon2D::untransform(const Point &point) const
 void SceneViewCommon2D::loadProjection2d(bool setScene)
 {
     glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
+    loadTileProjection();
 
     glOrtho(-1.0, 1.0, -1.0, 1.0, -1.0, 1.0);
 
@@ -111,7 +111,7 @@ void SceneViewCommon3D::paintBackground()
     glPushMatrix();
 
     glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
+    loadTileProjection();
 
     glOrtho(-1.0, 1.0, -1.0, 1.0, -10.0, 10.0);
 
@@ -235,7 +235,7 @@ void SceneViewCommon3D::paintAxes()
 void SceneViewCommon3D::loadProjection3d(bool setScene, bool plane)
 {
     glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
+    loadTileProjection();
     glOrtho(-0.5, 0.5, -0.5, 0.5, 4.0, 15.0);
 
     glMatrixMode(GL_MODELVIEW);
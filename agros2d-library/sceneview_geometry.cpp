@@ -44,10 +44,13 @@
 
 SceneViewPreprocessor::SceneViewPreprocessor(QWidget *parent)
     : SceneViewCommon2D(NULL, parent),
-      m_sceneMode(SceneGeometryMode_OperateOnNodes), m_snapToGrid(true), m_selectRegion(false), m_selectRegionPos(QPointF())
+      m_sceneMode(SceneGeometryMode_OperateOnNodes), m_snapToGrid(true), m_selectRegion(false), m_selectRegionPos(QPointF()),
+      m_geometryDirty(true)
 {
     createActionsGeometry();
     createMenuGeometry();
+
+    connect(Agros2D::scene(), SIGNAL(invalidated()), this, SLOT(invalidateGeometry()));
 }
 
 SceneViewPreprocessor::~SceneViewPreprocessor()
@@ -197,6 +200,8 @@ void SceneViewPreprocessor::clear()
     SceneViewCommon2D::clear();
 
     m_selectRegion = false;
+    m_edgeTessellation.clear();
+    invalidateGeometry();
 
     deleteTexture(m_backgroundTexture);
     m_backgroundTexture = -1;
@@ -294,7 +299,7 @@ void SceneViewPreprocessor::mouseMoveEvent(QMouseEvent *event)
         if (m_sceneMode == SceneGeometryMode_OperateOnNodes)
         {
             // highlight the closest node
-            SceneNode *node = SceneNode::findClosestNode(p);
+            SceneNode *node = closestNode(p);
             if (node)
             {
                 Agros2D::scene()->highlightNone();
@@ -309,7 +314,7 @@ void SceneViewPreprocessor::mouseMoveEvent(QMouseEvent *event)
         if (m_sceneMode == SceneGeometryMode_OperateOnEdges)
         {
             // highlight the closest edge
-            SceneEdge *edge = SceneEdge::findClosestEdge(p);
+            SceneEdge *edge = closestEdge(p);
             if (edge)
             {
                 // assigned boundary conditions
@@ -345,7 +350,7 @@ void SceneViewPreprocessor::mouseMoveEvent(QMouseEvent *event)
             // highlight the closest label
             Agros2D::scene()->highlightNone();
 
-            SceneLabel *label = SceneLabel::findClosestLabel(p);
+            SceneLabel *label = closestLabel(p);
             if (label)
             {
                 // assigned materials
@@ -385,7 +390,7 @@ void SceneViewPreprocessor::mouseMoveEvent(QMouseEvent *event)
         if (m_sceneMode == SceneGeometryMode_OperateOnEdges)
         {
             // add edge directly by mouse click
-            SceneNode *node = SceneNode::findClosestNode(p);
+            SceneNode *node = closestNode(p);
             if (node)
             {
                 Agros2D::scene()->highlightNone();
@@ -558,7 +563,7 @@ void SceneViewPreprocessor::mousePressEvent(QMouseEvent *event)
         if (m_sceneMode == SceneGeometryMode_OperateOnEdges)
         {
             // add edge directly by mouse click
-            SceneNode *node =SceneNode::findClosestNode(p);
+            SceneNode *node = closestNode(p);
             if (node)
             {
                 if (m_nodeLast == NULL)
@@ -616,7 +621,7 @@ void SceneViewPreprocessor::mousePressEvent(QMouseEvent *event)
         if (m_sceneMode == SceneGeometryMode_OperateOnNodes)
         {
             // select the closest node
-            SceneNode *node = SceneNode::findClosestNode(p);
+            SceneNode *node = closestNode(p);
             if (node)
             {
                 node->setSelected(!node->isSelected());
@@ -627,7 +632,7 @@ void SceneViewPreprocessor::mousePressEvent(QMouseEvent *event)
         if (m_sceneMode == SceneGeometryMode_OperateOnEdges)
         {
             // select the closest edge
-            SceneEdge *edge = SceneEdge::findClosestEdge(p);
+            SceneEdge *edge = closestEdge(p);
             if (edge)
             {
                 edge->setSelected(!edge->isSelected());
@@ -638,7 +643,7 @@ void SceneViewPreprocessor::mousePressEvent(QMouseEvent *event)
         if (m_sceneMode == SceneGeometryMode_OperateOnLabels)
         {
             // select the closest label
-            SceneLabel *label = SceneLabel::findClosestLabel(p);
+            SceneLabel *label = closestLabel(p);
             if (label)
             {
                 label->setSelected(!label->isSelected());
@@ -690,7 +695,7 @@ void SceneViewPreprocessor::mouseDoubleClickEvent(QMouseEvent *event)
             if (m_sceneMode == SceneGeometryMode_OperateOnNodes)
             {
                 // select the closest node
-                SceneNode *node =SceneNode::findClosestNode(p);
+                SceneNode *node = closestNode(p);
                 if (node)
                 {
                     node->setSelected(true);
@@ -704,7 +709,7 @@ void SceneViewPreprocessor::mouseDoubleClickEvent(QMouseEvent *event)
             if (m_sceneMode == SceneGeometryMode_OperateOnEdges)
             {
                 // select the closest label
-                SceneEdge *edge = SceneEdge::findClosestEdge(p);
+                SceneEdge *edge = closestEdge(p);
                 if (edge)
                 {
                     edge->setSelected(true);
@@ -718,7 +723,7 @@ void SceneViewPreprocessor::mouseDoubleClickEvent(QMouseEvent *event)
             if (m_sceneMode == SceneGeometryMode_OperateOnLabels)
             {
                 // select the closest label
-                SceneLabel *label = SceneLabel::findClosestLabel(p);
+                SceneLabel *label = closestLabel(p);
                 if (label)
                 {
                     label->setSelected(true);
@@ -950,29 +955,259 @@ void SceneViewPreprocessor::paintGL()
     paintZoomRegion();
     paintSnapToGrid();
     paintEdgeLine();
+
+    flushText();
+}
+
+void SceneViewPreprocessor::invalidateGeometry()
+{
+    m_geometryDirty = true;
+}
+
+void SceneViewPreprocessor::updateGeometryCache()
+{
+    if (!m_geometryDirty
+            && m_geometryNodes == Agros2D::scene()->nodes->items()
+            && m_geometryEdges == Agros2D::scene()->edges->items()
+            && m_geometryLabels == Agros2D::scene()->labels->items())
+        return;
+
+    m_geometryNodes = Agros2D::scene()->nodes->items();
+    m_geometryEdges = Agros2D::scene()->edges->items();
+    m_geometryLabels = Agros2D::scene()->labels->items();
+
+    RectPoint rect = Agros2D::scene()->boundingBox();
+
+    // nodes
+    m_nodeVertices.clear();
+    m_nodeVertices.reserve(2 * m_geometryNodes.count());
+    m_nodeIndex.setBounds(rect, m_geometryNodes.count());
+    for (int i = 0; i < m_geometryNodes.count(); i++)
+    {
+        const Point &point = m_geometryNodes[i]->point();
+        m_nodeVertices << point.x << point.y;
+
+        m_nodeIndex.insert(i, point);
+    }
+
+    // edges (tessellation is reused for unchanged edges)
+    QHash<SceneEdge *, EdgeTessellation> edgeTessellation;
+    edgeTessellation.reserve(m_geometryEdges.count());
+
+    m_edgeVertices.clear();
+    m_edgeFirst.clear();
+    m_edgeFirst.reserve(m_geometryEdges.count() + 1);
+    m_edgeIndex.setBounds(rect, m_geometryEdges.count());
+    for (int i = 0; i < m_geometryEdges.count(); i++)
+    {
+        SceneEdge *edge = m_geometryEdges[i];
+
+        EdgeTessellation tessellation = m_edgeTessellation.value(edge);
+        if (tessellation.points.isEmpty()
+                || tessellation.start != edge->nodeStart()->point()
+                || tessellation.end != edge->nodeEnd()->point()
+                || tessellation.angle != edge->angle())
+        {
+            tessellation.start = edge->nodeStart()->point();
+            tessellation.end = edge->nodeEnd()->point();
+            tessellation.angle = edge->angle();
+            tessellation.points.clear();
+
+            if (fabs(edge->angle()) < 5) // if (edge->isStraight())
+            {
+                tessellation.points << tessellation.start << tessellation.end;
+            }
+            else
+            {
+                // same segmentation as drawArc
+                Point center = edge->center();
+                double radius = edge->radius();
+                double startAngle = atan2(center.y - tessellation.start.y,
+                                          center.x - tessellation.start.x) / M_PI*180.0 - 180.0;
+
+                int segments = (edge->angle() < 10) ? 10 : edge->angle() / 3;
+                if (segments < 2) segments = 2;
+                double theta = edge->angle() / double(segments - 1);
+
+                for (int j = 0; j < segments; j++)
+                {
+                    double arc = (startAngle + j*theta)/180.0*M_PI;
+                    tessellation.points << Point(center.x + radius * fastcos(arc),
+                                                 center.y + radius * fastsin(arc));
+                }
+            }
+        }
+        edgeTessellation.insert(edge, tessellation);
+
+        // line strip stored as separate segments, all edges are drawn by one call
+        m_edgeFirst.append(m_edgeVertices.count() / 2);
+        for (int j = 1; j < tessellation.points.count(); j++)
+        {
+            m_edgeVertices << tessellation.points[j - 1].x << tessellation.points[j - 1].y;
+            m_edgeVertices << tessellation.points[j].x << tessellation.points[j].y;
+        }
+
+        m_edgeIndex.insert(i, tessellation.points);
+    }
+    m_edgeFirst.append(m_edgeVertices.count() / 2);
+    m_edgeTessellation = edgeTessellation;
+
+    // labels
+    m_labelVertices.clear();
+    m_labelAreaVertices.clear();
+    m_labelVertices.reserve(2 * m_geometryLabels.count());
+    foreach (SceneLabel *label, m_geometryLabels)
+    {
+        m_labelVertices << label->point().x << label->point().y;
+
+        // area size
+        double radius = sqrt(label->area()/M_PI);
+        if (radius > 0)
+        {
+            for (int i = 0; i<360; i = i + 10)
+            {
+                m_labelAreaVertices << label->point().x + radius*fastcos(i/180.0*M_PI)
+                                    << label->point().y + radius*fastsin(i/180.0*M_PI);
+                m_labelAreaVertices << label->point().x + radius*fastcos((i + 10)/180.0*M_PI)
+                                    << label->point().y + radius*fastsin((i + 10)/180.0*M_PI);
+            }
+        }
+    }
+
+    // polygon triangles
+    m_triangleVertices.clear();
+    m_triangleFirst.clear();
+    m_triangleLabels.clear();
+    try
+    {
+        QMap<SceneLabel*, QList<LoopsInfo::Triangle> > polygonTriangles = Agros2D::scene()->loopsInfo()->polygonTriangles();
+
+        int count = 0;
+        foreach (QList<LoopsInfo::Triangle> triangles, polygonTriangles)
+            count += triangles.count();
+        m_triangleIndex.setBounds(rect, count);
+
+        QMapIterator<SceneLabel*, QList<LoopsInfo::Triangle> > i(polygonTriangles);
+        while (i.hasNext())
+        {
+            i.next();
+
+            m_triangleLabels.append(i.key());
+            m_triangleFirst.append(m_triangleVertices.count() / 2);
+            foreach (LoopsInfo::Triangle triangle, i.value())
+            {
+                Point start(qMin(triangle.a.x, qMin(triangle.b.x, triangle.c.x)), qMin(triangle.a.y, qMin(triangle.b.y, triangle.c.y)));
+                Point end(qMax(triangle.a.x, qMax(triangle.b.x, triangle.c.x)), qMax(triangle.a.y, qMax(triangle.b.y, triangle.c.y)));
+                m_triangleIndex.insert(m_triangleVertices.count() / 6, RectPoint(start, end));
+
+                m_triangleVertices << triangle.a.x << triangle.a.y;
+                m_triangleVertices << triangle.b.x << triangle.b.y;
+                m_triangleVertices << triangle.c.x << triangle.c.y;
+            }
+        }
+    }
+    catch (AgrosException& ame)
+    {
+        // geometry in process of its creation by the user, triangles are not available
+        m_triangleVertices.clear();
+        m_triangleLabels.clear();
+        m_triangleFirst.clear();
+        m_triangleIndex.clear();
+    }
+    m_triangleFirst.append(m_triangleVertices.count() / 2);
+
+    m_geometryDirty = false;
+}
+
+SceneNode *SceneViewPreprocessor::closestNode(const Point &point)
+{
+    updateGeometryCache();
+
+    int i = m_nodeIndex.nearest(point, [this, &point](int item) { return m_geometryNodes[item]->distance(point); });
+    return (i != -1) ? m_geometryNodes[i] : NULL;
+}
+
+SceneEdge *SceneViewPreprocessor::closestEdge(const Point &point)
+{
+    updateGeometryCache();
+
+    int i = m_edgeIndex.nearest(point, [this, &point](int item) { return m_geometryEdges[item]->distance(point); });
+    return (i != -1) ? m_geometryEdges[i] : NULL;
+}
+
+SceneLabel *SceneViewPreprocessor::closestLabel(const Point &point)
+{
+    if (Agros2D::scene()->loopsInfo()->isProcessPolygonError())
+        return SceneLabel::findClosestLabel(point);
+
+    updateGeometryCache();
+
+    foreach (int triangle, m_triangleIndex.items(point))
+    {
+        const GLdouble *v = m_triangleVertices.constData() + 6 * triangle;
+        Point a(v[0], v[1]), b(v[2], v[3]), c(v[4], v[5]);
+
+        bool b1 = (point.x - b.x) * (a.y - b.y) - (a.x - b.x) * (point.y - b.y) < 0.0;
+        bool b2 = (point.x - c.x) * (b.y - c.y) - (b.x - c.x) * (point.y - c.y) < 0.0;
+        bool b3 = (point.x - a.x) * (c.y - a.y) - (c.x - a.x) * (point.y - a.y) < 0.0;
+
+        if ((b1 == b2) && (b2 == b3))
+        {
+            // in triangle, find label by first vertex of its group
+            int group = std::upper_bound(m_triangleFirst.begin(), m_triangleFirst.end(), 3 * triangle) - m_triangleFirst.begin() - 1;
+            return m_triangleLabels[group];
+        }
+    }
+
+    return NULL;
 }
 
 void SceneViewPreprocessor::paintGeometry()
 {
     loadProjection2d(true);
 
+    updateGeometryCache();
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+
     // edges
-    foreach (SceneEdge *edge, Agros2D::scene()->edges->items())
+    QSet<SceneEdge *> crossings = Agros2D::scene()->crossings().toSet();
+
+    glVertexPointer(2, GL_DOUBLE, 0, m_edgeVertices.constData());
+
+    // consecutive edges with default style are drawn by one call
+    int run = 0;
+    for (int i = 0; i <= m_geometryEdges.count(); i++)
     {
-        if (m_sceneMode == SceneGeometryMode_OperateOnEdges)
+        SceneEdge *edge = (i < m_geometryEdges.count()) ? m_geometryEdges[i] : NULL;
+
+        bool isStipple = edge && (m_sceneMode == SceneGeometryMode_OperateOnEdges) && (edge->markersCount() == 0);
+        bool isCrossed = edge && (edge->hasLyingNode() || edge->isOutsideArea() || crossings.contains(edge));
+        if (edge && !isStipple && !isCrossed && !edge->isHighlighted() && !edge->isSelected())
+            continue;
+
+        if (run < i)
+        {
+            glColor3d(COLOREDGE[0], COLOREDGE[1], COLOREDGE[2]);
+            glLineWidth(EDGEWIDTH);
+            glDrawArrays(GL_LINES, m_edgeFirst[run], m_edgeFirst[i] - m_edgeFirst[run]);
+        }
+        run = i + 1;
+
+        if (!edge)
+            break;
+
+        if (isStipple)
         {
             // edge without marker
-            if (edge->markersCount() == 0)
-            {
-                glEnable(GL_LINE_STIPPLE);
-                glLineStipple(1, 0x8FFF);
-            }
+            glEnable(GL_LINE_STIPPLE);
+            glLineStipple(1, 0x8FFF);
         }
 
         glColor3d(COLOREDGE[0], COLOREDGE[1], COLOREDGE[2]);
         glLineWidth(EDGEWIDTH);
 
-        if (edge->hasLyingNode() || edge->isOutsideArea() || Agros2D::scene()->crossings().contains(edge))
+        if (isCrossed)
         {
             glColor3d(COLORCROSSED[0], COLORCROSSED[1], COLORCROSSED[2]);
             glLineWidth(EDGEWIDTH);
@@ -988,43 +1223,26 @@ void SceneViewPreprocessor::paintGeometry()
             glLineWidth(EDGEWIDTH + 2.0);
         }
 
-        if (fabs(edge->angle()) < 5) // if (edge->isStraight())
-        {
-            glBegin(GL_LINES);
-            glVertex2d(edge->nodeStart()->point().x, edge->nodeStart()->point().y);
-            glVertex2d(edge->nodeEnd()->point().x, edge->nodeEnd()->point().y);
-            glEnd();
-        }
-        else
-        {
-            Point center = edge->center();
-            double radius = edge->radius();
-            double startAngle = atan2(center.y - edge->nodeStart()->point().y,
-                                      center.x - edge->nodeStart()->point().x) / M_PI*180.0 - 180.0;
-
-            drawArc(center, radius, startAngle, edge->angle());
-        }
+        glDrawArrays(GL_LINES, m_edgeFirst[i], m_edgeFirst[i + 1] - m_edgeFirst[i]);
 
         glDisable(GL_LINE_STIPPLE);
-        glLineWidth(1.0);
     }
+    glLineWidth(1.0);
 
     // nodes
-    foreach (SceneNode *node, Agros2D::scene()->nodes->items())
-    {
-        glColor3d(COLORNODE[0], COLORNODE[1], COLORNODE[2]);
-        glPointSize(NODESIZE);
+    glVertexPointer(2, GL_DOUBLE, 0, m_nodeVertices.constData());
 
-        glBegin(GL_POINTS);
-        glVertex2d(node->point().x, node->point().y);
-        glEnd();
+    glColor3d(COLORNODE[0], COLORNODE[1], COLORNODE[2]);
+    glPointSize(NODESIZE);
+    glDrawArrays(GL_POINTS, 0, m_geometryNodes.count());
 
-        glColor3d(COLORBACKGROUND[0], COLORBACKGROUND[1], COLORBACKGROUND[2]);
-        glPointSize(NODESIZE - 2.0);
+    glColor3d(COLORBACKGROUND[0], COLORBACKGROUND[1], COLORBACKGROUND[2]);
+    glPointSize(NODESIZE - 2.0);
+    glDrawArrays(GL_POINTS, 0, m_geometryNodes.count());
 
-        glBegin(GL_POINTS);
-        glVertex2d(node->point().x, node->point().y);
-        glEnd();
+    for (int i = 0; i < m_geometryNodes.count(); i++)
+    {
+        SceneNode *node = m_geometryNodes[i];
 
         bool isError = false;
         if ((node->isSelected()) || (node->isHighlighted()) || (isError = node->isError()) )
@@ -1047,26 +1265,24 @@ void SceneViewPreprocessor::paintGeometry()
                 glPointSize(EDGEWIDTH - 2.0);
             }
 
-            glBegin(GL_POINTS);
-            glVertex2d(node->point().x, node->point().y);
-            glEnd();
+            glDrawArrays(GL_POINTS, i, 1);
         }
     }
 
     // labels
-    foreach (SceneLabel *label, Agros2D::scene()->labels->items())
-    {
-        glColor3d(COLORLABEL[0], COLORLABEL[1], COLORLABEL[2]);
-        glPointSize(LABELSIZE);
-        glBegin(GL_POINTS);
-        glVertex2d(label->point().x, label->point().y);
-        glEnd();
+    glVertexPointer(2, GL_DOUBLE, 0, m_labelVertices.constData());
 
-        glColor3d(COLORBACKGROUND[0], COLORBACKGROUND[1], COLORBACKGROUND[2]);
-        glPointSize(LABELSIZE - 2.0);
-        glBegin(GL_POINTS);
-        glVertex2d(label->point().x, label->point().y);
-        glEnd();
+    glColor3d(COLORLABEL[0], COLORLABEL[1], COLORLABEL[2]);
+    glPointSize(LABELSIZE);
+    glDrawArrays(GL_POINTS, 0, m_geometryLabels.count());
+
+    glColor3d(COLORBACKGROUND[0], COLORBACKGROUND[1], COLORBACKGROUND[2]);
+    glPointSize(LABELSIZE - 2.0);
+    glDrawArrays(GL_POINTS, 0, m_geometryLabels.count());
+
+    for (int i = 0; i < m_geometryLabels.count(); i++)
+    {
+        SceneLabel *label = m_geometryLabels[i];
 
         if ((label->isSelected()) || (label->isHighlighted()))
         {
@@ -1076,107 +1292,56 @@ void SceneViewPreprocessor::paintGeometry()
                 glColor3d(COLORSELECTED[0], COLORSELECTED[1], COLORSELECTED[2]);
 
             glPointSize(LABELSIZE - 2.0);
-            glBegin(GL_POINTS);
-            glVertex2d(label->point().x, label->point().y);
-            glEnd();
-        }
-
-        // area size
-        if (m_sceneMode == SceneGeometryMode_OperateOnLabels)
-        {
-            double radius = sqrt(label->area()/M_PI);
-            if (radius > 0)
-            {
-                glColor3d(0, 0.95, 0.9);
-
-                glLineWidth(1.0);
-                glBegin(GL_LINE_LOOP);
-                for (int i = 0; i<360; i = i + 10)
-                {
-                    glVertex2d(label->point().x + radius*fastcos(i/180.0*M_PI),
-                               label->point().y + radius*fastsin(i/180.0*M_PI));
-                }
-                glEnd();
-            }
+            glDrawArrays(GL_POINTS, i, 1);
         }
     }
 
-    try
+    // area size
+    if (m_sceneMode == SceneGeometryMode_OperateOnLabels && !m_labelAreaVertices.isEmpty())
     {
-        if (Agros2D::scene()->crossings().isEmpty())
-        {
-            glEnable(GL_POLYGON_OFFSET_FILL);
-            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-            // glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-
-            // blended rectangle
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-            glBegin(GL_TRIANGLES);
-            QMapIterator<SceneLabel*, QList<LoopsInfo::Triangle> > i(Agros2D::scene()->loopsInfo()->polygonTriangles());
-            while (i.hasNext())
-            {
-                i.next();
-
-                if (i.key()->isSelected() && i.key()->isHole())
-                    glColor4f(0.7, 0.1, 0.3, 0.55);
-                else if (i.key()->isSelected())
-                    glColor4f(0.3, 0.1, 0.7, 0.55);
-                else if (i.key()->isHighlighted() && i.key()->isHole())
-                    glColor4f(0.7, 0.1, 0.3, 0.10);
-                else if (i.key()->isHighlighted())
-                    glColor4f(0.3, 0.1, 0.7, 0.18);
-                else if (i.key()->isHole())
-                    glColor4f(0.3, 0.1, 0.7, 0.00);
-                else
-                    glColor4f(0.3, 0.1, 0.7, 0.10);
-
-                foreach (LoopsInfo::Triangle triangle, i.value())
-                {
-                    glVertex2d(triangle.a.x, triangle.a.y);
-                    glVertex2d(triangle.b.x, triangle.b.y);
-                    glVertex2d(triangle.c.x, triangle.c.y);
-                }
-            }
-            glEnd();
+        glColor3d(0, 0.95, 0.9);
+        glLineWidth(1.0);
 
-            glDisable(GL_BLEND);
-            glDisable(GL_POLYGON_OFFSET_FILL);
-        }
+        glVertexPointer(2, GL_DOUBLE, 0, m_labelAreaVertices.constData());
+        glDrawArrays(GL_LINES, 0, m_labelAreaVertices.count() / 2);
+    }
 
-        // FIX: temp
-        /*
+    if (Agros2D::scene()->crossings().isEmpty() && !m_triangleLabels.isEmpty())
+    {
         glEnable(GL_POLYGON_OFFSET_FILL);
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-        QMapIterator<SceneLabel*, QList<Triangle> > j(labels);
-        while (j.hasNext())
-        {
-            j.next();
+        // blended rectangle
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-            glColor4f(0.3, 0.1, 0.7, 0.55);
+        glVertexPointer(2, GL_DOUBLE, 0, m_triangleVertices.constData());
+        for (int i = 0; i < m_triangleLabels.count(); i++)
+        {
+            SceneLabel *label = m_triangleLabels[i];
+
+            if (label->isSelected() && label->isHole())
+                glColor4f(0.7, 0.1, 0.3, 0.55);
+            else if (label->isSelected())
+                glColor4f(0.3, 0.1, 0.7, 0.55);
+            else if (label->isHighlighted() && label->isHole())
+                glColor4f(0.7, 0.1, 0.3, 0.10);
+            else if (label->isHighlighted())
+                glColor4f(0.3, 0.1, 0.7, 0.18);
+            else if (label->isHole())
+                continue;
+            else
+                glColor4f(0.3, 0.1, 0.7, 0.10);
 
-            glBegin(GL_TRIANGLES);
-            foreach (Triangle triangle, j.value())
-            {
-                glVertex2d(triangle.a.x, triangle.a.y);
-                glVertex2d(triangle.b.x, triangle.b.y);
-                glVertex2d(triangle.c.x, triangle.c.y);
-            }
-            glEnd();
+            glDrawArrays(GL_TRIANGLES, m_triangleFirst[i], m_triangleFirst[i + 1] - m_triangleFirst[i]);
         }
 
+        glDisable(GL_BLEND);
         glDisable(GL_POLYGON_OFFSET_FILL);
-        */
-    }
-    catch (AgrosException& ame)
-    {
-        // This is a function responsible for painting geometry in process of its creation by the user.
-        // Situations, which do not represent valid geometry, are acceptable here
-        // Therefore catch exceptions and do nothing
     }
 
+    glDisableClientState(GL_VERTEX_ARRAY);
+
     // labels hints
     loadProjectionViewPort();
 
@@ -22,9 +22,14 @@
 
 #include "util.h"
 #include "util/loops.h"
+#include "util/spatial_index.h"
 
 #include "sceneview_common2d.h"
 
+class SceneNode;
+class SceneEdge;
+class SceneLabel;
+
 class SceneViewPreprocessor : public SceneViewCommon2D
 {
     Q_OBJECT
@@ -94,6 +99,14 @@ protected:
 
     void paintBackgroundPixmap();
 
+    // picking through spatial index
+    SceneNode *closestNode(const Point &point);
+    SceneEdge *closestEdge(const Point &point);
+    SceneLabel *closestLabel(const Point &point);
+
+private slots:
+    void invalidateGeometry();
+
 private:
     QMenu *mnuScene;
 
@@ -104,6 +117,36 @@ private:
     bool m_selectRegion;
     QPointF m_selectRegionPos;
 
+    // tessellated geometry (client-side vertex arrays)
+    struct EdgeTessellation
+    {
+        Point start;
+        Point end;
+        double angle;
+        QVector<Point> points;
+    };
+
+    bool m_geometryDirty;
+    QList<SceneNode *> m_geometryNodes;
+    QList<SceneEdge *> m_geometryEdges;
+    QList<SceneLabel *> m_geometryLabels;
+
+    QHash<SceneEdge *, EdgeTessellation> m_edgeTessellation;
+    QVector<GLdouble> m_edgeVertices;
+    QVector<int> m_edgeFirst;
+    QVector<GLdouble> m_nodeVertices;
+    QVector<GLdouble> m_labelVertices;
+    QVector<GLdouble> m_labelAreaVertices;
+    QVector<GLdouble> m_triangleVertices;
+    QVector<int> m_triangleFirst;
+    QList<SceneLabel *> m_triangleLabels;
+
+    SpatialIndex m_nodeIndex;
+    SpatialIndex m_edgeIndex;
+    SpatialIndex m_triangleIndex;
+
+    void updateGeometryCache();
+
     void createActionsGeometry();
     void createMenuGeometry();
 };
@@ -72,9 +72,6 @@ void SceneViewMesh::createActionsMesh()
 
 void SceneViewMesh::refresh()
 {
-    m_arrayInitialMesh.clear();
-    m_arraySolutionMesh.clear();
-    m_arrayOrderMesh.clear();
     m_arrayOrderMeshColor.clear();
 
     setControls();
@@ -159,6 +156,10 @@ void SceneViewMesh::paintGL()
     if (!isVisible()) return;
     makeCurrent();
 
+    // changed views are processed once and painted when ready
+    if (Agros2D::problem()->isMeshed())
+        m_postHermes->refreshLater(PostHermes::ViewType_Mesh);
+
     glClearColor(COLORBACKGROUND[0], COLORBACKGROUND[1], COLORBACKGROUND[2], 0);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -202,6 +203,8 @@ void SceneViewMesh::paintGL()
     if (Agros2D::configComputer()->value(Config::Config_ShowAxes).toBool()) paintAxes();
 
     paintZoomRegion();
+
+    flushText();
 }
 
 void SceneViewMesh::paintGeometry()
@@ -238,37 +241,21 @@ void SceneViewMesh::paintInitialMesh()
 {
     if (!Agros2D::problem()->isMeshed()) return;
 
-    if (m_arrayInitialMesh.isEmpty())
-    {
-        if (!m_postHermes->linInitialMeshView()) return;
-
-        // edges
-        m_arrayInitialMesh.reserve(2 * m_postHermes->linInitialMeshView()->get_edge_count());
-
-        for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::edge_t>
-             it = m_postHermes->linInitialMeshView()->edges_begin(); !it.end; ++it)
-        {
-            Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::edge_t& edge = it.get();
+    QSharedPointer<PostHermesMeshView> view = m_postHermes->initialMeshView();
+    if (!view) return;
 
-            m_arrayInitialMesh.append(QVector2D(edge[0][0], edge[0][1]));
-            m_arrayInitialMesh.append(QVector2D(edge[1][0], edge[1][1]));
-        }
-    }
-    else
-    {
-        loadProjection2d(true);
+    loadProjection2d(true);
 
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        glColor3d(COLORINITIALMESH[0], COLORINITIALMESH[1], COLORINITIALMESH[2]);
-        glLineWidth(1.3);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    glColor3d(COLORINITIALMESH[0], COLORINITIALMESH[1], COLORINITIALMESH[2]);
+    glLineWidth(1.3);
 
-        glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_VERTEX_ARRAY);
 
-        glVertexPointer(2, GL_FLOAT, 0, m_arrayInitialMesh.constData());
-        glDrawArrays(GL_LINES, 0, m_arrayInitialMesh.size());
+    glVertexPointer(2, GL_FLOAT, 0, view->edges.constData());
+    glDrawArrays(GL_LINES, 0, view->edges.size());
 
-        glDisableClientState(GL_VERTEX_ARRAY);
-    }
+    glDisableClientState(GL_VERTEX_ARRAY);
 }
 
 
@@ -276,99 +263,63 @@ void SceneViewMesh::paintSolutionMesh()
 {
     if (!Agros2D::problem()->isSolved()) return;
 
-    if (m_arraySolutionMesh.isEmpty())
-    {
-        if (!m_postHermes->linSolutionMeshView()) return;
-
-        // edges
-        m_arraySolutionMesh.reserve(2 * m_postHermes->linSolutionMeshView()->get_edge_count());
+    QSharedPointer<PostHermesMeshView> view = m_postHermes->solutionMeshView();
+    if (!view) return;
 
-        for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::edge_t>
-             it = m_postHermes->linSolutionMeshView()->edges_begin(); !it.end; ++it)
-        {
-            Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::edge_t& edge = it.get();
-
-            m_arraySolutionMesh.append(QVector2D(edge[0][0], edge[0][1]));
-            m_arraySolutionMesh.append(QVector2D(edge[1][0], edge[1][1]));
-        }
-    }
-    else
-    {
-        loadProjection2d(true);
+    loadProjection2d(true);
 
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        glColor3d(COLORSOLUTIONMESH[0], COLORSOLUTIONMESH[1], COLORSOLUTIONMESH[2]);
-        glLineWidth(1.3);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    glColor3d(COLORSOLUTIONMESH[0], COLORSOLUTIONMESH[1], COLORSOLUTIONMESH[2]);
+    glLineWidth(1.3);
 
-        glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_VERTEX_ARRAY);
 
-        glVertexPointer(2, GL_FLOAT, 0, m_arraySolutionMesh.constData());
-        glDrawArrays(GL_LINES, 0, m_arraySolutionMesh.size());
+    glVertexPointer(2, GL_FLOAT, 0, view->edges.constData());
+    glDrawArrays(GL_LINES, 0, view->edges.size());
 
-        glDisableClientState(GL_VERTEX_ARRAY);
-    }
+    glDisableClientState(GL_VERTEX_ARRAY);
 }
 
 void SceneViewMesh::paintOrder()
 {
     if (!Agros2D::problem()->isSolved()) return;
 
-    if (m_arrayOrderMesh.isEmpty())
-    {
-        if (!m_postHermes->ordView()) return;
+    QSharedPointer<PostHermesOrderView> view = m_postHermes->orderView();
+    if (!view) return;
 
-        // order scalar view
-        double3* vert = m_postHermes->ordView()->get_vertices();
-        int3* tris = m_postHermes->ordView()->get_triangles();
-
-        // draw mesh
-        int min = 11;
-        int max = 1;
-        for (int i = 0; i < m_postHermes->ordView()->get_num_triangles(); i++)
-        {
-            if (vert[tris[i][0]][2] < min) min = vert[tris[i][0]][2];
-            if (vert[tris[i][0]][2] > max) max = vert[tris[i][0]][2];
-        }
-
-        // triangles
-        m_arrayOrderMesh.reserve(3 * m_postHermes->ordView()->get_num_triangles());
-        m_arrayOrderMeshColor.reserve(3 * m_postHermes->ordView()->get_num_triangles());
-        for (int i = 0; i < m_postHermes->ordView()->get_num_triangles(); i++)
+    // colors of triangles
+    if (m_arrayOrderMeshColor.size() != view->triangles.size())
+    {
+        m_arrayOrderMeshColor.clear();
+        m_arrayOrderMeshColor.reserve(view->triangles.size());
+        for (int i = 0; i < view->orders.size(); i++)
         {
-            int color = vert[tris[i][0]][2];
-            QVector3D colorVector = QVector3D(paletteColorOrder(color)[0],
-                    paletteColorOrder(color)[1],
-                    paletteColorOrder(color)[2]);
+            QVector3D colorVector = QVector3D(paletteColorOrder(view->orders[i])[0],
+                    paletteColorOrder(view->orders[i])[1],
+                    paletteColorOrder(view->orders[i])[2]);
 
-            m_arrayOrderMesh.append(QVector2D(vert[tris[i][0]][0], vert[tris[i][0]][1]));
             m_arrayOrderMeshColor.append(colorVector);
-
-            m_arrayOrderMesh.append(QVector2D(vert[tris[i][1]][0], vert[tris[i][1]][1]));
             m_arrayOrderMeshColor.append(colorVector);
-
-            m_arrayOrderMesh.append(QVector2D(vert[tris[i][2]][0], vert[tris[i][2]][1]));
             m_arrayOrderMeshColor.append(colorVector);
         }
     }
-    else
-    {
-        loadProjection2d(true);
 
-        glEnable(GL_POLYGON_OFFSET_FILL);
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    loadProjection2d(true);
+
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-        glEnableClientState(GL_COLOR_ARRAY);
-        glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glEnableClientState(GL_VERTEX_ARRAY);
 
-        glVertexPointer(2, GL_FLOAT, 0, m_arrayOrderMesh.constData());
-        glColorPointer(3, GL_FLOAT, 0, m_arrayOrderMeshColor.constData());
-        glDrawArrays(GL_TRIANGLES, 0, m_arrayOrderMesh.size());
+    glVertexPointer(2, GL_FLOAT, 0, view->triangles.constData());
+    glColorPointer(3, GL_FLOAT, 0, m_arrayOrderMeshColor.constData());
+    glDrawArrays(GL_TRIANGLES, 0, view->triangles.size());
 
-        glDisableClientState(GL_VERTEX_ARRAY);
-        glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
 
-        glDisable(GL_POLYGON_OFFSET_FILL);
-    }
+    glDisable(GL_POLYGON_OFFSET_FILL);
 
     // paint labels
     if (Agros2D::problem()->setting()->value(ProblemSetting::View_ShowOrderLabel).toBool())
@@ -378,22 +329,14 @@ void SceneViewMesh::paintOrder()
         glScaled(2.0 / width(), 2.0 / height(), 1.0);
         glTranslated(-width() / 2.0, -height() / 2.0, 0.0);
 
-        double3* vert = m_postHermes->ordView()->get_vertices();
-        int* lvert;
-        char** ltext;
-        double2* lbox;
-        int nl = m_postHermes->ordView()->get_labels(lvert, ltext, lbox);
-
-        for (int i = 0; i < nl; i++)
+        for (int i = 0; i < view->labels.size(); i++)
         {
             glColor3d(1, 1, 1);
-            // if (lbox[i][0]/m_scale*aspect() > size.x && lbox[i][1]/m_scale > size.y)
-            {
-                Point scr = untransform(vert[lvert[i]][0], vert[lvert[i]][1]);
-                printPostAt(scr.x - (m_charDataPost[GLYPH_M].x1 - m_charDataPost[GLYPH_M].x0) / 2.0,
-                            scr.y - (m_charDataPost[GLYPH_M].y1 - m_charDataPost[GLYPH_M].y0) / 2.0,
-                            ltext[i]);
-            }
+
+            Point scr = untransform(view->labelPositions[i].x(), view->labelPositions[i].y());
+            printPostAt(scr.x - (m_charDataPost[GLYPH_M].x1 - m_charDataPost[GLYPH_M].x0) / 2.0,
+                        scr.y - (m_charDataPost[GLYPH_M].y1 - m_charDataPost[GLYPH_M].y0) / 2.0,
+                        view->labels[i]);
         }
     }
 }
@@ -402,17 +345,10 @@ void SceneViewMesh::paintOrderColorBar()
 {
     if (!Agros2D::problem()->isSolved() || !Agros2D::problem()->setting()->value(ProblemSetting::View_ShowOrderColorBar).toBool()) return;
 
-    // order scalar view
-    double3* vert = m_postHermes->ordView()->get_vertices();
-    int3* tris = m_postHermes->ordView()->get_triangles();
+    QSharedPointer<PostHermesOrderView> view = m_postHermes->orderView();
+    if (!view) return;
 
-    int min = 11;
-    int max = 1;
-    for (int i = 0; i < m_postHermes->ordView()->get_num_triangles(); i++)
-    {
-        if (vert[tris[i][0]][2] < min) min = vert[tris[i][0]][2];
-        if (vert[tris[i][0]][2] > max) max = vert[tris[i][0]][2];
-    }
+    int max = view->orderMax;
 
     // order color map
     loadProjectionViewPort();
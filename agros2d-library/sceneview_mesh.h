@@ -56,9 +56,7 @@ protected:
     void paintOrderColorBar();
 
 private:
-    QVector<QVector2D> m_arrayInitialMesh;
-    QVector<QVector2D> m_arraySolutionMesh;
-    QVector<QVector2D> m_arrayOrderMesh;
+    // geometry is generated by postHermes, colors follow the palette
     QVector<QVector3D> m_arrayOrderMeshColor;
 
     void createActionsMesh();
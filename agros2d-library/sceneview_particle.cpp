@@ -45,6 +45,12 @@
 
 #include "hermes2d/field.h"
 #include "hermes2d/problem_config.h"
+#include "hermes2d/solutionstore.h"
+
+// start points and colors of particles
+static const int PARTICLE_TRACING_RANDOM_SEED = 1;
+// tolerance of the trajectory decimation (pixels)
+static const double PARTICLE_TRACING_DECIMATION_PIXELS = 0.5;
 
 ParticleTracingWidget::ParticleTracingWidget(SceneViewParticleTracing *sceneView, QWidget *parent): QWidget(parent)
 {
@@ -425,8 +431,7 @@ void ParticleTracingWidget::doApply()
 // *************************************************************************************************
 
 SceneViewParticleTracing::SceneViewParticleTracing(PostHermes *postHermes, QWidget *parent)
-    : SceneViewCommon3D(postHermes, parent),
-      m_listParticleTracing(-1)
+    : SceneViewCommon3D(postHermes, parent)
 {
     createActionsParticleTracing();
 
@@ -487,6 +492,8 @@ void SceneViewParticleTracing::paintGL()
     emit labelCenter(tr("Particle tracing"));
 
     if (Agros2D::configComputer()->value(Config::Config_ShowAxes).toBool()) paintAxes();
+
+    flushText();
 }
 
 void SceneViewParticleTracing::resizeGL(int w, int h)
@@ -509,7 +516,7 @@ void SceneViewParticleTracing::paintGeometryOutline()
     glPushMatrix();
 
     glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
+    loadTileProjection();
 
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
@@ -666,7 +673,7 @@ void SceneViewParticleTracing::paintGeometrySurface(bool blend)
     glPushMatrix();
 
     glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
+    loadTileProjection();
 
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
@@ -831,162 +838,203 @@ void SceneViewParticleTracing::paintGeometrySurface(bool blend)
     glDisable(GL_POLYGON_OFFSET_FILL);
 }
 
-void SceneViewParticleTracing::paintParticleTracing()
+// keeps the endpoints and the points farther than tolerance from the simplified polyline (Douglas-Peucker)
+static void decimateTrajectory(const QVector<QVector3D> &points, double tolerance, QVector<bool> &keep)
 {
-    if (!Agros2D::problem()->isSolved()) return;
-    if (!particleTracingIsPrepared()) return;
+    keep.fill(false, points.count());
+    if (points.isEmpty())
+        return;
 
-    loadProjection3d(true, false);
+    keep.first() = true;
+    keep.last() = true;
 
-    if (m_listParticleTracing == -1)
+    QStack<QPair<int, int> > ranges;
+    ranges.push(qMakePair(0, points.count() - 1));
+    while (!ranges.isEmpty())
     {
-        m_listParticleTracing = glGenLists(1);
-        glNewList(m_listParticleTracing, GL_COMPILE);
+        QPair<int, int> range = ranges.pop();
 
-        RectPoint rect = Agros2D::scene()->boundingBox();
-        double max = qMax(rect.width(), rect.height());
-        double depth = max / Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DHeight).toDouble();
+        QVector3D start = points[range.first];
+        QVector3D direction = points[range.second] - start;
+        double length = direction.lengthSquared();
 
-        glPushMatrix();
+        int farthest = -1;
+        double distanceMax = tolerance;
+        for (int i = range.first + 1; i < range.second; i++)
+        {
+            // distance from segment
+            QVector3D vector = points[i] - start;
+            double t = (length > 0.0) ? qBound(0.0, QVector3D::dotProduct(vector, direction) / length, 1.0) : 0.0;
+            double distance = (vector - direction * t).length();
 
-        glMatrixMode(GL_PROJECTION);
-        glLoadIdentity();
+            if (distance > distanceMax)
+            {
+                distanceMax = distance;
+                farthest = i;
+            }
+        }
 
-        glMatrixMode(GL_MODELVIEW);
-        glLoadIdentity();
+        if (farthest != -1)
+        {
+            keep[farthest] = true;
+            ranges.push(qMakePair(range.first, farthest));
+            ranges.push(qMakePair(farthest, range.second));
+        }
+    }
+}
 
-        glPopMatrix();
+void SceneViewParticleTracing::createParticleTracingArrays(double tolerance)
+{
+    m_arrayParticles.clear();
+    m_arrayParticlesColors.clear();
+    m_arrayParticlesFirst.clear();
+    m_arrayParticlesPoints.clear();
 
-        double velocityMin = m_velocityMin;
-        double velocityMax = m_velocityMax;
+    bool colorByVelocity = Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleColorByVelocity).toBool();
+    bool showPoints = Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleShowPoints).toBool();
 
-        double positionMin = m_positionMin;
-        double positionMax = m_positionMax;
+    double velocityRange = (m_velocityMax - m_velocityMin > EPS_ZERO) ? m_velocityMax - m_velocityMin : 1.0;
 
-        if ((positionMax - positionMin) < EPS_ZERO)
-        {
-            positionMin = -1.0;
-            positionMax = +1.0;
-        }
+    // same colors after rebuild of the arrays
+    srand(PARTICLE_TRACING_RANDOM_SEED);
 
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_LINE_SMOOTH);
-        glEnable(GL_POINT_SMOOTH);
+    int count = qMin(Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleNumberOfParticles).toInt(), m_positionsList.count());
 
-        // particle visualization
-        for (int k = 0; k < Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleNumberOfParticles).toInt(); k++)
+    QVector<QVector3D> points;
+    QVector<bool> keep;
+    for (int k = 0; k < count; k++)
+    {
+        QVector3D color(rand() / double(RAND_MAX),
+                        rand() / double(RAND_MAX),
+                        rand() / double(RAND_MAX));
+
+        // axisymmetric trajectory is stored for the first copy, other copies are rotated
+        points.clear();
+        points.reserve(m_positionsList[k].count());
+        foreach (Point3 position, m_positionsList[k])
         {
-            // starting point
-            /*
-            glPointSize(Agros2D::problem()->configView()->value(ProblemConfigView::View_NodeSize).toInt() * 1.2);
-            glColor3d(0.0, 0.0, 0.0);
-            glBegin(GL_POINTS);
             if (Agros2D::problem()->config()->coordinateType() == CoordinateType_Planar)
-                glVertex3d(m_positionsList[k][0].x, m_positionsList[k][0].y, -depth/2.0 + (m_positionsList[k][0].z - positionMin) * depth/(positionMax - positionMin));
+                points.append(QVector3D(position.x, position.y, 0.0));
             else
-                glVertex3d(m_positionsList[k][0].x * cos(m_positionsList[k][0].z), m_positionsList[k][0].y, m_positionsList[k][0].x * sin(m_positionsList[k][0].z));
-            glEnd();
-            */
-
-            glColor3d(rand() / double(RAND_MAX),
-                      rand() / double(RAND_MAX),
-                      rand() / double(RAND_MAX));
+                points.append(QVector3D(position.x * cos(position.z), position.y, position.x * sin(position.z)));
+        }
 
-            // lines
-            if (Agros2D::problem()->config()->coordinateType() == CoordinateType_Planar)
-            {
-                glLineWidth(1.5 * EDGEWIDTH);
+        decimateTrajectory(points, tolerance, keep);
 
-                glBegin(GL_LINES);
-                for (int i = 0; i < m_positionsList[k].length() - 1; i++)
-                {
-                    if (Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleColorByVelocity).toBool())
-                        glColor3d(1.0 - 0.8 * (m_velocitiesList[k][i].magnitude() - velocityMin) / (velocityMax - velocityMin),
-                                  1.0 - 0.8 * (m_velocitiesList[k][i].magnitude() - velocityMin) / (velocityMax - velocityMin),
-                                  1.0 - 0.8 * (m_velocitiesList[k][i].magnitude() - velocityMin) / (velocityMax - velocityMin));
-
-                    glVertex3d(m_positionsList[k][i].x,
-                               m_positionsList[k][i].y,
-                               0.0);
-                    glVertex3d(m_positionsList[k][i+1].x,
-                            m_positionsList[k][i+1].y,
-                            0.0);
-                }
-                glEnd();
+        m_arrayParticlesFirst.append(m_arrayParticles.count());
+        for (int i = 0; i < points.count(); i++)
+        {
+            if (!keep[i])
+                continue;
 
-                // points
-                if (Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleShowPoints).toBool())
-                {
-                    glColor3d(0.0, 0.0, 0.0);
-                    glPointSize(NODESIZE);
+            m_arrayParticles.append(points[i]);
 
-                    glBegin(GL_POINTS);
-                    for (int i = 0; i < m_positionsList[k].length(); i++)
-                    {
-                        glVertex3d(m_positionsList[k][i].x,
-                                   m_positionsList[k][i].y,
-                                   0.0);
-                    }
-                    glEnd();
-                }
+            if (colorByVelocity && (i < m_velocitiesList[k].count()))
+            {
+                double gray = 1.0 - 0.8 * (m_velocitiesList[k][i].magnitude() - m_velocityMin) / velocityRange;
+                m_arrayParticlesColors.append(QVector3D(gray, gray, gray));
             }
             else
             {
-                double stepAngle = 360.0 / Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleNumShowParticlesAxi).toInt();
+                m_arrayParticlesColors.append(color);
+            }
+        }
 
-                for (int l = 0; l < Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleNumShowParticlesAxi).toInt(); l++)
-                {
-                    glLineWidth(1.5 * EDGEWIDTH);
+        // points of the solver are not decimated
+        if (showPoints)
+            m_arrayParticlesPoints += points;
+    }
+    m_arrayParticlesFirst.append(m_arrayParticles.count());
+}
 
-                    glBegin(GL_LINES);
-                    for (int i = 0; i < m_positionsList[k].length() - 1; i++)
-                    {
-                        if (Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleColorByVelocity).toBool())
-                            glColor3d(1.0 - 0.8 * (m_velocitiesList[k][i].magnitude() - velocityMin) / (velocityMax - velocityMin),
-                                      1.0 - 0.8 * (m_velocitiesList[k][i].magnitude() - velocityMin) / (velocityMax - velocityMin),
-                                      1.0 - 0.8 * (m_velocitiesList[k][i].magnitude() - velocityMin) / (velocityMax - velocityMin));
-
-                        glVertex3d(m_positionsList[k][i].x * cos(m_positionsList[k][i].z + l * stepAngle/180.0 * M_PI),
-                                   m_positionsList[k][i].y,
-                                   m_positionsList[k][i].x * sin(m_positionsList[k][i].z + l * stepAngle/180.0 * M_PI));
-                        glVertex3d(m_positionsList[k][i+1].x * cos(m_positionsList[k][i+1].z + l * stepAngle/180.0 * M_PI),
-                                m_positionsList[k][i+1].y,
-                                m_positionsList[k][i+1].x * sin(m_positionsList[k][i+1].z + l * stepAngle/180.0 * M_PI));
+void SceneViewParticleTracing::paintParticleTracing()
+{
+    if (!Agros2D::problem()->isSolved()) return;
+    if (!particleTracingIsPrepared()) return;
 
-                    }
-                    glEnd();
+    loadProjection3d(true, false);
 
-                    // points
-                    if (Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleShowPoints).toBool())
-                    {
-                        glColor3d(0.0, 0.0, 0.0);
-                        glPointSize(NODESIZE);
-
-                        glBegin(GL_POINTS);
-                        for (int i = 0; i < m_positionsList[k].length(); i++)
-                        {
-                            glVertex3d(m_positionsList[k][i].x * cos(m_positionsList[k][i].z + l * stepAngle/180.0 * M_PI),
-                                       m_positionsList[k][i].y,
-                                       m_positionsList[k][i].x * sin(m_positionsList[k][i].z + l * stepAngle/180.0 * M_PI));
-                        }
-                        glEnd();
-                    }
-                }
-            }
-        }
+    // decimation tolerance in scene units, rounded to powers of two (arrays are not rebuilt by small zoom changes)
+    double tolerance = PARTICLE_TRACING_DECIMATION_PIXELS * 2.0 / height() / m_scale3d;
+    tolerance = pow(2.0, floor(log(tolerance) / log(2.0)));
+
+    QString key = QString("%1|%2|%3|%4|%5").
+            arg(QString(m_particleTracingKey.toHex())).
+            arg(tolerance).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleNumberOfParticles).toInt()).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleColorByVelocity).toBool()).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleShowPoints).toBool());
+
+    if (key != m_arrayParticlesKey)
+    {
+        createParticleTracingArrays(tolerance);
+        m_arrayParticlesKey = key;
+    }
+
+    glPushMatrix();
+
+    glMatrixMode(GL_PROJECTION);
+    loadTileProjection();
+
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    glPopMatrix();
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_LINE_SMOOTH);
+    glEnable(GL_POINT_SMOOTH);
+
+    // copies of the axisymmetric trajectories are rotated by the modelview matrix
+    int copies = 1;
+    if (Agros2D::problem()->config()->coordinateType() == CoordinateType_Axisymmetric)
+        copies = qMax(1, Agros2D::problem()->setting()->value(ProblemSetting::View_ParticleNumShowParticlesAxi).toInt());
+    double stepAngle = 360.0 / copies;
+
+    // lines
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    glVertexPointer(3, GL_FLOAT, 0, m_arrayParticles.constData());
+    glColorPointer(3, GL_FLOAT, 0, m_arrayParticlesColors.constData());
 
-        glDisable(GL_LINE_SMOOTH);
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_POINT_SMOOTH);
+    glLineWidth(1.5 * EDGEWIDTH);
+    for (int l = 0; l < copies; l++)
+    {
+        glPushMatrix();
+        glRotated(- l * stepAngle, 0.0, 1.0, 0.0);
 
-        glEndList();
+        for (int k = 0; k < m_arrayParticlesFirst.count() - 1; k++)
+            glDrawArrays(GL_LINE_STRIP, m_arrayParticlesFirst[k], m_arrayParticlesFirst[k + 1] - m_arrayParticlesFirst[k]);
 
-        glCallList(m_listParticleTracing);
+        glPopMatrix();
     }
-    else
+
+    glDisableClientState(GL_COLOR_ARRAY);
+
+    // points
+    if (!m_arrayParticlesPoints.isEmpty())
     {
-        glCallList(m_listParticleTracing);
+        glColor3d(0.0, 0.0, 0.0);
+        glPointSize(NODESIZE);
+
+        glVertexPointer(3, GL_FLOAT, 0, m_arrayParticlesPoints.constData());
+        for (int l = 0; l < copies; l++)
+        {
+            glPushMatrix();
+            glRotated(- l * stepAngle, 0.0, 1.0, 0.0);
+
+            glDrawArrays(GL_POINTS, 0, m_arrayParticlesPoints.count());
+
+            glPopMatrix();
+        }
     }
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    glDisable(GL_LINE_SMOOTH);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_POINT_SMOOTH);
 }
 
 void SceneViewParticleTracing::paintParticleTracingColorBar(double min, double max)
@@ -1078,17 +1126,8 @@ void SceneViewParticleTracing::paintParticleTracingColorBar(double min, double m
                 str);
 }
 
-void SceneViewParticleTracing::clearGLLists()
-{
-    if (m_listParticleTracing != -1) glDeleteLists(m_listParticleTracing, 1);
-
-    m_listParticleTracing = -1;
-}
-
 void SceneViewParticleTracing::refresh()
 {
-    clearGLLists();
-
     setControls();
 
     if (Agros2D::problem()->isSolved())
@@ -1129,6 +1168,64 @@ void SceneViewParticleTracing::clearParticleLists()
 
     m_velocityMin = 0.0;
     m_velocityMax = 0.0;
+
+    m_particleTracingKey.clear();
+
+    m_arrayParticles.clear();
+    m_arrayParticlesColors.clear();
+    m_arrayParticlesFirst.clear();
+    m_arrayParticlesPoints.clear();
+    m_arrayParticlesKey.clear();
+}
+
+QByteArray SceneViewParticleTracing::particleTracingKey() const
+{
+    // display parameters (colors, points, blended faces, number of particles in axisymmetric view) are not included
+    static const ProblemSetting::Type physicalParameters[] = {
+        ProblemSetting::View_ParticleButcherTableType,
+        ProblemSetting::View_ParticleIncludeRelativisticCorrection,
+        ProblemSetting::View_ParticleNumberOfParticles,
+        ProblemSetting::View_ParticleStartingRadius,
+        ProblemSetting::View_ParticleMass,
+        ProblemSetting::View_ParticleConstant,
+        ProblemSetting::View_ParticleStartX,
+        ProblemSetting::View_ParticleStartY,
+        ProblemSetting::View_ParticleStartVelocityX,
+        ProblemSetting::View_ParticleStartVelocityY,
+        ProblemSetting::View_ParticleReflectOnDifferentMaterial,
+        ProblemSetting::View_ParticleReflectOnBoundary,
+        ProblemSetting::View_ParticleCoefficientOfRestitution,
+        ProblemSetting::View_ParticleCustomForceX,
+        ProblemSetting::View_ParticleCustomForceY,
+        ProblemSetting::View_ParticleCustomForceZ,
+        ProblemSetting::View_ParticleMaximumRelativeError,
+        ProblemSetting::View_ParticleMaximumStep,
+        ProblemSetting::View_ParticleMaximumNumberOfSteps,
+        ProblemSetting::View_ParticleDragDensity,
+        ProblemSetting::View_ParticleDragCoefficient,
+        ProblemSetting::View_ParticleDragReferenceArea,
+        ProblemSetting::View_ParticleP2PElectricForce,
+        ProblemSetting::View_ParticleP2PMagneticForce
+    };
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+
+    stream << PARTICLE_TRACING_RANDOM_SEED;
+    stream << (int) Agros2D::problem()->config()->coordinateType();
+    for (unsigned int i = 0; i < sizeof(physicalParameters) / sizeof(ProblemSetting::Type); i++)
+        stream << Agros2D::problem()->setting()->value(physicalParameters[i]);
+
+    // solutions used by particle tracing (last steps, revision changes when the field is solved again)
+    foreach (FieldInfo *fieldInfo, Agros2D::problem()->fieldInfos())
+    {
+        int timeStep = Agros2D::solutionStore()->lastTimeStep(fieldInfo, SolutionMode_Normal);
+        int adaptivityStep = Agros2D::solutionStore()->lastAdaptiveStep(fieldInfo, SolutionMode_Normal, timeStep);
+
+        stream << fieldInfo->fieldId() << timeStep << adaptivityStep << Agros2D::solutionStore()->fieldRevision(fieldInfo);
+    }
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
 }
 
 void SceneViewParticleTracing::processParticleTracing()
@@ -1136,10 +1233,21 @@ void SceneViewParticleTracing::processParticleTracing()
     QTime cpuTime;
     cpuTime.start();
 
+    // only display parameters were changed - trajectories are reused
+    QByteArray key = particleTracingKey();
+    if (particleTracingIsPrepared() && key == m_particleTracingKey)
+    {
+        refresh();
+        return;
+    }
+
     clearParticleLists();
 
     if (Agros2D::problem()->isSolved())
     {
+        // start points are scattered reproducibly
+        srand(PARTICLE_TRACING_RANDOM_SEED);
+
         Agros2D::log()->printMessage(tr("Post View"), tr("Particle view"));
 
         m_velocityMin =  numeric_limits<double>::max();
@@ -1198,6 +1306,8 @@ void SceneViewParticleTracing::processParticleTracing()
             // velocity min and max value
             m_velocityMin = particleTracing.velocityMin();
             m_velocityMax = particleTracing.velocityMax();
+
+            m_particleTracingKey = key;
         }
         catch (AgrosException& e)
         {
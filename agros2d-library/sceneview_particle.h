@@ -118,9 +118,15 @@ protected:
     void paintParticleTracingColorBar(double min, double max);
 
 private:
-    int m_listParticleTracing;
+    // trajectories - decimated line strips, axisymmetric copies are rotated when painted
+    QVector<QVector3D> m_arrayParticles;
+    QVector<QVector3D> m_arrayParticlesColors;
+    QVector<int> m_arrayParticlesFirst;
+    QVector<QVector3D> m_arrayParticlesPoints;
+    QString m_arrayParticlesKey;
 
     void createActionsParticleTracing();
+    void createParticleTracingArrays(double tolerance);
 
     // particle tracing
     ParticleTracing *particleTracing;
@@ -132,11 +138,14 @@ private:
     double m_velocityMin;
     double m_velocityMax;
 
+    // hash of the inputs of computed trajectories (solutions and physical parameters)
+    QByteArray m_particleTracingKey;
+    QByteArray particleTracingKey() const;
+
     inline bool particleTracingIsPrepared() { return !m_positionsList.isEmpty(); }
 
 private slots:
     virtual void refresh();
-    virtual void clearGLLists();
     void clearParticleLists();
     void setControls();
 };
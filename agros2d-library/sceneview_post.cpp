@@ -52,20 +52,283 @@
 
 #include "pythonlab/pythonengine.h"
 
+// refinement of the linearization without known viewport
+const int LINEARIZER_DEFAULT_LEVEL = 1;
+const int LINEARIZER_MAX_LEVEL = 4;
+// size of the linearized triangles on the screen
+const double LINEARIZER_TRIANGLE_PIXELS = 8.0;
+// whole mesh is linearized, finer levels are limited by the number of triangles
+const double LINEARIZER_MAX_TRIANGLES = 2e6;
+// memory of the cached mesh and order views (kB)
+const int MESH_VIEW_CACHE_SIZE = 65536;
+// memory of the cached linearizers and vectorizers (kB)
+const int LINEARIZER_CACHE_SIZE = 262144;
+
+// approximate size of the linearized data in kB (up to four values per vertex)
+template <typename View>
+static int linearizerCost(View *view)
+{
+    return (12 * view->get_triangle_count() + 8 * view->get_edge_count()) * sizeof(LINEARIZER_DATA_TYPE) / 1024 + 1;
+}
+
+// views computed by one refresh request, published at once
+class PostHermesJob
+{
+public:
+    PostHermesJob() :
+        views(0),
+        m_tasks(0),
+        m_cancelled(false)
+    {
+    }
+
+    QSharedPointer<PostHermesMeshView> initialMeshView;
+    QSharedPointer<PostHermesMeshView> solutionMeshView;
+    QSharedPointer<PostHermesOrderView> orderView;
+    QSharedPointer<Hermes::Hermes2D::Views::Linearizer> linContourView;
+    QSharedPointer<Hermes::Hermes2D::Views::Linearizer> linScalarView;
+    QSharedPointer<Hermes::Hermes2D::Views::Vectorizer> vecVectorView;
+
+    // processed views and their inputs
+    int views;
+    QMap<PostHermes::ViewType, QString> keys;
+
+    inline void addTask() { QMutexLocker lock(&m_mutex); m_tasks++; }
+    // returns true for the last finished task
+    inline bool finishTask() { QMutexLocker lock(&m_mutex); return (--m_tasks == 0); }
+    inline bool isFinished() { QMutexLocker lock(&m_mutex); return (m_tasks == 0); }
+
+    inline void cancel() { QMutexLocker lock(&m_mutex); m_cancelled = true; }
+    inline bool isCancelled() { QMutexLocker lock(&m_mutex); return m_cancelled; }
+
+    inline void addError(const QString &error) { QMutexLocker lock(&m_mutex); m_errors.append(error); }
+    inline QStringList errors() { QMutexLocker lock(&m_mutex); return m_errors; }
+
+private:
+    QMutex m_mutex;
+    int m_tasks;
+    bool m_cancelled;
+    QStringList m_errors;
+};
+
+// one linearization running in the post-processing thread pool
+class PostHermesTask : public QRunnable
+{
+public:
+    PostHermesTask(PostHermes *postHermes, QSharedPointer<PostHermesJob> job, const QString &name)
+        : m_postHermes(postHermes), m_job(job), m_name(name)
+    {
+        m_job->addTask();
+    }
+
+    virtual void run()
+    {
+        // stale request - skip the work
+        if (m_job->isCancelled())
+        {
+            discard();
+        }
+        else
+        {
+            try
+            {
+                process();
+            }
+            catch (Hermes::Exceptions::Exception &e)
+            {
+                discard();
+                m_job->addError(QObject::tr("%1 processing failed: %2").arg(m_name).arg(e.info().c_str()));
+            }
+            // exception must not leave the pool thread
+            catch (std::exception &e)
+            {
+                discard();
+                m_job->addError(QObject::tr("%1 processing failed: %2").arg(m_name).arg(e.what()));
+            }
+            catch (...)
+            {
+                discard();
+                m_job->addError(QObject::tr("%1 processing failed").arg(m_name));
+            }
+        }
+
+        if (m_job->finishTask())
+            QMetaObject::invokeMethod(m_postHermes, "jobFinished", Qt::QueuedConnection);
+    }
+
+protected:
+    virtual void process() = 0;
+    virtual void discard() = 0;
+
+private:
+    PostHermes *m_postHermes;
+    QSharedPointer<PostHermesJob> m_job;
+    QString m_name;
+};
+
+class PostHermesLinearizerTask : public PostHermesTask
+{
+public:
+    PostHermesLinearizerTask(PostHermes *postHermes, QSharedPointer<PostHermesJob> job, const QString &name,
+                             QSharedPointer<Hermes::Hermes2D::Views::Linearizer> *view, Hermes::Hermes2D::MeshFunctionSharedPtr<double> sln)
+        : PostHermesTask(postHermes, job, name), m_view(view), m_sln(sln) {}
+
+protected:
+    virtual void process() { (*m_view)->process_solution(m_sln, Hermes::Hermes2D::H2D_FN_VAL_0); }
+    virtual void discard() { m_view->clear(); }
+
+private:
+    QSharedPointer<Hermes::Hermes2D::Views::Linearizer> *m_view;
+    Hermes::Hermes2D::MeshFunctionSharedPtr<double> m_sln;
+};
+
+class PostHermesVectorizerTask : public PostHermesTask
+{
+public:
+    PostHermesVectorizerTask(PostHermes *postHermes, QSharedPointer<PostHermesJob> job, const QString &name,
+                             QSharedPointer<Hermes::Hermes2D::Views::Vectorizer> *view,
+                             Hermes::Hermes2D::MeshFunctionSharedPtr<double> slnX, Hermes::Hermes2D::MeshFunctionSharedPtr<double> slnY)
+        : PostHermesTask(postHermes, job, name), m_view(view), m_slnX(slnX), m_slnY(slnY) {}
+
+protected:
+    virtual void process()
+    {
+        Hermes::Hermes2D::MeshFunctionSharedPtr<double> slns[2] = { m_slnX, m_slnY };
+        int items[2] = { Hermes::Hermes2D::H2D_FN_VAL_0, Hermes::Hermes2D::H2D_FN_VAL_0 };
+
+        (*m_view)->process_solution(slns, items);
+    }
+    virtual void discard() { m_view->clear(); }
+
+private:
+    QSharedPointer<Hermes::Hermes2D::Views::Vectorizer> *m_view;
+    Hermes::Hermes2D::MeshFunctionSharedPtr<double> m_slnX;
+    Hermes::Hermes2D::MeshFunctionSharedPtr<double> m_slnY;
+};
+
+// mesh edges and triangles, the linearizer is used only in the thread
+class PostHermesMeshTask : public PostHermesTask
+{
+public:
+    PostHermesMeshTask(PostHermes *postHermes, QSharedPointer<PostHermesJob> job, const QString &name,
+                       QSharedPointer<PostHermesMeshView> *view, Hermes::Hermes2D::MeshFunctionSharedPtr<double> sln)
+        : PostHermesTask(postHermes, job, name), m_view(view), m_sln(sln) {}
+
+protected:
+    virtual void process()
+    {
+        Hermes::Hermes2D::Views::Linearizer linearizer(Hermes::Hermes2D::OpenGL);
+        linearizer.set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionFixed(0));
+        linearizer.process_solution(m_sln, Hermes::Hermes2D::H2D_FN_VAL_0);
+
+        QSharedPointer<PostHermesMeshView> view(new PostHermesMeshView());
+
+        view->edges.reserve(2 * linearizer.get_edge_count());
+        for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::edge_t>
+             it = linearizer.edges_begin(); !it.end; ++it)
+        {
+            Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::edge_t& edge = it.get();
+
+            view->edges.append(QVector2D(edge[0][0], edge[0][1]));
+            view->edges.append(QVector2D(edge[1][0], edge[1][1]));
+        }
+
+        for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
+             it = linearizer.triangles_begin(); !it.end; ++it)
+        {
+            Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
+
+            view->triangles.append(QVector2D(triangle[0][0], triangle[0][1]));
+            view->triangles.append(QVector2D(triangle[1][0], triangle[1][1]));
+            view->triangles.append(QVector2D(triangle[2][0], triangle[2][1]));
+        }
+
+        *m_view = view;
+    }
+    virtual void discard() { m_view->clear(); }
+
+private:
+    QSharedPointer<PostHermesMeshView> *m_view;
+    Hermes::Hermes2D::MeshFunctionSharedPtr<double> m_sln;
+};
+
+// triangles and labels of the polynomial order, the orderizer is used only in the thread
+class PostHermesOrderTask : public PostHermesTask
+{
+public:
+    PostHermesOrderTask(PostHermes *postHermes, QSharedPointer<PostHermesJob> job, const QString &name,
+                        QSharedPointer<PostHermesOrderView> *view, Hermes::Hermes2D::SpaceSharedPtr<double> space)
+        : PostHermesTask(postHermes, job, name), m_view(view), m_space(space) {}
+
+protected:
+    virtual void process()
+    {
+        Hermes::Hermes2D::Views::Orderizer orderizer;
+        orderizer.process_space(m_space);
+
+        QSharedPointer<PostHermesOrderView> view(new PostHermesOrderView());
+
+        double3* vert = orderizer.get_vertices();
+        int3* tris = orderizer.get_triangles();
+
+        view->triangles.reserve(3 * orderizer.get_num_triangles());
+        view->orders.reserve(orderizer.get_num_triangles());
+        for (int i = 0; i < orderizer.get_num_triangles(); i++)
+        {
+            int order = vert[tris[i][0]][2];
+
+            view->triangles.append(QVector2D(vert[tris[i][0]][0], vert[tris[i][0]][1]));
+            view->triangles.append(QVector2D(vert[tris[i][1]][0], vert[tris[i][1]][1]));
+            view->triangles.append(QVector2D(vert[tris[i][2]][0], vert[tris[i][2]][1]));
+            view->orders.append(order);
+
+            if (order < view->orderMin) view->orderMin = order;
+            if (order > view->orderMax) view->orderMax = order;
+        }
+
+        // labels
+        int* lvert;
+        char** ltext;
+        double2* lbox;
+        int nl = orderizer.get_labels(lvert, ltext, lbox);
+
+        for (int i = 0; i < nl; i++)
+        {
+            view->labelPositions.append(QVector2D(vert[lvert[i]][0], vert[lvert[i]][1]));
+            view->labels.append(QString(ltext[i]));
+        }
+
+        *m_view = view;
+    }
+    virtual void discard() { m_view->clear(); }
+
+private:
+    QSharedPointer<PostHermesOrderView> *m_view;
+    Hermes::Hermes2D::SpaceSharedPtr<double> m_space;
+};
+
 PostHermes::PostHermes() :
     m_activeViewField(NULL),
     m_activeTimeStep(NOT_FOUND_SO_FAR),
     m_activeAdaptivityStep(NOT_FOUND_SO_FAR),
     m_activeSolutionMode(SolutionMode_Undefined),
     m_isProcessed(false),
-    m_linInitialMeshView(NULL),
-    m_linSolutionMeshView(NULL),
-    m_orderView(NULL),
-    m_linContourView(NULL),
-    m_linScalarView(NULL),
-    m_vecVectorView(NULL)
+    m_meshViewCache(MESH_VIEW_CACHE_SIZE),
+    m_orderViewCache(MESH_VIEW_CACHE_SIZE),
+    m_linearizerCache(LINEARIZER_CACHE_SIZE),
+    m_vectorizerCache(LINEARIZER_CACHE_SIZE),
+    m_contourViewVersion(0),
+    m_scalarViewVersion(0),
+    m_vectorViewVersion(0),
+    m_dirty(ViewType_All),
+    m_refreshScheduled(false),
+    m_refreshViews(0),
+    m_clearingSolution(false),
+    m_viewportPixelSize(0.0),
+    m_linearizerLevel(LINEARIZER_DEFAULT_LEVEL)
 {
     connect(Agros2D::scene(), SIGNAL(cleared()), this, SLOT(clear()));
+    connect(Agros2D::problem(), SIGNAL(aboutToClearSolution()), this, SLOT(problemAboutToClearSolution()), Qt::DirectConnection);
     connect(Agros2D::problem(), SIGNAL(clearedSolution()), this, SLOT(clearView()));
     connect(Agros2D::problem(), SIGNAL(fieldsChanged()), this, SLOT(clear()));
 
@@ -76,95 +339,93 @@ PostHermes::PostHermes() :
 PostHermes::~PostHermes()
 {
     clear();
+    m_threadPool.waitForDone();
 }
 
 void PostHermes::processInitialMesh()
 {
+    if (!(m_job->views & ViewType_InitialMesh))
+        return;
+
     if (Agros2D::problem()->isMeshed() && (m_activeViewField) && (Agros2D::problem()->setting()->value(ProblemSetting::View_ShowInitialMeshView).toBool()))
     {
-        Agros2D::log()->printMessage(tr("Mesh View"), tr("Initial mesh with %1 elements").arg(m_activeViewField->initialMesh()->get_num_active_elements()));
-
-        if (m_linInitialMeshView)
-            delete m_linInitialMeshView;
-        m_linInitialMeshView = new Hermes::Hermes2D::Views::Linearizer(Hermes::Hermes2D::OpenGL);
-
-        // init linearizer for initial mesh
-        try
+        // previously generated
+        if (QSharedPointer<PostHermesMeshView> *view = m_meshViewCache.object(m_job->keys[ViewType_InitialMesh]))
         {
-            m_linInitialMeshView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionFixed(0));
-            m_linInitialMeshView->process_solution(Hermes::Hermes2D::MeshFunctionSharedPtr<double>(new Hermes::Hermes2D::ZeroSolution<double>(m_activeViewField->initialMesh())));
+            m_job->initialMeshView = *view;
+            return;
         }
-        catch (Hermes::Exceptions::Exception& e)
-        {
-            delete m_linInitialMeshView;
-            m_linInitialMeshView = NULL;
 
-            Agros2D::log()->printError("Mesh View", QObject::tr("Linearizer (initial mesh) processing failed: %1").arg(e.info().c_str()));
-        }
+        Agros2D::log()->printMessage(tr("Mesh View"), tr("Initial mesh with %1 elements").arg(m_activeViewField->initialMesh()->get_num_active_elements()));
+
+        m_tasks.append(new PostHermesMeshTask(this, m_job, tr("Linearizer (initial mesh)"), &m_job->initialMeshView,
+                                              Hermes::Hermes2D::MeshFunctionSharedPtr<double>(new Hermes::Hermes2D::ZeroSolution<double>(m_activeViewField->initialMesh()))));
     }
 }
 
 void PostHermes::processSolutionMesh()
 {
+    if (!(m_job->views & ViewType_SolutionMesh))
+        return;
+
     if ((Agros2D::problem()->isSolved()) && (m_activeViewField) && (Agros2D::problem()->setting()->value(ProblemSetting::View_ShowSolutionMeshView).toBool()))
     {
+        // previously generated
+        if (QSharedPointer<PostHermesMeshView> *view = m_meshViewCache.object(m_job->keys[ViewType_SolutionMesh]))
+        {
+            m_job->solutionMeshView = *view;
+            return;
+        }
+
         int comp = Agros2D::problem()->setting()->value(ProblemSetting::View_OrderComponent).toInt() - 1;
 
         Agros2D::log()->printMessage(tr("Mesh View"), tr("Solution mesh with %1 elements").arg(activeMultiSolutionArray().solutions().at(comp)->get_mesh()->get_num_active_elements()));
 
-        // init linearizer for solution mesh
         const Hermes::Hermes2D::MeshSharedPtr mesh = activeMultiSolutionArray().solutions().at(comp)->get_mesh();
 
-        if (m_linSolutionMeshView)
-            delete m_linSolutionMeshView;
-        m_linSolutionMeshView = new Hermes::Hermes2D::Views::Linearizer(Hermes::Hermes2D::OpenGL);
-
-        try
-        {
-            m_linSolutionMeshView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionFixed(0));
-            m_linSolutionMeshView->process_solution(Hermes::Hermes2D::MeshFunctionSharedPtr<double>(new Hermes::Hermes2D::ZeroSolution<double>(mesh)));
-        }
-        catch (Hermes::Exceptions::Exception& e)
-        {
-            delete m_linSolutionMeshView;
-            m_linSolutionMeshView = NULL;
-
-            Agros2D::log()->printError("Mesh View", QObject::tr("Linearizer (solution mesh) processing failed: %1").arg(e.info().c_str()));
-        }
+        m_tasks.append(new PostHermesMeshTask(this, m_job, tr("Linearizer (solution mesh)"), &m_job->solutionMeshView,
+                                              Hermes::Hermes2D::MeshFunctionSharedPtr<double>(new Hermes::Hermes2D::ZeroSolution<double>(mesh))));
     }
 }
 
 void PostHermes::processOrder()
 {
-    // init linearizer for order view
+    if (!(m_job->views & ViewType_Order))
+        return;
+
+    // init orderizer for order view
     if ((Agros2D::problem()->isSolved()) && (m_activeViewField) && (Agros2D::problem()->setting()->value(ProblemSetting::View_ShowOrderView).toBool()))
     {
+        // previously generated
+        if (QSharedPointer<PostHermesOrderView> *view = m_orderViewCache.object(m_job->keys[ViewType_Order]))
+        {
+            m_job->orderView = *view;
+            return;
+        }
+
         Agros2D::log()->printMessage(tr("Mesh View"), tr("Polynomial order"));
 
         int comp = Agros2D::problem()->setting()->value(ProblemSetting::View_OrderComponent).toInt() - 1;
 
-        if (m_orderView)
-            delete m_orderView;
-        m_orderView = new Hermes::Hermes2D::Views::Orderizer();
-
-        try
-        {
-            m_orderView->process_space(activeMultiSolutionArray().spaces().at(comp));
-        }
-        catch (Hermes::Exceptions::Exception& e)
-        {
-            delete m_orderView;
-            m_orderView = NULL;
-
-            Agros2D::log()->printError("Order View", QObject::tr("Orderizer processing failed: %1").arg(e.info().c_str()));
-        }
+        m_tasks.append(new PostHermesOrderTask(this, m_job, tr("Orderizer"), &m_job->orderView,
+                                               activeMultiSolutionArray().spaces().at(comp)));
     }
 }
 
 void PostHermes::processRangeContour()
 {
+    if (!(m_job->views & ViewType_Contour))
+        return;
+
     if (Agros2D::problem()->isSolved() && m_activeViewField && (Agros2D::problem()->setting()->value(ProblemSetting::View_ShowContourView).toBool()))
     {
+        // previously linearized
+        if (QSharedPointer<Hermes::Hermes2D::Views::Linearizer> *view = m_linearizerCache.object(m_job->keys[ViewType_Contour]))
+        {
+            m_job->linContourView = *view;
+            return;
+        }
+
         bool contains = false;
         foreach (Module::LocalVariable variable, m_activeViewField->viewScalarVariables())
         {
@@ -189,10 +450,7 @@ void PostHermes::processRangeContour()
                                               PhysicFieldVariableComp_Magnitude);
 
         // new linearizer
-        if (m_linContourView)
-            delete m_linContourView;
-        m_linContourView = new Hermes::Hermes2D::Views::Linearizer(Hermes::Hermes2D::OpenGL);
-
+        m_job->linContourView = QSharedPointer<Hermes::Hermes2D::Views::Linearizer>(new Hermes::Hermes2D::Views::Linearizer(Hermes::Hermes2D::OpenGL));
 
         // deformed shape
         if (m_activeViewField->hasDeformableShape() && Agros2D::problem()->setting()->value(ProblemSetting::View_DeformContour).toBool())
@@ -205,40 +463,41 @@ void PostHermes::processRangeContour()
                 RectPoint rect = Agros2D::scene()->boundingBox();
                 double dmult = qMax(rect.width(), rect.height()) / filter->get_approx_max_value() / 15.0;
 
-                m_linContourView->set_displacement(activeMultiSolutionArray().solutions().at(0),
-                                                  activeMultiSolutionArray().solutions().at(1),
-                                                  dmult);
+                m_job->linContourView->set_displacement(activeMultiSolutionArray().solutions().at(0),
+                                                        activeMultiSolutionArray().solutions().at(1),
+                                                        dmult);
             }
             delete filter;
         }
         else
         {
-            m_linContourView->set_displacement(NULL, NULL);
+            m_job->linContourView->set_displacement(NULL, NULL);
         }
 
-        // process solution.
-        try
-        {
-            m_linContourView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionFixed(1));
-            // m_linContourView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionAdaptive(Hermes::Hermes2D::Views::HERMES_EPS_VERYHIGH));
-            m_linContourView->process_solution(slnContourView, Hermes::Hermes2D::H2D_FN_VAL_0);
-        }
-        catch (Hermes::Exceptions::Exception& e)
-        {
-            delete m_linContourView;
-            m_linContourView = NULL;
+        // process solution
+        m_job->linContourView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionFixed(m_linearizerLevel));
+        // m_job->linContourView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionAdaptive(Hermes::Hermes2D::Views::HERMES_EPS_VERYHIGH));
 
-            Agros2D::log()->printError("Mesh View", QObject::tr("Linearizer (contour view) processing failed: %1").arg(e.info().c_str()));
-        }
+        m_tasks.append(new PostHermesLinearizerTask(this, m_job, tr("Linearizer (contour view)"), &m_job->linContourView, slnContourView));
     }
 }
 
 void PostHermes::processRangeScalar()
 {
+    if (!(m_job->views & ViewType_Scalar))
+        return;
+
     if ((Agros2D::problem()->isSolved()) && (m_activeViewField)
             && ((Agros2D::problem()->setting()->value(ProblemSetting::View_ShowScalarView).toBool())
                 || (((SceneViewPost3DMode) Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DMode).toInt()) == SceneViewPost3DMode_ScalarView3D)))
     {
+        // previously linearized
+        if (QSharedPointer<Hermes::Hermes2D::Views::Linearizer> *view = m_linearizerCache.object(m_job->keys[ViewType_Scalar]))
+        {
+            m_job->linScalarView = *view;
+            return;
+        }
+
         bool contains = false;
         foreach (Module::LocalVariable variable, m_activeViewField->viewScalarVariables())
         {
@@ -255,9 +514,7 @@ void PostHermes::processRangeScalar()
                                                                                          (PhysicFieldVariableComp) Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarVariableComp).toInt());
 
         // new linearizer
-        if (m_linScalarView)
-            delete m_linScalarView;
-        m_linScalarView = new Hermes::Hermes2D::Views::Linearizer(Hermes::Hermes2D::OpenGL);
+        m_job->linScalarView = QSharedPointer<Hermes::Hermes2D::Views::Linearizer>(new Hermes::Hermes2D::Views::Linearizer(Hermes::Hermes2D::OpenGL));
 
         // deformed shape
         if (m_activeViewField->hasDeformableShape() && Agros2D::problem()->setting()->value(ProblemSetting::View_DeformScalar).toBool())
@@ -270,63 +527,39 @@ void PostHermes::processRangeScalar()
                 RectPoint rect = Agros2D::scene()->boundingBox();
                 double dmult = qMax(rect.width(), rect.height()) / filter->get_approx_max_value() / 15.0;
 
-                m_linScalarView->set_displacement(activeMultiSolutionArray().solutions().at(0),
-                                                  activeMultiSolutionArray().solutions().at(1),
-                                                  dmult);
+                m_job->linScalarView->set_displacement(activeMultiSolutionArray().solutions().at(0),
+                                                       activeMultiSolutionArray().solutions().at(1),
+                                                       dmult);
             }
             delete filter;
         }
         else
         {
-            m_linScalarView->set_displacement(NULL, NULL);
+            m_job->linScalarView->set_displacement(NULL, NULL);
         }
 
         // process solution
-        try
-        {
-            /*
-            QTime time;
-
-            time.start();
-            m_linScalarView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionAdaptive(Hermes::Hermes2D::Views::HERMES_EPS_VERYHIGH));
-            m_linScalarView->process_solution(slnScalarView, Hermes::Hermes2D::H2D_FN_VAL_0);
-            qDebug() << "LinearizerCriterionAdaptive(Hermes::Hermes2D::Views::HERMES_EPS_VERYHIGH)" << time.elapsed();
-
-            time.start();
-            m_linScalarView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionAdaptive(Hermes::Hermes2D::Views::HERMES_EPS_HIGH));
-            m_linScalarView->process_solution(slnScalarView, Hermes::Hermes2D::H2D_FN_VAL_0);
-            qDebug() << "LinearizerCriterionAdaptive(Hermes::Hermes2D::Views::HERMES_EPS_HIGH)" << time.elapsed();
-
-            time.start();
-            m_linScalarView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionFixed(2));
-            m_linScalarView->process_solution(slnScalarView, Hermes::Hermes2D::H2D_FN_VAL_0);
-            qDebug() << "LinearizerCriterionFixed(2)" << time.elapsed();
-            */
-            // time.start();
-            m_linScalarView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionFixed(1));
-            m_linScalarView->process_solution(slnScalarView, Hermes::Hermes2D::H2D_FN_VAL_0);
-            // qDebug() << "LinearizerCriterionFixed(1)" << time.elapsed();
-
-            if (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeAuto).toBool())
-            {
-                Agros2D::problem()->setting()->setValue(ProblemSetting::View_ScalarRangeMin, m_linScalarView->get_min_value());
-                Agros2D::problem()->setting()->setValue(ProblemSetting::View_ScalarRangeMax, m_linScalarView->get_max_value());
-            }
-        }
-        catch (Hermes::Exceptions::Exception &e)
-        {
-            delete m_linScalarView;
-            m_linScalarView = NULL;
+        m_job->linScalarView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionFixed(m_linearizerLevel));
+        // m_job->linScalarView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionAdaptive(Hermes::Hermes2D::Views::HERMES_EPS_VERYHIGH));
 
-            Agros2D::log()->printError("Mesh View", QObject::tr("Linearizer (scalar view) processing failed: %1").arg(e.info().c_str()));
-        }
+        m_tasks.append(new PostHermesLinearizerTask(this, m_job, tr("Linearizer (scalar view)"), &m_job->linScalarView, slnScalarView));
     }
 }
 
 void PostHermes::processRangeVector()
 {
+    if (!(m_job->views & ViewType_Vector))
+        return;
+
     if ((Agros2D::problem()->isSolved()) && (m_activeViewField) && (Agros2D::problem()->setting()->value(ProblemSetting::View_ShowVectorView).toBool()))
     {
+        // previously vectorized
+        if (QSharedPointer<Hermes::Hermes2D::Views::Vectorizer> *view = m_vectorizerCache.object(m_job->keys[ViewType_Vector]))
+        {
+            m_job->vecVectorView = *view;
+            return;
+        }
+
         bool contains = false;
         foreach (Module::LocalVariable variable, m_activeViewField->viewVectorVariables())
         {
@@ -346,9 +579,7 @@ void PostHermes::processRangeVector()
                                                                                           PhysicFieldVariableComp_Y);
 
         // new vectorizer
-        if (m_vecVectorView)
-            delete m_vecVectorView;
-        m_vecVectorView = new Hermes::Hermes2D::Views::Vectorizer(Hermes::Hermes2D::OpenGL);
+        m_job->vecVectorView = QSharedPointer<Hermes::Hermes2D::Views::Vectorizer>(new Hermes::Hermes2D::Views::Vectorizer(Hermes::Hermes2D::OpenGL));
 
         // deformed shape
         if (m_activeViewField->hasDeformableShape() && Agros2D::problem()->setting()->value(ProblemSetting::View_DeformVector).toBool())
@@ -360,79 +591,304 @@ void PostHermes::processRangeVector()
                 RectPoint rect = Agros2D::scene()->boundingBox();
                 double dmult = qMax(rect.width(), rect.height()) / filter->get_approx_max_value() / 15.0;
 
-                m_vecVectorView->set_displacement(activeMultiSolutionArray().solutions().at(0),
-                                                 activeMultiSolutionArray().solutions().at(1),
-                                                 dmult);
+                m_job->vecVectorView->set_displacement(activeMultiSolutionArray().solutions().at(0),
+                                                       activeMultiSolutionArray().solutions().at(1),
+                                                       dmult);
             }
             delete filter;
         }
         else
         {
-            m_vecVectorView->set_displacement(NULL, NULL);
+            m_job->vecVectorView->set_displacement(NULL, NULL);
         }
 
         // process solution
-        Hermes::Hermes2D::MeshFunctionSharedPtr<double> slns[2] = { slnVectorXView, slnVectorYView };
-        int items[2] = { Hermes::Hermes2D::H2D_FN_VAL_0, Hermes::Hermes2D::H2D_FN_VAL_0 };
-
-        try
-        {
-            // m_vecVectorView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionAdaptive(Hermes::Hermes2D::Views::HERMES_EPS_VERYHIGH));
-            m_vecVectorView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionFixed(1));
-            m_vecVectorView->process_solution(slns, items);
-        }
-        catch (Hermes::Exceptions::Exception &e)
-        {
-            delete m_vecVectorView;
-            m_vecVectorView = NULL;
+        m_job->vecVectorView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionFixed(1));
+        // m_job->vecVectorView->set_criterion(Hermes::Hermes2D::Views::LinearizerCriterionAdaptive(Hermes::Hermes2D::Views::HERMES_EPS_VERYHIGH));
 
-            Agros2D::log()->printError("Mesh View", QObject::tr("Vectorizer processing failed: %1").arg(e.info().c_str()));
-        }
+        m_tasks.append(new PostHermesVectorizerTask(this, m_job, tr("Vectorizer"), &m_job->vecVectorView, slnVectorXView, slnVectorYView));
     }
 }
 
+void PostHermes::stopProcessing()
+{
+    cancel();
+    cancelPrefetch();
+
+    // running tasks use meshes, markers and solutions of the problem
+    m_threadPool.waitForDone();
+}
+
+void PostHermes::problemAboutToClearSolution()
+{
+    // solution is cleared also by the calculation thread, state of the views is owned by the gui thread
+    if (QThread::currentThread() == thread())
+        clearingSolution();
+    else
+        QMetaObject::invokeMethod(this, "clearingSolution", Qt::BlockingQueuedConnection);
+}
+
+void PostHermes::clearingSolution()
+{
+    // no job is started until the problem is meshed or solved again
+    m_clearingSolution = true;
+    stopProcessing();
+}
+
 void PostHermes::clearView()
 {
+    stopProcessing();
+
     m_isProcessed = false;
 
-    if (m_linInitialMeshView)
-    {
-        delete m_linInitialMeshView;
-        m_linInitialMeshView = NULL;
-    }
-    if (m_linSolutionMeshView)
+    m_initialMeshView.clear();
+    m_solutionMeshView.clear();
+    m_orderView.clear();
+
+    // solutions are going to change
+    m_meshViewCache.clear();
+    m_orderViewCache.clear();
+    m_linearizerCache.clear();
+    m_vectorizerCache.clear();
+
+    m_linContourView.clear();
+    m_linScalarView.clear();
+    m_vecVectorView.clear();
+
+    m_viewKeys.clear();
+    m_dirty = ViewType_All;
+}
+
+void PostHermes::invalidate(int views)
+{
+    m_dirty |= views;
+}
+
+void PostHermes::refreshLater(int views)
+{
+    // paint requests are coalesced into one processing
+    if (!(m_dirty & views) || isProcessing())
+        return;
+
+    m_refreshViews |= views;
+    if (m_refreshScheduled)
+        return;
+
+    m_refreshScheduled = true;
+    QMetaObject::invokeMethod(this, "refreshDirty", Qt::QueuedConnection);
+}
+
+void PostHermes::refreshDirty()
+{
+    int views = m_refreshViews;
+
+    m_refreshScheduled = false;
+    m_refreshViews = 0;
+
+    if (m_dirty & views)
+        processDirty(views);
+}
+
+void PostHermes::refresh()
+{
+    // settings could be changed anywhere, inputs of all views are checked
+    invalidate();
+
+    if (!processDirty())
     {
-        delete m_linSolutionMeshView;
-        m_linSolutionMeshView = NULL;
+        // nothing to recompute, views are repainted
+        emit processed();
+        return;
     }
-    if (m_orderView)
+
+    // wait for the result (scripting, video)
+    m_threadPool.waitForDone();
+    if (m_job)
+        publishJob();
+}
+
+void PostHermes::refreshAsync()
+{
+    invalidate();
+
+    // mesh views are requested by the paint of the mesh tab
+    if (!processDirty(ViewType_All & ~ViewType_Mesh))
+        emit processed();
+}
+
+void PostHermes::setViewport(const RectPoint &viewport, double pixelSize)
+{
+    m_viewport = viewport;
+    m_viewportPixelSize = pixelSize;
+
+    // views are linearized again only if the level changes
+    invalidate(ViewType_Contour | ViewType_Scalar);
+}
+
+int PostHermes::computeLinearizerLevel()
+{
+    if ((m_viewportPixelSize <= 0.0) || !Agros2D::problem()->isSolved() || !m_activeViewField)
+        return LINEARIZER_DEFAULT_LEVEL;
+
+    // sizes of the elements intersecting the viewport
+    QVector<double> sizes;
+
+    Hermes::Hermes2D::MeshSharedPtr mesh = activeMultiSolutionArray().solutions().at(0)->get_mesh();
+    Hermes::Hermes2D::Element *element;
+    for_all_active_elements(element, mesh)
     {
-        delete m_orderView;
-        m_orderView = NULL;
+        Point p1(element->vn[0]->x, element->vn[0]->y);
+        Point p2 = p1;
+        for (int i = 1; i < element->get_nvert(); i++)
+        {
+            p1.x = qMin(p1.x, element->vn[i]->x);
+            p1.y = qMin(p1.y, element->vn[i]->y);
+            p2.x = qMax(p2.x, element->vn[i]->x);
+            p2.y = qMax(p2.y, element->vn[i]->y);
+        }
+
+        if ((p2.x < m_viewport.start.x) || (p1.x > m_viewport.end.x)
+                || (p2.y < m_viewport.start.y) || (p1.y > m_viewport.end.y))
+            continue;
+
+        sizes.append(qMax(p2.x - p1.x, p2.y - p1.y));
     }
 
-    if (m_linContourView)
+    if (sizes.isEmpty())
+        return 0;
+
+    // typical element, each level halves the size of the triangles
+    std::nth_element(sizes.begin(), sizes.begin() + sizes.size() / 2, sizes.end());
+    double pixels = sizes[sizes.size() / 2] / m_viewportPixelSize;
+
+    double triangles = mesh->get_num_active_elements();
+
+    int level = 0;
+    while ((pixels > LINEARIZER_TRIANGLE_PIXELS) && (level < LINEARIZER_MAX_LEVEL)
+           && (4.0 * triangles <= LINEARIZER_MAX_TRIANGLES))
     {
-        delete m_linContourView;
-        m_linContourView = NULL;
+        triangles *= 4.0;
+        pixels /= 2.0;
+        level++;
     }
-    if (m_linScalarView)
+
+    return level;
+}
+
+QString PostHermes::viewKey(ViewType view) const
+{
+    if (!m_activeViewField)
+        return QString();
+
+    QStringList key;
+    key << QString::number(view)
+        << m_activeViewField->fieldId()
+        << QString::number(Agros2D::problem()->isMeshed());
+
+    // solution (initial mesh does not depend on it)
+    if (view != ViewType_InitialMesh)
+        key << QString::number(m_activeTimeStep)
+            << QString::number(m_activeAdaptivityStep)
+            << QString::number(m_activeSolutionMode)
+            << QString::number(Agros2D::solutionStore()->fieldRevision(m_activeViewField))
+            << QString::number(Agros2D::problem()->isSolved());
+
+    // settings of the view
+    switch (view)
     {
-        delete m_linScalarView;
-        m_linScalarView = NULL;
+    case ViewType_InitialMesh:
+        key << Agros2D::problem()->setting()->value(ProblemSetting::View_ShowInitialMeshView).toString();
+        break;
+    case ViewType_SolutionMesh:
+        key << Agros2D::problem()->setting()->value(ProblemSetting::View_ShowSolutionMeshView).toString()
+            << Agros2D::problem()->setting()->value(ProblemSetting::View_OrderComponent).toString();
+        break;
+    case ViewType_Order:
+        key << Agros2D::problem()->setting()->value(ProblemSetting::View_ShowOrderView).toString()
+            << Agros2D::problem()->setting()->value(ProblemSetting::View_OrderComponent).toString();
+        break;
+    case ViewType_Contour:
+        key << QString::number(m_linearizerLevel)
+            << Agros2D::problem()->setting()->value(ProblemSetting::View_ShowContourView).toString()
+            << Agros2D::problem()->setting()->value(ProblemSetting::View_ContourVariable).toString()
+            << Agros2D::problem()->setting()->value(ProblemSetting::View_DeformContour).toString();
+        break;
+    case ViewType_Scalar:
+        key << QString::number(m_linearizerLevel)
+            << Agros2D::problem()->setting()->value(ProblemSetting::View_ShowScalarView).toString()
+            << Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DMode).toString()
+            << Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarVariable).toString()
+            << Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarVariableComp).toString()
+            << Agros2D::problem()->setting()->value(ProblemSetting::View_DeformScalar).toString();
+        break;
+    case ViewType_Vector:
+        key << Agros2D::problem()->setting()->value(ProblemSetting::View_ShowVectorView).toString()
+            << Agros2D::problem()->setting()->value(ProblemSetting::View_VectorVariable).toString()
+            << Agros2D::problem()->setting()->value(ProblemSetting::View_DeformVector).toString();
+        break;
+    default:
+        break;
     }
 
-    if (m_vecVectorView)
+    return key.join("|");
+}
+
+void PostHermes::collectViews(PostHermesJob *job, int views) const
+{
+    for (int view = ViewType_InitialMesh; view < ViewType_All; view <<= 1)
     {
-        delete m_vecVectorView;
-        m_vecVectorView = NULL;
+        if (!(views & view))
+            continue;
+
+        QString key = viewKey((ViewType) view);
+        if (m_viewKeys.contains((ViewType) view) && m_viewKeys[(ViewType) view] == key)
+            continue;
+
+        job->views |= view;
+        job->keys[(ViewType) view] = key;
     }
 }
 
-void PostHermes::refresh()
+bool PostHermes::processDirty(int views)
 {
+    // inputs of the views are released (views stay dirty)
+    if (m_clearingSolution)
+        return false;
+
+    // drop the previous request (its views stay dirty)
+    cancel();
+
+    m_job = QSharedPointer<PostHermesJob>(new PostHermesJob());
+    m_tasks.clear();
+
+    if (m_dirty & views & (ViewType_Contour | ViewType_Scalar))
+        m_linearizerLevel = computeLinearizerLevel();
+
+    // views with unchanged inputs are kept, views not requested stay dirty
+    collectViews(m_job.data(), m_dirty & views);
+    m_dirty &= ~views;
+
+    if (!m_job->views)
+    {
+        m_job.clear();
+        return false;
+    }
+
     Agros2D::problem()->setIsPostprocessingRunning();
-    clearView();
+
+    // views of this step were prefetched
+    if (m_prefetchJob && m_prefetchJob->views == m_job->views && m_prefetchJob->keys == m_job->keys)
+    {
+        m_job = m_prefetchJob;
+        m_prefetchJob.clear();
+
+        // otherwise published by its last task
+        if (m_job->isFinished())
+            publishJob();
+
+        return true;
+    }
+    cancelPrefetch();
 
     if (Agros2D::problem()->isMeshed())
         processMeshed();
@@ -440,6 +896,207 @@ void PostHermes::refresh()
     if (Agros2D::problem()->isSolved())
         processSolved();
 
+    if (m_tasks.isEmpty())
+    {
+        publishJob();
+    }
+    else
+    {
+        foreach (PostHermesTask *task, m_tasks)
+            m_threadPool.start(task);
+        m_tasks.clear();
+    }
+
+    return true;
+}
+
+void PostHermes::cancel()
+{
+    if (m_job)
+    {
+        m_dirty |= m_job->views;
+
+        m_job->cancel();
+        m_job.clear();
+
+        Agros2D::problem()->setIsPostprocessingRunning(false);
+    }
+}
+
+void PostHermes::cancelPrefetch()
+{
+    if (m_prefetchJob)
+    {
+        m_prefetchJob->cancel();
+        m_prefetchJob.clear();
+    }
+}
+
+bool PostHermes::canPrefetch() const
+{
+    if (!Agros2D::problem()->isSolved() || !m_activeViewField)
+        return false;
+
+    // time functions are global, values of the active step would be overwritten
+    // (any field, coupled sources and postprocessor use the same values)
+    if (Agros2D::problem()->isTransient())
+    {
+        foreach (FieldInfo *fieldInfo, Agros2D::problem()->fieldInfos())
+        {
+            foreach (SceneMaterial *material, Agros2D::scene()->materials->items())
+            {
+                if (material->fieldInfo() != fieldInfo)
+                    continue;
+
+                foreach (Module::MaterialTypeVariable variable, fieldInfo->materialTypeVariables())
+                    if (variable.isTimeDep() && material->value(variable.id())->isTimeDependent())
+                        return false;
+            }
+
+            foreach (SceneBoundary *boundary, Agros2D::scene()->boundaries->items())
+            {
+                if (boundary->fieldInfo() != fieldInfo || boundary->isNone())
+                    continue;
+
+                Module::BoundaryType boundaryType = fieldInfo->boundaryType(boundary->type());
+                foreach (Module::BoundaryTypeVariable variable, boundaryType.variables())
+                    if (variable.isTimeDep() && boundary->value(variable.id())->isTimeDependent())
+                        return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void PostHermes::prefetch(int timeStep, int adaptivityStep)
+{
+    // views of the active step are processed first
+    if (m_job || m_clearingSolution || !canPrefetch())
+        return;
+
+    cancelPrefetch();
+
+    int activeTimeStep = m_activeTimeStep;
+    int activeAdaptivityStep = m_activeAdaptivityStep;
+    int linearizerLevel = m_linearizerLevel;
+
+    // views are prepared with the steps of the frame, the active steps are restored
+    m_activeTimeStep = timeStep;
+    m_activeAdaptivityStep = adaptivityStep;
+
+    m_job = QSharedPointer<PostHermesJob>(new PostHermesJob());
+    m_tasks.clear();
+
+    m_linearizerLevel = computeLinearizerLevel();
+    collectViews(m_job.data(), ViewType_All);
+
+    if (m_job->views)
+    {
+        if (Agros2D::problem()->isMeshed())
+            processMeshed();
+
+        if (Agros2D::problem()->isSolved())
+            processSolved();
+
+        foreach (PostHermesTask *task, m_tasks)
+            m_threadPool.start(task);
+        m_tasks.clear();
+
+        m_prefetchJob = m_job;
+    }
+    m_job.clear();
+
+    m_activeTimeStep = activeTimeStep;
+    m_activeAdaptivityStep = activeAdaptivityStep;
+    m_linearizerLevel = linearizerLevel;
+
+    // time functions of the active step
+    if (Agros2D::problem()->isTransient())
+        Module::updateTimeFunctions(Agros2D::problem()->timeStepToTotalTime(m_activeTimeStep));
+}
+
+void PostHermes::jobFinished()
+{
+    // stale jobs are released by their tasks
+    if (m_job && m_job->isFinished())
+        publishJob();
+}
+
+void PostHermes::publishJob()
+{
+    QSharedPointer<PostHermesJob> job = m_job;
+    m_job.clear();
+
+    foreach (QString error, job->errors())
+        Agros2D::log()->printError(tr("Post View"), error);
+
+    // replace processed views at once, other views are kept
+    if (job->views & ViewType_InitialMesh)
+    {
+        m_initialMeshView = job->initialMeshView;
+
+        if (m_initialMeshView)
+            m_meshViewCache.insert(job->keys[ViewType_InitialMesh], new QSharedPointer<PostHermesMeshView>(m_initialMeshView), m_initialMeshView->cost());
+    }
+    if (job->views & ViewType_SolutionMesh)
+    {
+        m_solutionMeshView = job->solutionMeshView;
+
+        if (m_solutionMeshView)
+            m_meshViewCache.insert(job->keys[ViewType_SolutionMesh], new QSharedPointer<PostHermesMeshView>(m_solutionMeshView), m_solutionMeshView->cost());
+    }
+    if (job->views & ViewType_Order)
+    {
+        m_orderView = job->orderView;
+
+        if (m_orderView)
+            m_orderViewCache.insert(job->keys[ViewType_Order], new QSharedPointer<PostHermesOrderView>(m_orderView), m_orderView->cost());
+    }
+    if (job->views & ViewType_Contour)
+    {
+        m_linContourView = job->linContourView;
+
+        if (m_linContourView)
+        {
+            m_linearizerCache.insert(job->keys[ViewType_Contour], new QSharedPointer<Hermes::Hermes2D::Views::Linearizer>(m_linContourView), linearizerCost(m_linContourView.data()));
+            m_contourViewVersion++;
+        }
+    }
+    if (job->views & ViewType_Scalar)
+    {
+        m_linScalarView = job->linScalarView;
+
+        if (m_linScalarView)
+        {
+            m_linearizerCache.insert(job->keys[ViewType_Scalar], new QSharedPointer<Hermes::Hermes2D::Views::Linearizer>(m_linScalarView), linearizerCost(m_linScalarView.data()));
+            m_scalarViewVersion++;
+        }
+    }
+    if (job->views & ViewType_Vector)
+    {
+        m_vecVectorView = job->vecVectorView;
+
+        if (m_vecVectorView)
+        {
+            m_vectorizerCache.insert(job->keys[ViewType_Vector], new QSharedPointer<Hermes::Hermes2D::Views::Vectorizer>(m_vecVectorView), linearizerCost(m_vecVectorView.data()));
+            m_vectorViewVersion++;
+        }
+    }
+
+    // failed views are processed again
+    if (job->errors().isEmpty())
+    {
+        foreach (ViewType view, job->keys.keys())
+            m_viewKeys[view] = job->keys[view];
+    }
+
+    if (m_linScalarView && Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeAuto).toBool())
+    {
+        Agros2D::problem()->setting()->setValue(ProblemSetting::View_ScalarRangeMin, m_linScalarView->get_min_value());
+        Agros2D::problem()->setting()->setValue(ProblemSetting::View_ScalarRangeMax, m_linScalarView->get_max_value());
+    }
+
     m_isProcessed = true;
     emit processed();
     Agros2D::problem()->setIsPostprocessingRunning(false);
@@ -457,6 +1114,16 @@ void PostHermes::clear()
 
 void PostHermes::problemMeshed()
 {
+    // new mesh, all views are processed again
+    m_clearingSolution = false;
+    m_viewKeys.clear();
+    m_meshViewCache.clear();
+    m_orderViewCache.clear();
+    m_linearizerCache.clear();
+    m_vectorizerCache.clear();
+    cancelPrefetch();
+    invalidate();
+
     if (!m_activeViewField)
     {
         setActiveViewField(Agros2D::problem()->fieldInfos().begin().value());
@@ -474,6 +1141,10 @@ void PostHermes::problemMeshed()
 
 void PostHermes::problemSolved()
 {
+    m_clearingSolution = false;
+    m_viewKeys.clear();
+    invalidate();
+
     if (!m_activeViewField)
     {
         setActiveViewField(Agros2D::problem()->fieldInfos().begin().value());
@@ -557,6 +1228,7 @@ void PostHermes::setActiveViewField(FieldInfo* fieldInfo)
 
     // set new field
     m_activeViewField = fieldInfo;
+    invalidate();
 
     // check for different field
     if (previousActiveViewField != fieldInfo)
@@ -608,11 +1280,15 @@ void PostHermes::setActiveTimeStep(int ts)
 {
     m_activeTimeStep = ts;
     Agros2D::problem()->setActualTimePostprocessing(Agros2D::problem()->timeStepToTime(ts));
+
+    invalidate();
 }
 
 void PostHermes::setActiveAdaptivityStep(int as)
 {
     m_activeAdaptivityStep = as;
+
+    invalidate();
 }
 
 MultiArray<double> PostHermes::activeMultiSolutionArray()
@@ -29,29 +29,95 @@ template <typename Scalar> class MultiArray;
 class ParticleTracing;
 class FieldInfo;
 
+class PostHermesJob;
+class PostHermesTask;
+
+// key for merging of shared linearizer vertices
+struct ScalarVertexKey
+{
+    float x;
+    float y;
+    float value;
+
+    inline bool operator==(const ScalarVertexKey &other) const { return x == other.x && y == other.y && value == other.value; }
+};
+
+inline uint qHash(const ScalarVertexKey &key)
+{
+    // -0.0 and 0.0 are equal, their bits have to hash the same
+    float v[3] = { key.x == 0.0f ? 0.0f : key.x,
+                   key.y == 0.0f ? 0.0f : key.y,
+                   key.value == 0.0f ? 0.0f : key.value };
+
+    quint32 h[3];
+    memcpy(h, v, sizeof(h));
+    return h[0] ^ (h[1] * 31u) ^ (h[2] * 1031u);
+}
+
+// mesh view - edges and triangles of the mesh, generated in the thread pool
+struct PostHermesMeshView
+{
+    QVector<QVector2D> edges;
+    QVector<QVector2D> triangles;
+
+    // approximate size in kB
+    inline int cost() const { return (edges.size() + triangles.size()) * sizeof(QVector2D) / 1024 + 1; }
+};
+
+// order view - triangles with polynomial order of the element and labels, generated in the thread pool
+struct PostHermesOrderView
+{
+    PostHermesOrderView() : orderMin(11), orderMax(1) {}
+
+    QVector<QVector2D> triangles;
+    QVector<int> orders;
+    int orderMin;
+    int orderMax;
+
+    QVector<QVector2D> labelPositions;
+    QStringList labels;
+
+    // approximate size in kB
+    inline int cost() const { return (triangles.size() * sizeof(QVector2D) + orders.size() * sizeof(int)) / 1024 + 1; }
+};
+
 class PostHermes : public QObject
 {
     Q_OBJECT
 
 public:
+    // processed views (dirty flags)
+    enum ViewType
+    {
+        ViewType_InitialMesh = 0x01,
+        ViewType_SolutionMesh = 0x02,
+        ViewType_Order = 0x04,
+        ViewType_Contour = 0x08,
+        ViewType_Scalar = 0x10,
+        ViewType_Vector = 0x20,
+        ViewType_All = 0x3f,
+        // views of the mesh tab, processed only when requested by its paint
+        ViewType_Mesh = ViewType_InitialMesh | ViewType_SolutionMesh | ViewType_Order
+    };
+
     PostHermes();
     ~PostHermes();
 
     // mesh
-    inline Hermes::Hermes2D::Views::Linearizer *linInitialMeshView() { return m_linInitialMeshView; }
-    inline Hermes::Hermes2D::Views::Linearizer *linSolutionMeshView() { return m_linSolutionMeshView; }
+    inline QSharedPointer<PostHermesMeshView> initialMeshView() const { return m_initialMeshView; }
+    inline QSharedPointer<PostHermesMeshView> solutionMeshView() const { return m_solutionMeshView; }
 
     // order view
-    Hermes::Hermes2D::Views::Orderizer *ordView() { return m_orderView; }
+    inline QSharedPointer<PostHermesOrderView> orderView() const { return m_orderView; }
 
     // contour
-    inline Hermes::Hermes2D::Views::Linearizer *linContourView() { return m_linContourView; }
+    inline Hermes::Hermes2D::Views::Linearizer *linContourView() { return m_linContourView.data(); }
 
     // scalar view
-    inline Hermes::Hermes2D::Views::Linearizer *linScalarView() { return m_linScalarView; }
+    inline Hermes::Hermes2D::Views::Linearizer *linScalarView() { return m_linScalarView.data(); }
 
     // vector view
-    inline Hermes::Hermes2D::Views::Vectorizer *vecVectorView() { return m_vecVectorView; }
+    inline Hermes::Hermes2D::Views::Vectorizer *vecVectorView() { return m_vecVectorView.data(); }
 
     Hermes::Hermes2D::MeshFunctionSharedPtr<double> viewScalarFilter(Module::LocalVariable physicFieldVariable,
                                                                      PhysicFieldVariableComp physicFieldVariableComp);
@@ -67,40 +133,111 @@ public:
     void setActiveAdaptivityStep(int as);
 
     inline SolutionMode activeAdaptivitySolutionType() const { return m_activeSolutionMode; }
-    void setActiveAdaptivitySolutionType(SolutionMode st) { m_activeSolutionMode = st; }
+    void setActiveAdaptivitySolutionType(SolutionMode st) { m_activeSolutionMode = st; invalidate(); }
 
     MultiArray<double> activeMultiSolutionArray();
 
     inline bool isProcessed() const { return m_isProcessed; }
+    inline bool isProcessing() const { return !m_job.isNull(); }
+    inline bool isDirty(int views = ViewType_All) const { return (m_dirty & views); }
+
+    // dirty views are processed before the next paint (coalesced)
+    void refreshLater(int views = ViewType_All);
+
+    // visible area and size of one pixel of the 2D view, refinement of contour and scalar view follows it
+    void setViewport(const RectPoint &viewport, double pixelSize);
+    inline int linearizerLevel() const { return m_linearizerLevel; }
+
+    // incremented whenever the corresponding view is linearized again
+    inline int contourViewVersion() const { return m_contourViewVersion; }
+    inline int scalarViewVersion() const { return m_scalarViewVersion; }
+    inline int vectorViewVersion() const { return m_vectorViewVersion; }
 
 signals:
     void processed();
 
 public slots:
+    // views are recomputed lazily (paint, export), settings of the views were changed
+    void invalidate(int views = ViewType_All);
+    // blocks until all views are processed (only views with changed inputs are recomputed)
     void refresh();
+    // processes views in the thread pool (mesh views wait for the mesh tab), previous unfinished request is cancelled
+    void refreshAsync();
+    // views of the given steps are processed in the thread pool and used by the refresh of these steps (video)
+    void prefetch(int timeStep, int adaptivityStep);
+    void cancel();
+    // cancels and waits for the running tasks (before the problem releases their inputs)
+    void stopProcessing();
     void clear();
     void clearView();
 
+    // active field and steps follow the problem
+    void problemMeshed();
+    void problemSolved();
+
 private:
     bool m_isProcessed;
 
     // initial mesh
-    Hermes::Hermes2D::Views::Linearizer *m_linInitialMeshView;
+    QSharedPointer<PostHermesMeshView> m_initialMeshView;
 
     // solution mesh
-    Hermes::Hermes2D::Views::Linearizer *m_linSolutionMeshView;
+    QSharedPointer<PostHermesMeshView> m_solutionMeshView;
 
     // order view
-    Hermes::Hermes2D::Views::Orderizer *m_orderView;
+    QSharedPointer<PostHermesOrderView> m_orderView;
+
+    // mesh and order views of the visited solutions (field, time step, adaptivity step, solution mode)
+    QCache<QString, QSharedPointer<PostHermesMeshView> > m_meshViewCache;
+    QCache<QString, QSharedPointer<PostHermesOrderView> > m_orderViewCache;
 
     // contour
-    Hermes::Hermes2D::Views::Linearizer *m_linContourView;
+    QSharedPointer<Hermes::Hermes2D::Views::Linearizer> m_linContourView;
 
     // scalar view
-    Hermes::Hermes2D::Views::Linearizer *m_linScalarView; // linealizer for scalar view
+    QSharedPointer<Hermes::Hermes2D::Views::Linearizer> m_linScalarView; // linealizer for scalar view
 
     // vector view
-    Hermes::Hermes2D::Views::Vectorizer *m_vecVectorView; // vectorizer for vector view
+    QSharedPointer<Hermes::Hermes2D::Views::Vectorizer> m_vecVectorView; // vectorizer for vector view
+
+    // linearized views of the visited solutions, replayed without linearization (time steps, video)
+    QCache<QString, QSharedPointer<Hermes::Hermes2D::Views::Linearizer> > m_linearizerCache;
+    QCache<QString, QSharedPointer<Hermes::Hermes2D::Views::Vectorizer> > m_vectorizerCache;
+
+    int m_contourViewVersion;
+    int m_scalarViewVersion;
+    int m_vectorViewVersion;
+
+    // dirty views and inputs of the processed views
+    int m_dirty;
+    QMap<ViewType, QString> m_viewKeys;
+    bool m_refreshScheduled;
+    int m_refreshViews;
+    // solution is being cleared, no job is started
+    bool m_clearingSolution;
+
+    QString viewKey(ViewType view) const;
+    void collectViews(PostHermesJob *job, int views) const;
+    bool processDirty(int views = ViewType_All);
+
+    // screen-space level of detail
+    RectPoint m_viewport;
+    double m_viewportPixelSize;
+    int m_linearizerLevel;
+
+    int computeLinearizerLevel();
+
+    // background processing
+    QThreadPool m_threadPool;
+    QSharedPointer<PostHermesJob> m_job;
+    QList<PostHermesTask *> m_tasks;
+
+    // views of the next step, not published until the step is refreshed
+    QSharedPointer<PostHermesJob> m_prefetchJob;
+
+    bool canPrefetch() const;
+    void cancelPrefetch();
+    void publishJob();
 
     // view
     FieldInfo *m_activeViewField;
@@ -122,8 +259,12 @@ private slots:
 
     virtual void clearGLLists() {}
 
-    void problemMeshed();
-    void problemSolved();
+    void jobFinished();
+
+    // called in the thread clearing the solution
+    void problemAboutToClearSolution();
+    void clearingSolution();
+    void refreshDirty();
 };
 
 class SceneViewPostInterface : public SceneViewCommon
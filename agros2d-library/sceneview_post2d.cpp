@@ -49,13 +49,17 @@
 
 SceneViewPost2D::SceneViewPost2D(PostHermes *postHermes, QWidget *parent)
     : SceneViewCommon2D(postHermes, parent),
-      m_listContours(-1),
-      m_listVectors(-1),
-      m_listScalarField(-1),
+      m_arrayScalarFieldVersion(-1),
+      m_arrayScalarFieldOffset(0.0),
       m_selectedPoint(Point())
 {
     createActionsPost2D();
 
+    m_viewportTimer = new QTimer(this);
+    m_viewportTimer->setSingleShot(true);
+    m_viewportTimer->setInterval(300);
+    connect(m_viewportTimer, SIGNAL(timeout()), this, SLOT(updateViewport()));
+
     connect(this, SIGNAL(mousePressed(Point)), this, SLOT(selectedPoint(Point)));
 
     connect(Agros2D::scene(), SIGNAL(defaultValues()), this, SLOT(clear()));
@@ -197,11 +201,34 @@ void SceneViewPost2D::mousePressEvent(QMouseEvent *event)
     }
 }
 
+void SceneViewPost2D::updateViewport()
+{
+    if (width() == 0)
+        return;
+
+    m_postHermes->setViewport(m_viewport, m_viewport.width() / width());
+
+    if (Agros2D::problem()->isSolved())
+        updateGL();
+}
+
 void SceneViewPost2D::paintGL()
 {
     if (!isVisible()) return;
     makeCurrent();
 
+    // changed views are processed once and painted when ready
+    if (Agros2D::problem()->isMeshed())
+        m_postHermes->refreshLater(PostHermes::ViewType_Contour | PostHermes::ViewType_Scalar | PostHermes::ViewType_Vector);
+
+    // zoom or pan, restart waiting for the final viewport
+    RectPoint viewport(transform(Point(0, height())), transform(Point(width(), 0)));
+    if ((viewport.start != m_viewport.start) || (viewport.end != m_viewport.end))
+    {
+        m_viewport = viewport;
+        m_viewportTimer->start();
+    }
+
     glClearColor(COLORBACKGROUND[0], COLORBACKGROUND[1], COLORBACKGROUND[2], 0);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -246,6 +273,8 @@ void SceneViewPost2D::paintGL()
 
     paintZoomRegion();
 
+    flushText();
+
     if (Agros2D::problem()->isSolved() && m_postHermes->isProcessed())
     {
         if (Agros2D::problem()->setting()->value(ProblemSetting::View_ShowScalarView).toBool())
@@ -304,209 +333,228 @@ void SceneViewPost2D::paintGeometry()
     }
 }
 
-void SceneViewPost2D::paintScalarField()
+void SceneViewPost2D::createScalarFieldArrays()
 {
-    if (!Agros2D::problem()->isSolved()) return;
+    m_arrayScalarField.clear();
+    m_arrayScalarFieldValues.clear();
+    m_arrayScalarFieldIndices.clear();
+    m_arrayScalarFieldRangeKey.clear();
 
-    loadProjection2d(true);
+    // values are stored relative to the minimum (float precision)
+    m_arrayScalarFieldOffset = m_postHermes->linScalarView()->get_min_value();
 
-    if (m_listScalarField == -1)
+    QHash<ScalarVertexKey, GLuint> vertices;
+    for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
+         it = m_postHermes->linScalarView()->triangles_begin(); !it.end; ++it)
     {
-        if (!m_postHermes->linScalarView()) return;
+        Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
 
-        paletteCreate();
+        for (int j = 0; j < 3; j++)
+        {
+            ScalarVertexKey key;
+            key.x = triangle[j][0];
+            key.y = triangle[j][1];
+            key.value = triangle[j][2] - m_arrayScalarFieldOffset;
 
-        m_listScalarField = glGenLists(1);
-        glNewList(m_listScalarField, GL_COMPILE);
+            QHash<ScalarVertexKey, GLuint>::const_iterator vertex = vertices.constFind(key);
+            if (vertex == vertices.constEnd())
+            {
+                GLuint index = m_arrayScalarField.size();
+                vertex = vertices.insert(key, index);
 
-        // range
-        double irange = 1.0 / (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble() - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble());
-        // special case: constant solution
-        if (fabs(Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble() - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) < EPS_ZERO)
-            irange = 1.0;
+                m_arrayScalarField.append(QVector2D(key.x, key.y));
+                m_arrayScalarFieldValues.append(key.value);
+            }
+
+            m_arrayScalarFieldIndices.append(vertex.value());
+        }
+    }
 
-        // set texture for coloring
-        glEnable(GL_TEXTURE_1D);
-        glBindTexture(GL_TEXTURE_1D, m_textureScalar);
-        glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
+    m_arrayScalarFieldVersion = m_postHermes->scalarViewVersion();
+}
 
-        // set texture transformation matrix
-        glMatrixMode(GL_TEXTURE);
-        glLoadIdentity();
-        glTranslated(m_texShift, 0.0, 0.0);
-        glScaled(m_texScale, 0.0, 0.0);
+void SceneViewPost2D::createScalarFieldRangeArrays(double rangeMin, double rangeMax)
+{
+    m_arrayScalarFieldIndicesRange.clear();
+    m_arrayScalarFieldTexCoords.clear();
 
-        glBegin(GL_TRIANGLES);
-        for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
-             it = m_postHermes->linScalarView()->triangles_begin(); !it.end; ++it)
+    // skip triangles out of range
+    if (!Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeAuto).toBool())
+    {
+        m_arrayScalarFieldIndicesRange.reserve(m_arrayScalarFieldIndices.size());
+        for (int i = 0; i < m_arrayScalarFieldIndices.size(); i += 3)
         {
-            Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
+            double avgValue = m_arrayScalarFieldOffset + (m_arrayScalarFieldValues[m_arrayScalarFieldIndices[i]]
+                                                          + m_arrayScalarFieldValues[m_arrayScalarFieldIndices[i + 1]]
+                                                          + m_arrayScalarFieldValues[m_arrayScalarFieldIndices[i + 2]]) / 3.0;
+            if (avgValue < rangeMin || avgValue > rangeMax)
+                continue;
+
+            m_arrayScalarFieldIndicesRange.append(m_arrayScalarFieldIndices[i]);
+            m_arrayScalarFieldIndicesRange.append(m_arrayScalarFieldIndices[i + 1]);
+            m_arrayScalarFieldIndicesRange.append(m_arrayScalarFieldIndices[i + 2]);
+        }
+    }
 
-            if (!Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeAuto).toBool())
-            {
-                double avgValue = (triangle[0][2] + triangle[1][2] + triangle[2][2]) / 3.0;
-                if (avgValue < Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble() || avgValue > Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble())
-                    continue;
-            }
+    // logarithmic scale can not be expressed by the texture matrix
+    if (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeLog).toBool())
+    {
+        double irange = (fabs(rangeMax - rangeMin) < EPS_ZERO) ? 1.0 : 1.0 / (rangeMax - rangeMin);
+        int base = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeBase).toInt();
 
-            for (int j = 0; j < 3; j++)
-            {
-                if (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeLog).toBool())
-                    glTexCoord1d(log10((double) (1 + (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeBase).toInt() - 1))
-                                       * (triangle[j][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange) / log10((double) Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeBase).toInt()));
-                else
-                    glTexCoord1d((triangle[j][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
+        m_arrayScalarFieldTexCoords.resize(m_arrayScalarFieldValues.size());
+        for (int i = 0; i < m_arrayScalarFieldValues.size(); i++)
+            m_arrayScalarFieldTexCoords[i] = log10((double) (1 + (base - 1)) * (m_arrayScalarFieldOffset + m_arrayScalarFieldValues[i] - rangeMin) * irange) / log10((double) base);
+    }
+}
 
-                glVertex2d(triangle[j][0], triangle[j][1]);
-            }
-        }
-        glEnd();
+void SceneViewPost2D::paintScalarField()
+{
+    if (!Agros2D::problem()->isSolved()) return;
+    if (!m_postHermes->linScalarView()) return;
 
-        glDisable(GL_POLYGON_OFFSET_FILL);
-        glDisable(GL_TEXTURE_1D);
+    loadProjection2d(true);
 
-        // switch-off texture transform
-        glMatrixMode(GL_TEXTURE);
-        glLoadIdentity();
-        glMatrixMode(GL_MODELVIEW);
+    // geometry is built once per linearization
+    if (m_arrayScalarFieldVersion != m_postHermes->scalarViewVersion())
+        createScalarFieldArrays();
 
-        glEndList();
+    // palette change updates texture only
+    QString paletteKey = QString("%1|%2|%3").
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_PaletteType).toInt()).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_PaletteFilter).toBool()).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_PaletteSteps).toInt());
+    if (paletteKey != m_paletteKey || !glIsTexture(m_textureScalar))
+    {
+        paletteCreate();
+        m_paletteKey = paletteKey;
+    }
 
-        glCallList(m_listScalarField);
+    // range
+    double rangeMin = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble();
+    double rangeMax = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble();
+    bool rangeAuto = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeAuto).toBool();
+    bool rangeLog = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeLog).toBool();
+
+    double irange = 1.0 / (rangeMax - rangeMin);
+    // special case: constant solution
+    if (fabs(rangeMax - rangeMin) < EPS_ZERO)
+        irange = 1.0;
+
+    QString rangeKey = QString("%1|%2|%3|%4|%5").
+            arg(rangeMin, 0, 'e', 16).
+            arg(rangeMax, 0, 'e', 16).
+            arg(rangeAuto).
+            arg(rangeLog).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeBase).toInt());
+    if (rangeKey != m_arrayScalarFieldRangeKey)
+    {
+        createScalarFieldRangeArrays(rangeMin, rangeMax);
+        m_arrayScalarFieldRangeKey = rangeKey;
+    }
 
-        /*
-        // range
-        double irange = PALETTEENTRIES / (Agros2D::problem()->configView()->scalarRangeMax - Agros2D::problem()->configView()->scalarRangeMin);
-        // special case: constant solution
-        if (fabs(Agros2D::problem()->configView()->scalarRangeMax - Agros2D::problem()->configView()->scalarRangeMin) < EPS_ZERO)
-            irange = PALETTEENTRIES / 2;
+    // set texture for coloring
+    glEnable(GL_TEXTURE_1D);
+    glBindTexture(GL_TEXTURE_1D, m_textureScalar);
+    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
+
+    // set texture transformation matrix (maps value to palette)
+    glMatrixMode(GL_TEXTURE);
+    glLoadIdentity();
+    glTranslated(m_texShift, 0.0, 0.0);
+    glScaled(m_texScale, 0.0, 0.0);
+    if (!rangeLog)
+    {
+        glScaled(irange, 1.0, 1.0);
+        glTranslated(m_arrayScalarFieldOffset - rangeMin, 0.0, 0.0);
+    }
+    glMatrixMode(GL_MODELVIEW);
 
-        double3* linVert = m_postHermes->linScalarView()->get_vertices();
-        int3* linTris = m_postHermes->linScalarView()->get_triangles();
-        Point point[3];
-        double value[3];
+    const QVector<GLuint> &indices = rangeAuto ? m_arrayScalarFieldIndices : m_arrayScalarFieldIndicesRange;
 
-        for (int i = 0; i < m_postHermes->linScalarView()->get_num_triangles(); i++)
-        {
-            for (int j = 0; j < 3; j++)
-            {
-                point[j].x = linVert[linTris[i][j]][0];
-                point[j].y = linVert[linTris[i][j]][1];
-                value[j]   = linVert[linTris[i][j]][2];
-            }
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
 
-            if (!Agros2D::problem()->configView()->scalarRangeAuto)
-            {
-                double avgValue = (value[0] + value[1] + value[2]) / 3.0;
-                if (avgValue < Agros2D::problem()->configView()->scalarRangeMin || avgValue > Agros2D::problem()->configView()->scalarRangeMax)
-                    continue;
-            }
+    glVertexPointer(2, GL_FLOAT, 0, m_arrayScalarField.constData());
+    glTexCoordPointer(1, GL_FLOAT, 0, rangeLog ? m_arrayScalarFieldTexCoords.constData() : m_arrayScalarFieldValues.constData());
+    glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, indices.constData());
 
-            for (int j = 0; j < 3; j++)
-            {
-                m_arrayScalarField.push_back(QVector2D(point[j].x, point[j].y));
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
 
-                const double* color = paletteColor2((value[j] - Agros2D::problem()->configView()->scalarRangeMin) * irange);
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glDisable(GL_TEXTURE_1D);
 
-                m_arrayScalarFieldColors.push_back(QVector3D(color[0], color[1], color[2]));
-                // qDebug() << ((value[j] - Agros2D::problem()->configView()->scalarRangeMin) * irange) << m_arrayScalarFieldColors.at(m_arrayScalarFieldColors.count() - 1);
+    // switch-off texture transform
+    glMatrixMode(GL_TEXTURE);
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+}
 
-            }
-        }
-        */
-    }
-    else
+void SceneViewPost2D::createContoursArrays()
+{
+    m_arrayContours.clear();
+
+    // transform variable
+    double rangeMin =  numeric_limits<double>::max();
+    double rangeMax = -numeric_limits<double>::max();
+
+    for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::vertex_t>
+         it = m_postHermes->linContourView()->vertices_begin(); !it.end; ++it)
     {
-        glCallList(m_listScalarField);
+        Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::vertex_t& vertex = it.get();
 
-        /*
-        glLineWidth(1.0);
-        glDisable(GL_POLYGON_OFFSET_FILL);
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        if (vertex[2] > rangeMax) rangeMax = vertex[2];
+        if (vertex[2] < rangeMin) rangeMin = vertex[2];
+    }
+
+    // contour lines
+    if ((rangeMax-rangeMin) > EPS_ZERO)
+    {
+        // value range
+        double step = (rangeMax-rangeMin) / Agros2D::problem()->setting()->value(ProblemSetting::View_ContoursCount).toInt();
 
-        glBegin(GL_TRIANGLES);
         for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
-             it = m_postHermes->linScalarView()->triangles_begin(); !it.end; ++it)
+             it = m_postHermes->linContourView()->triangles_begin(); !it.end; ++it)
         {
             Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
-
-            for (int j = 0; j < 3; j++)
-                glVertex2d(triangle[j][0], triangle[j][1]);
+            paintContoursTri(triangle, step, m_arrayContours);
         }
-        glEnd();
-        */
-
-        /*
-        glEnableClientState(GL_COLOR_ARRAY);
-        glEnableClientState(GL_VERTEX_ARRAY);
-
-        glColorPointer(3, GL_FLOAT, 0, m_arrayScalarFieldColors.constData());
-        glVertexPointer(2, GL_FLOAT, 0, m_arrayScalarField.constData());
-
-        glDrawArrays(GL_TRIANGLES, 0, m_arrayScalarField.size());
-
-        glDisableClientState(GL_VERTEX_ARRAY);
-        glDisableClientState(GL_COLOR_ARRAY);
-        */
     }
 }
 
 void SceneViewPost2D::paintContours()
 {
     if (!Agros2D::problem()->isSolved()) return;
+    if (!m_postHermes->linContourView()) return;
 
     loadProjection2d(true);
 
-    if (m_listContours == -1)
+    QString key = QString("%1|%2").
+            arg(m_postHermes->contourViewVersion()).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_ContoursCount).toInt());
+    if (key != m_arrayContoursKey)
     {
-        if (!m_postHermes->linContourView()) return;
-
-        m_listContours = glGenLists(1);
-        glNewList(m_listContours, GL_COMPILE);
-
-        // transform variable
-        double rangeMin =  numeric_limits<double>::max();
-        double rangeMax = -numeric_limits<double>::max();
-
-        for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::vertex_t>
-             it = m_postHermes->linContourView()->vertices_begin(); !it.end; ++it)
-        {
-            Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::vertex_t& vertex = it.get();
-
-            if (vertex[2] > rangeMax) rangeMax = vertex[2];
-            if (vertex[2] < rangeMin) rangeMin = vertex[2];
-        }
+        createContoursArrays();
+        m_arrayContoursKey = key;
+    }
 
-        // draw contours
-        if ((rangeMax-rangeMin) > EPS_ZERO)
-        {
-            // value range
-            double step = (rangeMax-rangeMin) / Agros2D::problem()->setting()->value(ProblemSetting::View_ContoursCount).toInt();
+    if (m_arrayContours.isEmpty())
+        return;
 
-            glLineWidth(Agros2D::problem()->setting()->value(ProblemSetting::View_ContoursWidth).toInt());
-            glColor3d(COLORCONTOURS[0], COLORCONTOURS[1], COLORCONTOURS[2]);
+    glLineWidth(Agros2D::problem()->setting()->value(ProblemSetting::View_ContoursWidth).toInt());
+    glColor3d(COLORCONTOURS[0], COLORCONTOURS[1], COLORCONTOURS[2]);
 
-            glBegin(GL_LINES);
-            for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
-                 it = m_postHermes->linContourView()->triangles_begin(); !it.end; ++it)
-            {
-                Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
-                paintContoursTri(triangle, step);
-            }
-            glEnd();
-        }
+    glEnableClientState(GL_VERTEX_ARRAY);
 
-        glEndList();
+    glVertexPointer(2, GL_FLOAT, 0, m_arrayContours.constData());
+    glDrawArrays(GL_LINES, 0, m_arrayContours.size());
 
-        glCallList(m_listContours);
-    }
-    else
-    {
-        glCallList(m_listContours);
-    }
+    glDisableClientState(GL_VERTEX_ARRAY);
 }
 
-void SceneViewPost2D::paintContoursTri(Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle, double step)
+void SceneViewPost2D::paintContoursTri(Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle, double step,
+                                       QVector<QVector2D> &lines)
 {
     // sort the vertices by their value, keep track of the permutation sign.
     int i, idx[3] = { 0, 1, 2 }, perm = 0;
@@ -553,13 +601,13 @@ void SceneViewPost2D::paintContoursTri(Hermes::Hermes2D::Views::ScalarLinearizer
 
             if (perm & 1)
             {
-                glVertex2d(x1, y1);
-                glVertex2d(x2, y2);
+                lines.append(QVector2D(x1, y1));
+                lines.append(QVector2D(x2, y2));
             }
             else
             {
-                glVertex2d(x2, y2);
-                glVertex2d(x1, y1);
+                lines.append(QVector2D(x2, y2));
+                lines.append(QVector2D(x1, y1));
             }
 
             val += step;
@@ -873,227 +921,226 @@ void SceneViewPost2D::paintVectors()
     return;
     */
 
+    if (!m_postHermes->vecVectorView()) return;
+
     loadProjection2d(true);
 
-    if (m_listVectors == -1)
+    QString key = QString("%1|%2|%3|%4|%5|%6|%7").
+            arg(m_postHermes->vectorViewVersion()).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_VectorCount).toInt()).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_VectorScale).toDouble()).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_VectorProportional).toBool()).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_VectorColor).toBool()).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_VectorType).toInt()).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_VectorCenter).toInt());
+    if (key != m_arrayVectorsKey)
     {
-        if (!m_postHermes->vecVectorView()) return;
+        createVectorsArrays();
+        m_arrayVectorsKey = key;
+    }
 
-        m_listVectors = glGenLists(1);
-        glNewList(m_listVectors, GL_COMPILE);
+    if (m_arrayVectors.isEmpty())
+        return;
 
-        double vectorRangeMin = m_postHermes->vecVectorView()->get_min_value();
-        double vectorRangeMax = m_postHermes->vecVectorView()->get_max_value();
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
-        //Add 20% margin to the range
-        double vectorRange = vectorRangeMax - vectorRangeMin;
-        vectorRangeMin = vectorRangeMin - 0.2*vectorRange;
-        vectorRangeMax = vectorRangeMax + 0.2*vectorRange;
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
 
-        // qDebug() << "SceneViewCommon::paintVectors(), min = " << vectorRangeMin << ", max = " << vectorRangeMax;
+    glVertexPointer(2, GL_FLOAT, 0, m_arrayVectors.constData());
+    glColorPointer(3, GL_FLOAT, 0, m_arrayVectorsColors.constData());
+    glDrawArrays(GL_TRIANGLES, 0, m_arrayVectors.size());
 
-        double irange = 1.0 / (vectorRangeMax - vectorRangeMin);
-        // if (fabs(vectorRangeMin - vectorRangeMax) < EPS_ZERO) return;
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
 
-        RectPoint rect = Agros2D::scene()->boundingBox();
-        double gs = (rect.width() + rect.height()) / Agros2D::problem()->setting()->value(ProblemSetting::View_VectorCount).toInt();
+    glDisable(GL_POLYGON_OFFSET_FILL);
+}
 
-        /*
-        Point point[3];
-        double value[3];
+void SceneViewPost2D::createVectorsArrays()
+{
+    m_arrayVectors.clear();
+    m_arrayVectorsColors.clear();
 
-        glEnable(GL_POLYGON_OFFSET_FILL);
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    double vectorRangeMin = m_postHermes->vecVectorView()->get_min_value();
+    double vectorRangeMax = m_postHermes->vecVectorView()->get_max_value();
 
-        glBegin(GL_TRIANGLES);
-        for (int i = 0; i < m_postHermes->vecVectorView().get_num_triangles(); i++)
-        {
-            for (int j = 0; j < 3; j++)
-            {
-                point[j].x = vecVert[vecTris[i][j]][0];
-                point[j].y = vecVert[vecTris[i][j]][1];
-                value[j]   = vecVert[vecTris[i][j]][2];
+    //Add 20% margin to the range
+    double vectorRange = vectorRangeMax - vectorRangeMin;
+    vectorRangeMin = vectorRangeMin - 0.2*vectorRange;
+    vectorRangeMax = vectorRangeMax + 0.2*vectorRange;
 
-                glVertex2d(point[j].x, point[j].y);
-            }
-        }
-        glEnd();
-        */
+    // qDebug() << "SceneViewCommon::paintVectors(), min = " << vectorRangeMin << ", max = " << vectorRangeMax;
 
-        glEnable(GL_POLYGON_OFFSET_FILL);
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    double irange = 1.0 / (vectorRangeMax - vectorRangeMin);
+    // if (fabs(vectorRangeMin - vectorRangeMax) < EPS_ZERO) return;
 
-        glBegin(GL_TRIANGLES);
-        for (Hermes::Hermes2D::Views::Vectorizer::Iterator<Hermes::Hermes2D::Views::VectorLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
-             it = m_postHermes->vecVectorView()->triangles_begin(); !it.end; ++it)
+    RectPoint rect = Agros2D::scene()->boundingBox();
+    double gs = (rect.width() + rect.height()) / Agros2D::problem()->setting()->value(ProblemSetting::View_VectorCount).toInt();
+
+    for (Hermes::Hermes2D::Views::Vectorizer::Iterator<Hermes::Hermes2D::Views::VectorLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
+         it = m_postHermes->vecVectorView()->triangles_begin(); !it.end; ++it)
+    {
+        Hermes::Hermes2D::Views::VectorLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
+
+        Point a(triangle[0][0], triangle[0][1]);
+        Point b(triangle[1][0], triangle[1][1]);
+        Point c(triangle[2][0], triangle[2][1]);
+
+        RectPoint r;
+        r.start = Point(qMin(qMin(a.x, b.x), c.x), qMin(qMin(a.y, b.y), c.y));
+        r.end = Point(qMax(qMax(a.x, b.x), c.x), qMax(qMax(a.y, b.y), c.y));
+
+        // double area
+        double area2 = a.x * (b.y - c.y) + b.x * (c.y - a.y) + c.x * (a.y - b.y);
+
+        // plane equation
+        double aa = b.x*c.y - c.x*b.y;
+        double ab = c.x*a.y - a.x*c.y;
+        double ac = a.x*b.y - b.x*a.y;
+        double ba = b.y - c.y;
+        double bb = c.y - a.y;
+        double bc = a.y - b.y;
+        double ca = c.x - b.x;
+        double cb = a.x - c.x;
+        double cc = b.x - a.x;
+
+        double ax = (aa * triangle[0][2] + ab * triangle[1][2] + ac * triangle[2][2]) / area2;
+        double bx = (ba * triangle[0][2] + bb * triangle[1][2] + bc * triangle[2][2]) / area2;
+        double cx = (ca * triangle[0][2] + cb * triangle[1][2] + cc * triangle[2][2]) / area2;
+
+        double ay = (aa * triangle[0][3] + ab * triangle[1][3] + ac * triangle[2][3]) / area2;
+        double by = (ba * triangle[0][3] + bb * triangle[1][3] + bc * triangle[2][3]) / area2;
+        double cy = (ca * triangle[0][3] + cb * triangle[1][3] + cc * triangle[2][3]) / area2;
+
+        for (int j = floor(r.start.x / gs); j < ceil(r.end.x / gs); j++)
         {
-            Hermes::Hermes2D::Views::VectorLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
-
-            Point a(triangle[0][0], triangle[0][1]);
-            Point b(triangle[1][0], triangle[1][1]);
-            Point c(triangle[2][0], triangle[2][1]);
-
-            RectPoint r;
-            r.start = Point(qMin(qMin(a.x, b.x), c.x), qMin(qMin(a.y, b.y), c.y));
-            r.end = Point(qMax(qMax(a.x, b.x), c.x), qMax(qMax(a.y, b.y), c.y));
-
-            // double area
-            double area2 = a.x * (b.y - c.y) + b.x * (c.y - a.y) + c.x * (a.y - b.y);
-
-            // plane equation
-            double aa = b.x*c.y - c.x*b.y;
-            double ab = c.x*a.y - a.x*c.y;
-            double ac = a.x*b.y - b.x*a.y;
-            double ba = b.y - c.y;
-            double bb = c.y - a.y;
-            double bc = a.y - b.y;
-            double ca = c.x - b.x;
-            double cb = a.x - c.x;
-            double cc = b.x - a.x;
-
-            double ax = (aa * triangle[0][2] + ab * triangle[1][2] + ac * triangle[2][2]) / area2;
-            double bx = (ba * triangle[0][2] + bb * triangle[1][2] + bc * triangle[2][2]) / area2;
-            double cx = (ca * triangle[0][2] + cb * triangle[1][2] + cc * triangle[2][2]) / area2;
-
-            double ay = (aa * triangle[0][3] + ab * triangle[1][3] + ac * triangle[2][3]) / area2;
-            double by = (ba * triangle[0][3] + bb * triangle[1][3] + bc * triangle[2][3]) / area2;
-            double cy = (ca * triangle[0][3] + cb * triangle[1][3] + cc * triangle[2][3]) / area2;
-
-            for (int j = floor(r.start.x / gs); j < ceil(r.end.x / gs); j++)
+            for (int k = floor(r.start.y / gs); k < ceil(r.end.y / gs); k++)
             {
-                for (int k = floor(r.start.y / gs); k < ceil(r.end.y / gs); k++)
-                {
-                    Point point(j*gs, k*gs);
-                    if (k % 2 == 0) point.x += gs/2.0;
+                Point point(j*gs, k*gs);
+                if (k % 2 == 0) point.x += gs/2.0;
 
-                    // find in triangle
-                    bool inTriangle = true;
+                // find in triangle
+                bool inTriangle = true;
 
-                    for (int l = 0; l < 3; l++)
-                    {
-                        int p = l + 1;
-                        if (p == 3)
-                            p = 0;
+                for (int l = 0; l < 3; l++)
+                {
+                    int p = l + 1;
+                    if (p == 3)
+                        p = 0;
 
-                        double z = (triangle[p][0] - triangle[l][0]) * (point.y - triangle[l][1]) - (triangle[p][1] - triangle[l][1]) * (point.x - triangle[l][0]);
+                    double z = (triangle[p][0] - triangle[l][0]) * (point.y - triangle[l][1]) - (triangle[p][1] - triangle[l][1]) * (point.x - triangle[l][0]);
 
-                        if (z < 0)
-                        {
-                            inTriangle = false;
-                            break;
-                        }
+                    if (z < 0)
+                    {
+                        inTriangle = false;
+                        break;
                     }
+                }
 
-                    if (inTriangle)
-                    {
-                        // view
-                        double dx = ax + bx * point.x + cx * point.y;
-                        double dy = ay + by * point.x + cy * point.y;
+                if (inTriangle)
+                {
+                    // view
+                    double dx = ax + bx * point.x + cx * point.y;
+                    double dy = ay + by * point.x + cy * point.y;
 
-                        double value = sqrt(dx*dx + dy*dy);
-                        double angle = atan2(dy, dx);
+                    double value = sqrt(dx*dx + dy*dy);
+                    double angle = atan2(dy, dx);
 
-                        if ((Agros2D::problem()->setting()->value(ProblemSetting::View_VectorProportional).toBool()) && (fabs(vectorRangeMin - vectorRangeMax) > EPS_ZERO))
+                    if ((Agros2D::problem()->setting()->value(ProblemSetting::View_VectorProportional).toBool()) && (fabs(vectorRangeMin - vectorRangeMax) > EPS_ZERO))
+                    {
+                        if ((value / vectorRangeMax) < 1e-6)
                         {
-                            if ((value / vectorRangeMax) < 1e-6)
-                            {
-                                dx = 0.0;
-                                dy = 0.0;
-                            }
-                            else
-                            {
-                                dx = ((value - vectorRangeMin) * irange) * Agros2D::problem()->setting()->value(ProblemSetting::View_VectorScale).toDouble() * gs * cos(angle);
-                                dy = ((value - vectorRangeMin) * irange) * Agros2D::problem()->setting()->value(ProblemSetting::View_VectorScale).toDouble() * gs * sin(angle);
-                            }
+                            dx = 0.0;
+                            dy = 0.0;
                         }
                         else
                         {
-                            dx = Agros2D::problem()->setting()->value(ProblemSetting::View_VectorScale).toDouble() * gs * cos(angle);
-                            dy = Agros2D::problem()->setting()->value(ProblemSetting::View_VectorScale).toDouble() * gs * sin(angle);
+                            dx = ((value - vectorRangeMin) * irange) * Agros2D::problem()->setting()->value(ProblemSetting::View_VectorScale).toDouble() * gs * cos(angle);
+                            dy = ((value - vectorRangeMin) * irange) * Agros2D::problem()->setting()->value(ProblemSetting::View_VectorScale).toDouble() * gs * sin(angle);
                         }
+                    }
+                    else
+                    {
+                        dx = Agros2D::problem()->setting()->value(ProblemSetting::View_VectorScale).toDouble() * gs * cos(angle);
+                        dy = Agros2D::problem()->setting()->value(ProblemSetting::View_VectorScale).toDouble() * gs * sin(angle);
+                    }
 
-                        double dm = sqrt(dx*dx + dy*dy);
+                    double dm = sqrt(dx*dx + dy*dy);
 
-                        // color
-                        if ((Agros2D::problem()->setting()->value(ProblemSetting::View_VectorColor).toBool())
-                                && (fabs(vectorRangeMin - vectorRangeMax) > EPS_ZERO))
-                        {
-                            double color = 0.7 - 0.7 * (value - vectorRangeMin) * irange;
-                            glColor3d(color, color, color);
-                        }
-                        else
-                        {
-                            glColor3d(COLORVECTORS[0], COLORVECTORS[1], COLORVECTORS[2]);
-                        }
+                    // color
+                    QVector3D color;
+                    if ((Agros2D::problem()->setting()->value(ProblemSetting::View_VectorColor).toBool())
+                            && (fabs(vectorRangeMin - vectorRangeMax) > EPS_ZERO))
+                    {
+                        double gray = 0.7 - 0.7 * (value - vectorRangeMin) * irange;
+                        color = QVector3D(gray, gray, gray);
+                    }
+                    else
+                    {
+                        color = QVector3D(COLORVECTORS[0], COLORVECTORS[1], COLORVECTORS[2]);
+                    }
 
-                        // tail
-                        Point shiftCenter(0.0, 0.0);
-                        if ((VectorCenter) Agros2D::problem()->setting()->value(ProblemSetting::View_VectorCenter).toInt() == VectorCenter_Head)
-                            shiftCenter = Point(- 2.0*dm * cos(angle), - 2.0*dm * sin(angle)); // head
-                        if ((VectorCenter) Agros2D::problem()->setting()->value(ProblemSetting::View_VectorCenter).toInt() == VectorCenter_Center)
-                            shiftCenter = Point(- dm * cos(angle), - dm * sin(angle)); // center
+                    // tail
+                    Point shiftCenter(0.0, 0.0);
+                    if ((VectorCenter) Agros2D::problem()->setting()->value(ProblemSetting::View_VectorCenter).toInt() == VectorCenter_Head)
+                        shiftCenter = Point(- 2.0*dm * cos(angle), - 2.0*dm * sin(angle)); // head
+                    if ((VectorCenter) Agros2D::problem()->setting()->value(ProblemSetting::View_VectorCenter).toInt() == VectorCenter_Center)
+                        shiftCenter = Point(- dm * cos(angle), - dm * sin(angle)); // center
 
-                        if ((VectorType) Agros2D::problem()->setting()->value(ProblemSetting::View_VectorType).toInt() == VectorType_Arrow)
-                        {
-                            // arrow and shaft
-                            // head for an arrow
-                            double vh1x = point.x + dm/5.0 * cos(angle - M_PI/2.0) + dm * cos(angle) + shiftCenter.x;
-                            double vh1y = point.y + dm/5.0 * sin(angle - M_PI/2.0) + dm * sin(angle) + shiftCenter.y;
-                            double vh2x = point.x + dm/5.0 * cos(angle + M_PI/2.0) + dm * cos(angle) + shiftCenter.x;
-                            double vh2y = point.y + dm/5.0 * sin(angle + M_PI/2.0) + dm * sin(angle) + shiftCenter.y;
-                            double vh3x = point.x + 2.0 * dm * cos(angle) + shiftCenter.x;
-                            double vh3y = point.y + 2.0 * dm * sin(angle) + shiftCenter.y;
-
-                            glVertex2d(vh1x, vh1y);
-                            glVertex2d(vh2x, vh2y);
-                            glVertex2d(vh3x, vh3y);
-
-                            // shaft for an arrow
-                            double vs1x = point.x + dm/15.0 * cos(angle + M_PI/2.0) + dm * cos(angle) + shiftCenter.x;
-                            double vs1y = point.y + dm/15.0 * sin(angle + M_PI/2.0) + dm * sin(angle) + shiftCenter.y;
-                            double vs2x = point.x + dm/15.0 * cos(angle - M_PI/2.0) + dm * cos(angle) + shiftCenter.x;
-                            double vs2y = point.y + dm/15.0 * sin(angle - M_PI/2.0) + dm * sin(angle) + shiftCenter.y;
-                            double vs3x = vs1x - dm * cos(angle);
-                            double vs3y = vs1y - dm * sin(angle);
-                            double vs4x = vs2x - dm * cos(angle);
-                            double vs4y = vs2y - dm * sin(angle);
-
-                            glVertex2d(vs1x, vs1y);
-                            glVertex2d(vs2x, vs2y);
-                            glVertex2d(vs3x, vs3y);
-                            glVertex2d(vs4x, vs4y);
-                            glVertex2d(vs3x, vs3y);
-                            glVertex2d(vs2x, vs2y);
-                        }
-                        else if ((VectorType) Agros2D::problem()->setting()->value(ProblemSetting::View_VectorType).toInt() == VectorType_Cone)
-                        {
-                            // cone
-                            double vh1x = point.x + dm/3.5 * cos(angle - M_PI/2.0) + shiftCenter.x;
-                            double vh1y = point.y + dm/3.5 * sin(angle - M_PI/2.0) + shiftCenter.y;
-                            double vh2x = point.x + dm/3.5 * cos(angle + M_PI/2.0) + shiftCenter.x;
-                            double vh2y = point.y + dm/3.5 * sin(angle + M_PI/2.0) + shiftCenter.y;
-                            double vh3x = point.x + 2.0 * dm * cos(angle) + shiftCenter.x;
-                            double vh3y = point.y + 2.0 * dm * sin(angle) + shiftCenter.y;
-
-                            glVertex2d(vh1x, vh1y);
-                            glVertex2d(vh2x, vh2y);
-                            glVertex2d(vh3x, vh3y);
-                        }
+                    if ((VectorType) Agros2D::problem()->setting()->value(ProblemSetting::View_VectorType).toInt() == VectorType_Arrow)
+                    {
+                        // arrow and shaft
+                        // head for an arrow
+                        double vh1x = point.x + dm/5.0 * cos(angle - M_PI/2.0) + dm * cos(angle) + shiftCenter.x;
+                        double vh1y = point.y + dm/5.0 * sin(angle - M_PI/2.0) + dm * sin(angle) + shiftCenter.y;
+                        double vh2x = point.x + dm/5.0 * cos(angle + M_PI/2.0) + dm * cos(angle) + shiftCenter.x;
+                        double vh2y = point.y + dm/5.0 * sin(angle + M_PI/2.0) + dm * sin(angle) + shiftCenter.y;
+                        double vh3x = point.x + 2.0 * dm * cos(angle) + shiftCenter.x;
+                        double vh3y = point.y + 2.0 * dm * sin(angle) + shiftCenter.y;
+
+                        m_arrayVectors.append(QVector2D(vh1x, vh1y));
+                        m_arrayVectors.append(QVector2D(vh2x, vh2y));
+                        m_arrayVectors.append(QVector2D(vh3x, vh3y));
+                        m_arrayVectorsColors.insert(m_arrayVectorsColors.end(), 3, color);
+
+                        // shaft for an arrow
+                        double vs1x = point.x + dm/15.0 * cos(angle + M_PI/2.0) + dm * cos(angle) + shiftCenter.x;
+                        double vs1y = point.y + dm/15.0 * sin(angle + M_PI/2.0) + dm * sin(angle) + shiftCenter.y;
+                        double vs2x = point.x + dm/15.0 * cos(angle - M_PI/2.0) + dm * cos(angle) + shiftCenter.x;
+                        double vs2y = point.y + dm/15.0 * sin(angle - M_PI/2.0) + dm * sin(angle) + shiftCenter.y;
+                        double vs3x = vs1x - dm * cos(angle);
+                        double vs3y = vs1y - dm * sin(angle);
+                        double vs4x = vs2x - dm * cos(angle);
+                        double vs4y = vs2y - dm * sin(angle);
+
+                        m_arrayVectors.append(QVector2D(vs1x, vs1y));
+                        m_arrayVectors.append(QVector2D(vs2x, vs2y));
+                        m_arrayVectors.append(QVector2D(vs3x, vs3y));
+                        m_arrayVectors.append(QVector2D(vs4x, vs4y));
+                        m_arrayVectors.append(QVector2D(vs3x, vs3y));
+                        m_arrayVectors.append(QVector2D(vs2x, vs2y));
+                        m_arrayVectorsColors.insert(m_arrayVectorsColors.end(), 6, color);
+                    }
+                    else if ((VectorType) Agros2D::problem()->setting()->value(ProblemSetting::View_VectorType).toInt() == VectorType_Cone)
+                    {
+                        // cone
+                        double vh1x = point.x + dm/3.5 * cos(angle - M_PI/2.0) + shiftCenter.x;
+                        double vh1y = point.y + dm/3.5 * sin(angle - M_PI/2.0) + shiftCenter.y;
+                        double vh2x = point.x + dm/3.5 * cos(angle + M_PI/2.0) + shiftCenter.x;
+                        double vh2y = point.y + dm/3.5 * sin(angle + M_PI/2.0) + shiftCenter.y;
+                        double vh3x = point.x + 2.0 * dm * cos(angle) + shiftCenter.x;
+                        double vh3y = point.y + 2.0 * dm * sin(angle) + shiftCenter.y;
+
+                        m_arrayVectors.append(QVector2D(vh1x, vh1y));
+                        m_arrayVectors.append(QVector2D(vh2x, vh2y));
+                        m_arrayVectors.append(QVector2D(vh3x, vh3y));
+                        m_arrayVectorsColors.insert(m_arrayVectorsColors.end(), 3, color);
                     }
                 }
             }
         }
-        glEnd();
-
-        glDisable(GL_POLYGON_OFFSET_FILL);
-
-        glEndList();
-
-        glCallList(m_listVectors);
-    }
-    else
-    {
-        glCallList(m_listVectors);
     }
 }
 
@@ -1181,13 +1228,27 @@ void SceneViewPost2D::paintPostprocessorSelectedPoint()
 
 void SceneViewPost2D::clearGLLists()
 {
-    if (m_listContours != -1) glDeleteLists(m_listContours, 1);
-    if (m_listVectors != -1) glDeleteLists(m_listVectors, 1);
-    if (m_listScalarField != -1) glDeleteLists(m_listScalarField, 1);
+    // vertex arrays live in client memory and are rebuilt when linearization changes,
+    // only the palette texture has to be recreated
+    m_paletteKey.clear();
+}
 
-    m_listContours = -1;
-    m_listVectors = -1;
-    m_listScalarField = -1;
+void SceneViewPost2D::clearArrays()
+{
+    m_arrayScalarField.clear();
+    m_arrayScalarFieldValues.clear();
+    m_arrayScalarFieldIndices.clear();
+    m_arrayScalarFieldIndicesRange.clear();
+    m_arrayScalarFieldTexCoords.clear();
+    m_arrayScalarFieldVersion = -1;
+    m_arrayScalarFieldRangeKey.clear();
+
+    m_arrayContours.clear();
+    m_arrayContoursKey.clear();
+
+    m_arrayVectors.clear();
+    m_arrayVectorsColors.clear();
+    m_arrayVectorsKey.clear();
 }
 
 void SceneViewPost2D::refresh()
@@ -1215,6 +1276,7 @@ void SceneViewPost2D::clear()
 {
     actPostprocessorModeNothing->trigger();
 
+    clearArrays();
     setControls();
 
     SceneViewCommon2D::clear();
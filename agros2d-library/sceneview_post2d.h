@@ -72,7 +72,8 @@ protected:
 
     void paintScalarField(); // paint scalar field surface
     void paintContours(); // paint scalar field contours
-    void paintContoursTri(Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle, double step);
+    void paintContoursTri(Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle, double step,
+                          QVector<QVector2D> &lines);
     void paintVectors(); // paint vector field vectors
 
     void paintPostprocessorSelectedVolume(); // paint selected volume for integration
@@ -83,21 +84,45 @@ private:
     // selected point
     Point m_selectedPoint;
 
-    // gl lists
-    int m_listContours;
-    int m_listVectors;
-    int m_listScalarField;
-
-    // QVector<QVector2D> m_arrayScalarField;
-    // QVector<QVector3D> m_arrayScalarFieldColors;
+    // scalar field - packed vertices (position and value), built once per linearization
+    QVector<QVector2D> m_arrayScalarField;
+    QVector<float> m_arrayScalarFieldValues;
+    QVector<GLuint> m_arrayScalarFieldIndices;
+    int m_arrayScalarFieldVersion;
+    double m_arrayScalarFieldOffset;
+    // visible triangles and texture coordinates, depend on range only
+    QVector<GLuint> m_arrayScalarFieldIndicesRange;
+    QVector<float> m_arrayScalarFieldTexCoords;
+    QString m_arrayScalarFieldRangeKey;
+    QString m_paletteKey;
+
+    // contours - line segments
+    QVector<QVector2D> m_arrayContours;
+    QString m_arrayContoursKey;
+
+    // vectors - triangles with colors
+    QVector<QVector2D> m_arrayVectors;
+    QVector<QVector3D> m_arrayVectorsColors;
+    QString m_arrayVectorsKey;
+
+    // visible area, linearization is refined when zoom and pan settle
+    RectPoint m_viewport;
+    QTimer *m_viewportTimer;
 
     void createActionsPost2D();
 
+    void createScalarFieldArrays();
+    void createScalarFieldRangeArrays(double rangeMin, double rangeMax);
+    void createContoursArrays();
+    void createVectorsArrays();
+    void clearArrays();
+
     void exportVTK(const QString &fileName, const QString &variable, PhysicFieldVariableComp physicFieldVariableComp);
 
 private slots:
     void showGroup(QAction *action);
     void selectedPoint(const Point &p);
+    void updateViewport();
 
     virtual void refresh();
     virtual void clearGLLists();
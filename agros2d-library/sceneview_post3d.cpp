@@ -64,7 +64,9 @@ SceneViewPost3D::SceneViewPost3D(PostHermes *postHermes, QWidget *parent)
     : SceneViewCommon3D(postHermes, parent),
       m_listScalarField3D(-1),
       m_listScalarField3DSolid(-1),
-      m_listModel(-1)
+      m_listModel(-1),
+      m_arrayScalarFieldVersion(-1),
+      m_arrayScalarFieldOffset(0.0)
 {
     createActionsPost3D();
 
@@ -101,6 +103,10 @@ void SceneViewPost3D::paintGL()
     if (!isVisible()) return;
     makeCurrent();
 
+    // changed views are processed once and painted when ready
+    if (Agros2D::problem()->isMeshed())
+        m_postHermes->refreshLater(PostHermes::ViewType_InitialMesh | PostHermes::ViewType_Scalar);
+
     glClearColor(COLORBACKGROUND[0], COLORBACKGROUND[1], COLORBACKGROUND[2], 0);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -147,6 +153,8 @@ void SceneViewPost3D::paintGL()
     }
 
     if (Agros2D::configComputer()->value(Config::Config_ShowAxes).toBool()) paintAxes();
+
+    flushText();
 }
 
 void SceneViewPost3D::resizeGL(int w, int h)
@@ -159,104 +167,314 @@ void SceneViewPost3D::resizeGL(int w, int h)
     SceneViewCommon::resizeGL(w, h);
 }
 
-void SceneViewPost3D::paintScalarField3D()
+// key of linearizer edge, independent of orientation
+static inline quint64 edgeKey(int a, int b)
 {
-    if (!Agros2D::problem()->isSolved()) return;
+    return (quint64(qMin(a, b)) << 32) | quint64(qMax(a, b));
+}
 
-    loadProjection3d(true, ((SceneViewPost3DMode) Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DMode).toInt()) == SceneViewPost3DMode_ScalarView3D);
+void SceneViewPost3D::createScalarFieldArrays()
+{
+    clearArrays();
 
-    if (m_listScalarField3D == -1)
+    // values are stored relative to the minimum (float precision)
+    m_arrayScalarFieldOffset = m_postHermes->linScalarView()->get_min_value();
+
+    QHash<ScalarVertexKey, GLuint> vertices;
+    QHash<ScalarVertexKey, int> points;
+    QMap<int, int> markerLabels;
+    for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
+         it = m_postHermes->linScalarView()->triangles_begin(); !it.end; ++it)
     {
-        if (!m_postHermes->linScalarView()) return;
+        Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
+        int& elem_marker = it.get_marker();
 
-        paletteCreate();
+        // find label
+        QMap<int, int>::const_iterator label = markerLabels.constFind(elem_marker);
+        if (label == markerLabels.constEnd())
+            label = markerLabels.insert(elem_marker, atoi(postHermes()->activeViewField()->initialMesh()->get_element_markers_conversion().get_user_marker(elem_marker).marker.c_str()));
+        m_arrayScalarFieldLabels.append(label.value());
 
-        m_listScalarField3D = glGenLists(1);
-        glNewList(m_listScalarField3D, GL_COMPILE);
+        for (int j = 0; j < 3; j++)
+        {
+            ScalarVertexKey key;
+            key.x = triangle[j][0];
+            key.y = triangle[j][1];
+            key.value = triangle[j][2] - m_arrayScalarFieldOffset;
 
-        glPushMatrix();
+            QHash<ScalarVertexKey, GLuint>::const_iterator vertex = vertices.constFind(key);
+            if (vertex == vertices.constEnd())
+            {
+                GLuint index = m_arrayScalarField.size();
+                vertex = vertices.insert(key, index);
 
-        glMatrixMode(GL_PROJECTION);
-        glLoadIdentity();
+                // discontinuous values share the position
+                ScalarVertexKey pointKey = key;
+                pointKey.value = 0.0;
 
-        glMatrixMode(GL_MODELVIEW);
-        glLoadIdentity();
+                QHash<ScalarVertexKey, int>::const_iterator point = points.constFind(pointKey);
+                if (point == points.constEnd())
+                    point = points.insert(pointKey, points.size());
 
-        glPopMatrix();
+                m_arrayScalarField.append(QVector3D(key.x, key.y, - key.value));
+                m_arrayScalarFieldValues.append(key.value);
+                m_arrayScalarFieldPoints.append(point.value());
+            }
 
-        glEnable(GL_DEPTH_TEST);
+            m_arrayScalarFieldIndices.append(vertex.value());
+        }
+    }
 
-        // range
-        double irange = 1.0 / (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble() - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble());
-        // special case: constant solution
-        if (fabs(Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble() - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble()) < EPS_ZERO)
+    // triangles adjacent to vertices
+    int count = m_arrayScalarField.size();
+    QVector<int> adjacentFirst(count + 1, 0);
+    for (int i = 0; i < m_arrayScalarFieldIndices.size(); i++)
+        adjacentFirst[m_arrayScalarFieldIndices[i] + 1]++;
+    for (int i = 0; i < count; i++)
+        adjacentFirst[i + 1] += adjacentFirst[i];
+
+    QVector<int> adjacent(m_arrayScalarFieldIndices.size());
+    QVector<int> adjacentNext = adjacentFirst;
+    for (int i = 0; i < m_arrayScalarFieldIndices.size(); i++)
+        adjacent[adjacentNext[m_arrayScalarFieldIndices[i]]++] = i / 3;
+
+    // smooth normals (area weighted), vertices are independent
+    m_arrayScalarFieldNormals.resize(count);
+
+    const QVector3D *positions = m_arrayScalarField.constData();
+    const GLuint *indices = m_arrayScalarFieldIndices.constData();
+    const int *first = adjacentFirst.constData();
+    const int *triangles = adjacent.constData();
+    QVector3D *normals = m_arrayScalarFieldNormals.data();
+
+#pragma omp parallel for
+    for (int i = 0; i < count; i++)
+    {
+        double sum[3] = { 0.0, 0.0, 0.0 };
+        for (int k = first[i]; k < first[i + 1]; k++)
         {
-            irange = 1.0;
+            const QVector3D &p0 = positions[indices[3 * triangles[k] + 0]];
+            const QVector3D &p1 = positions[indices[3 * triangles[k] + 1]];
+            const QVector3D &p2 = positions[indices[3 * triangles[k] + 2]];
+
+            double normal[3];
+            computeNormal(p0.x(), p0.y(), p0.z(),
+                          p1.x(), p1.y(), p1.z(),
+                          p2.x(), p2.y(), p2.z(),
+                          normal);
+
+            // orient up regardless of triangle winding (z component is twice the area in plane)
+            double sign = (normal[2] < 0.0) ? -1.0 : 1.0;
+            sum[0] += sign * normal[0];
+            sum[1] += sign * normal[1];
+            sum[2] += sign * normal[2];
         }
 
-        RectPoint rect = Agros2D::scene()->boundingBox();
+        double length = sqrt(sum[0]*sum[0] + sum[1]*sum[1] + sum[2]*sum[2]);
+        if (length > 0.0)
+            normals[i] = QVector3D(sum[0] / length, sum[1] / length, sum[2] / length);
+        else
+            normals[i] = QVector3D(0.0, 0.0, 1.0);
+    }
 
-        double max = qMax(rect.width(), rect.height());
+    m_arrayScalarFieldVersion = m_postHermes->scalarViewVersion();
+}
 
-        glPushMatrix();
-        glScaled(1.0, 1.0, max / Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DHeight).toDouble() * fabs(irange));
+void SceneViewPost3D::createScalarFieldRangeArrays(double rangeMin, double rangeMax, bool solid)
+{
+    m_arrayScalarFieldIndicesRange.clear();
+    m_arrayScalarFieldBoundary.clear();
 
-        // scalar view
-        initLighting();
-        // init normal
-        double *normal = new double[3];
+    bool rangeAuto = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeAuto).toBool();
 
-        // set texture for coloring
-        if (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DLighting).toBool())
-            glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-        else
-            glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
-        glEnable(GL_TEXTURE_1D);
-        glBindTexture(GL_TEXTURE_1D, m_textureScalar);
+    // hidden materials (solid view only)
+    QVector<bool> hidden(Agros2D::scene()->labels->count(), false);
+    if (solid)
+    {
+        QStringList hide = Agros2D::problem()->setting()->value(ProblemSetting::View_SolidViewHide).toStringList();
+        for (int i = 0; i < Agros2D::scene()->labels->count(); i++)
+            hidden[i] = hide.contains(Agros2D::scene()->labels->at(i)->marker(postHermes()->activeViewField())->name());
+    }
 
-        // set texture transformation matrix
-        glMatrixMode(GL_TEXTURE);
-        glLoadIdentity();
-        glTranslated(m_texShift, 0.0, 0.0);
-        glScaled(m_texScale, 0.0, 0.0);
+    m_arrayScalarFieldIndicesRange.reserve(m_arrayScalarFieldIndices.size());
+    for (int i = 0; i < m_arrayScalarFieldIndices.size(); i += 3)
+    {
+        int label = m_arrayScalarFieldLabels[i / 3];
+        if (label >= 0 && label < hidden.size() && hidden[label])
+            continue;
 
-        glBegin(GL_TRIANGLES);
-        for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
-             it = m_postHermes->linScalarView()->triangles_begin(); !it.end; ++it)
+        // skip triangles out of range
+        if (!rangeAuto)
         {
-            Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
+            double avgValue = m_arrayScalarFieldOffset + (m_arrayScalarFieldValues[m_arrayScalarFieldIndices[i]]
+                                                          + m_arrayScalarFieldValues[m_arrayScalarFieldIndices[i + 1]]
+                                                          + m_arrayScalarFieldValues[m_arrayScalarFieldIndices[i + 2]]) / 3.0;
+            if (avgValue < rangeMin || avgValue > rangeMax)
+                continue;
+        }
 
-            if (!Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeAuto).toBool())
-            {
-                double avgValue = (triangle[0][2] + triangle[1][2] + triangle[2][2]) / 3.0;
-                if (avgValue < Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble() || avgValue > Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble())
-                    continue;
-            }
+        m_arrayScalarFieldIndicesRange.append(m_arrayScalarFieldIndices[i]);
+        m_arrayScalarFieldIndicesRange.append(m_arrayScalarFieldIndices[i + 1]);
+        m_arrayScalarFieldIndicesRange.append(m_arrayScalarFieldIndices[i + 2]);
+    }
 
-            double delta = 0.0;
+    if (!solid)
+        return;
 
-            if (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DLighting).toBool())
-            {
-                computeNormal(triangle[0][0], triangle[0][1], - delta - (triangle[0][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()),
-                        triangle[1][0], triangle[1][1], - delta - (triangle[1][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()),
-                        triangle[2][0], triangle[2][1], - delta - (triangle[2][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()),
-                        normal);
+    // boundary edges belong to one visible triangle only
+    QHash<quint64, int> edges;
+    for (int i = 0; i < m_arrayScalarFieldIndicesRange.size(); i += 3)
+        for (int k = 0; k < 3; k++)
+            edges[edgeKey(m_arrayScalarFieldPoints[m_arrayScalarFieldIndicesRange[i + k]],
+                          m_arrayScalarFieldPoints[m_arrayScalarFieldIndicesRange[i + (k + 1) % 3]])]++;
 
-                glNormal3d(normal[0], normal[1], normal[2]);
-            }
-            for (int j = 0; j < 3; j++)
+    for (int i = 0; i < m_arrayScalarFieldIndicesRange.size(); i += 3)
+    {
+        const QVector3D &p0 = m_arrayScalarField[m_arrayScalarFieldIndicesRange[i + 0]];
+        const QVector3D &p1 = m_arrayScalarField[m_arrayScalarFieldIndicesRange[i + 1]];
+        const QVector3D &p2 = m_arrayScalarField[m_arrayScalarFieldIndicesRange[i + 2]];
+        bool ccw = ((p1.x() - p0.x()) * (p2.y() - p0.y()) - (p1.y() - p0.y()) * (p2.x() - p0.x())) >= 0.0;
+
+        for (int k = 0; k < 3; k++)
+        {
+            GLuint a = m_arrayScalarFieldIndicesRange[i + k];
+            GLuint b = m_arrayScalarFieldIndicesRange[i + (k + 1) % 3];
+
+            if (edges.value(edgeKey(m_arrayScalarFieldPoints[a], m_arrayScalarFieldPoints[b])) != 1)
+                continue;
+
+            // triangle lies on the left side
+            if (ccw)
+                m_arrayScalarFieldBoundary << a << b;
+            else
+                m_arrayScalarFieldBoundary << b << a;
+        }
+    }
+}
+
+void SceneViewPost3D::createSolidSidesArrays(double phi)
+{
+    m_arraySolidSides.clear();
+    m_arraySolidSidesNormals.clear();
+    m_arraySolidSidesValues.clear();
+    m_arraySolidSidesIndices.clear();
+
+    bool planar = (Agros2D::problem()->config()->coordinateType() == CoordinateType_Planar);
+
+    int count = qMax(1, int(29.0 * phi / 360.0));
+    double step = phi / count;
+
+    for (int i = 0; i < m_arrayScalarFieldBoundary.size(); i += 2)
+    {
+        GLuint a = m_arrayScalarFieldBoundary[i];
+        GLuint b = m_arrayScalarFieldBoundary[i + 1];
+
+        const QVector3D &pa = m_arrayScalarField[a];
+        const QVector3D &pb = m_arrayScalarField[b];
+        float va = m_arrayScalarFieldValues[a];
+        float vb = m_arrayScalarFieldValues[b];
+
+        // outward normal in plane
+        QVector2D normal = QVector2D(pb.y() - pa.y(), pa.x() - pb.x()).normalized();
+
+        GLuint first = m_arraySolidSides.size();
+        if (planar)
+        {
+            // unit depth, scaled when painted
+            m_arraySolidSides << QVector3D(pa.x(), pa.y(), -0.5) << QVector3D(pb.x(), pb.y(), -0.5)
+                              << QVector3D(pb.x(), pb.y(), 0.5) << QVector3D(pa.x(), pa.y(), 0.5);
+            m_arraySolidSidesValues << va << vb << vb << va;
+            for (int k = 0; k < 4; k++)
+                m_arraySolidSidesNormals << QVector3D(normal.x(), normal.y(), 0.0);
+
+            m_arraySolidSidesIndices << first << first + 1 << first + 2
+                                     << first << first + 2 << first + 3;
+        }
+        else
+        {
+            for (int j = 0; j <= count; j++)
             {
-                glTexCoord1d((triangle[j][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
-                glVertex3d(triangle[j][0], triangle[j][1], - delta - (triangle[j][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()));
+                double angle = j * step / 180.0 * M_PI;
+
+                m_arraySolidSides << QVector3D(pa.x() * cos(angle), pa.y(), pa.x() * sin(angle))
+                                  << QVector3D(pb.x() * cos(angle), pb.y(), pb.x() * sin(angle));
+                m_arraySolidSidesValues << va << vb;
+                m_arraySolidSidesNormals << QVector3D(normal.x() * cos(angle), normal.y(), normal.x() * sin(angle))
+                                         << QVector3D(normal.x() * cos(angle), normal.y(), normal.x() * sin(angle));
+
+                if (j > 0)
+                {
+                    GLuint k = first + 2 * j;
+                    m_arraySolidSidesIndices << k - 2 << k - 1 << k + 1
+                                             << k - 2 << k + 1 << k;
+                }
             }
         }
-        glEnd();
+    }
+}
 
-        // remove normal
-        delete [] normal;
+void SceneViewPost3D::clearArrays()
+{
+    m_arrayScalarField.clear();
+    m_arrayScalarFieldNormals.clear();
+    m_arrayScalarFieldValues.clear();
+    m_arrayScalarFieldIndices.clear();
+    m_arrayScalarFieldPoints.clear();
+    m_arrayScalarFieldLabels.clear();
+    m_arrayScalarFieldVersion = -1;
+
+    m_arrayScalarFieldIndicesRange.clear();
+    m_arrayScalarFieldBoundary.clear();
+    m_arrayScalarFieldRangeKey.clear();
+
+    m_arraySolidSides.clear();
+    m_arraySolidSidesNormals.clear();
+    m_arraySolidSidesValues.clear();
+    m_arraySolidSidesIndices.clear();
+    m_arraySolidSidesKey.clear();
+}
 
-        glDisable(GL_TEXTURE_1D);
-        glDisable(GL_LIGHTING);
+void SceneViewPost3D::paintScalarField3D()
+{
+    if (!Agros2D::problem()->isSolved()) return;
+    if (!m_postHermes->linScalarView()) return;
+
+    loadProjection3d(true, ((SceneViewPost3DMode) Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DMode).toInt()) == SceneViewPost3DMode_ScalarView3D);
+
+    // geometry is built once per linearization
+    if (m_arrayScalarFieldVersion != m_postHermes->scalarViewVersion())
+        createScalarFieldArrays();
+
+    // range
+    double rangeMin = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble();
+    double rangeMax = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble();
+    bool rangeAuto = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeAuto).toBool();
+
+    double irange = 1.0 / (rangeMax - rangeMin);
+    // special case: constant solution
+    if (fabs(rangeMax - rangeMin) < EPS_ZERO)
+        irange = 1.0;
+
+    QString rangeKey = QString("%1|%2|%3|surface").
+            arg(rangeMin, 0, 'e', 16).
+            arg(rangeMax, 0, 'e', 16).
+            arg(rangeAuto);
+    if (rangeKey != m_arrayScalarFieldRangeKey)
+    {
+        createScalarFieldRangeArrays(rangeMin, rangeMax, false);
+        m_arrayScalarFieldRangeKey = rangeKey;
+    }
+
+    RectPoint rect = Agros2D::scene()->boundingBox();
+    double max = qMax(rect.width(), rect.height());
+
+    // palette, mesh, bounding box and geometry
+    if (m_listScalarField3D == -1)
+    {
+        paletteCreate();
+
+        m_listScalarField3D = glGenLists(1);
+        glNewList(m_listScalarField3D, GL_COMPILE);
 
         // draw blended mesh
         glEnable(GL_BLEND);
@@ -266,17 +484,14 @@ void SceneViewPost3D::paintScalarField3D()
         glColor4d(0.5, 0.5, 0.5, 0.3);
 
         // triangles
-        glBegin(GL_TRIANGLES);
-        for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
-             it = m_postHermes->linInitialMeshView()->triangles_begin(); !it.end; ++it)
+        QSharedPointer<PostHermesMeshView> initialMeshView = m_postHermes->initialMeshView();
+        if (initialMeshView)
         {
-            Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
-
-            glVertex2d(triangle[0][0], triangle[0][1]);
-            glVertex2d(triangle[1][0], triangle[1][1]);
-            glVertex2d(triangle[2][0], triangle[2][1]);
+            glBegin(GL_TRIANGLES);
+            for (int i = 0; i < initialMeshView->triangles.size(); i++)
+                glVertex2d(initialMeshView->triangles[i].x(), initialMeshView->triangles[i].y());
+            glEnd();
         }
-        glEnd();
 
         glDisable(GL_BLEND);
         glDisable(GL_POLYGON_OFFSET_FILL);
@@ -343,328 +558,136 @@ void SceneViewPost3D::paintScalarField3D()
             glLineWidth(1.0);
         }
 
-        glDisable(GL_DEPTH_TEST);
-
-        // switch-off texture transform
-        glMatrixMode(GL_TEXTURE);
-        glLoadIdentity();
-        glMatrixMode(GL_MODELVIEW);
-
-        glPopMatrix();
-
         glEndList();
-
-        glCallList(m_listScalarField3D);
     }
-    else
-    {
-        glCallList(m_listScalarField3D);
-    }
-}
-
-void SceneViewPost3D::paintScalarField3DSolid()
-{
-    if (!Agros2D::problem()->isSolved()) return;
-
-    loadProjection3d(true, ((SceneViewPost3DMode) Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DMode).toInt()) == SceneViewPost3DMode_ScalarView3D);
-
-    if (m_listScalarField3DSolid == -1)
-    {
-        if (!m_postHermes->linScalarView()) return;
-
-        paletteCreate();
-
-        m_listScalarField3DSolid = glGenLists(1);
-        glNewList(m_listScalarField3DSolid, GL_COMPILE);
-
-        bool isModel = (((SceneViewPost3DMode) Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DMode).toInt()) == SceneViewPost3DMode_Model);
-
-        glPushMatrix();
-
-        glMatrixMode(GL_PROJECTION);
-        glLoadIdentity();
-
-        glMatrixMode(GL_MODELVIEW);
-        glLoadIdentity();
-
-        glPopMatrix();
 
-        glEnable(GL_DEPTH_TEST);
+    glEnable(GL_DEPTH_TEST);
 
-        RectPoint rect = Agros2D::scene()->boundingBox();
-        double max = qMax(rect.width(), rect.height());
-        double depth = max / Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DHeight).toDouble();
+    glPushMatrix();
+    glScaled(1.0, 1.0, max / Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DHeight).toDouble() * fabs(irange));
 
-        // range
-        double irange = 1.0 / (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble() - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble());
-        // special case: constant solution
-        if (fabs(Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble() - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble()) < EPS_ZERO)
-        {
-            irange = 1.0;
-        }
-
-        double phi = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DAngle).toDouble();
-
-        QVector<int> linTrisBoundaries;
-        for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::edge_t>
-             it = m_postHermes->linScalarView()->edges_begin(); !it.end; ++it)
-        {
-            Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::edge_t& edge = it.get();
-            int& edge_marker = it.get_marker();
-
-            if (edge_marker > 0)
-            {
-                // if (!linTrisBoundaries.contains(linEdges[edge][0]))
-                //     linTrisBoundaries.append(linEdges[edge][0]);
-                // if (!linTrisBoundaries.contains(linEdges[edge][1]))
-                //     linTrisBoundaries.append(linEdges[edge][1]);
-            }
-        }
-
-        glPushMatrix();
-
-        // set texture for coloring
-        if (!isModel)
-        {
-            glEnable(GL_TEXTURE_1D);
-            glBindTexture(GL_TEXTURE_1D, m_textureScalar);
-            glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-
-            // set texture transformation matrix
-            glMatrixMode(GL_TEXTURE);
-            glLoadIdentity();
-            glTranslated(m_texShift, 0.0, 0.0);
-            glScaled(m_texScale, 0.0, 0.0);
-        }
-        else
-        {
-            glColor3d(0.7, 0.7, 0.7);
-            glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
-        }
+    // scalar view
+    bool lighting = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DLighting).toBool();
+    initLighting();
+    // normals are scaled with height
+    if (lighting)
+        glEnable(GL_NORMALIZE);
 
-        initLighting();
-        // init normals
-        double* normal = new double[3];
-
-        if (Agros2D::problem()->config()->coordinateType() == CoordinateType_Planar)
-        {
-            glBegin(GL_TRIANGLES);
-            for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
-                 it = m_postHermes->linScalarView()->triangles_begin(); !it.end; ++it)
-            {
-                Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
-                int& elem_marker = it.get_marker();
-
-                // find marker
-                SceneLabel *label = Agros2D::scene()->labels->at(atoi(postHermes()->activeViewField()->initialMesh()->get_element_markers_conversion().get_user_marker(elem_marker).marker.c_str()));
-                SceneMaterial *material = label->marker(postHermes()->activeViewField());
-
-                // hide material
-                if (Agros2D::problem()->setting()->value(ProblemSetting::View_SolidViewHide).toStringList().contains(material->name()))
-                    continue;
-
-                if (!Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeAuto).toBool())
-                {
-                    double avgValue = (triangle[0][2] + triangle[1][2] + triangle[2][2]) / 3.0;
-                    if (avgValue < Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble() || avgValue > Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble())
-                        continue;
-                }
-
-                // z = - depth / 2.0
-                if (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DLighting).toBool() || isModel)
-                {
-                    computeNormal(triangle[0][0], triangle[0][1], -depth/2.0,
-                            triangle[1][0], triangle[1][1], -depth/2.0,
-                            triangle[2][0], triangle[2][1], -depth/2.0,
-                            normal);
-                    glNormal3d(normal[0], normal[1], normal[2]);
-                }
-
-                for (int j = 0; j < 3; j++)
-                {
-                    if (!isModel) glTexCoord1d((triangle[j][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
-                    glVertex3d(triangle[j][0], triangle[j][1], -depth/2.0);
-                }
+    // set texture for coloring
+    if (lighting)
+        glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    else
+        glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
+    glEnable(GL_TEXTURE_1D);
+    glBindTexture(GL_TEXTURE_1D, m_textureScalar);
 
-                // z = + depth / 2.0
-                if (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DLighting).toBool() || isModel)
-                {
-                    computeNormal(triangle[0][0], triangle[0][1], depth/2.0,
-                            triangle[1][0], triangle[1][1], depth/2.0,
-                            triangle[2][0], triangle[2][1], depth/2.0,
-                            normal);
-                    glNormal3d(normal[0], normal[1], normal[2]);
-                }
+    // set texture transformation matrix (maps value to palette)
+    glMatrixMode(GL_TEXTURE);
+    glLoadIdentity();
+    glTranslated(m_texShift, 0.0, 0.0);
+    glScaled(m_texScale, 0.0, 0.0);
+    glScaled(irange, 1.0, 1.0);
+    glTranslated(m_arrayScalarFieldOffset - rangeMin, 0.0, 0.0);
+    glMatrixMode(GL_MODELVIEW);
 
-                for (int j = 0; j < 3; j++)
-                {
-                    if (!isModel) glTexCoord1d((triangle[j][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
-                    glVertex3d(triangle[j][0], triangle[j][1], depth/2.0);
-                }
-            }
-            glEnd();
+    // z = - (value - rangeMin)
+    glPushMatrix();
+    glTranslated(0.0, 0.0, rangeMin - m_arrayScalarFieldOffset);
 
-            glBegin(GL_QUADS);
-            for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
-                 it = m_postHermes->linScalarView()->triangles_begin(); !it.end; ++it)
-            {
-                Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
+    const QVector<GLuint> &indices = rangeAuto ? m_arrayScalarFieldIndices : m_arrayScalarFieldIndicesRange;
 
-                // boundary element
-                // if ((linTrisBoundaries.contains(linTris[i][0]) || linTrisBoundaries.contains(linTris[i][1]) || linTrisBoundaries.contains(linTris[i][2])))
-                {
-                    // find marker
-                    SceneLabel *label = Agros2D::scene()->labels->at(0); // Agros2D::scene()->labels->at(atoi(postHermes()->activeViewField()->initialMesh()->get_element_markers_conversion().get_user_marker(linTrisMarkers[i]).marker.c_str()));
-                    SceneMaterial *material = label->marker(postHermes()->activeViewField());
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    if (lighting)
+        glEnableClientState(GL_NORMAL_ARRAY);
 
-                    // hide material
-                    if (Agros2D::problem()->setting()->value(ProblemSetting::View_SolidViewHide).toStringList().contains(material->name()))
-                        continue;
+    glVertexPointer(3, GL_FLOAT, 0, m_arrayScalarField.constData());
+    glTexCoordPointer(1, GL_FLOAT, 0, m_arrayScalarFieldValues.constData());
+    if (lighting)
+        glNormalPointer(GL_FLOAT, 0, m_arrayScalarFieldNormals.constData());
+    glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, indices.constData());
 
-                    // length
-                    for (int k = 0; k < 3; k++)
-                    {
-                        if (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DLighting).toBool() || isModel)
-                        {
-                            computeNormal(triangle[k][0], triangle[k][1], -depth/2.0,
-                                    triangle[(k + 1) % 3][0], triangle[(k + 1) % 3][1], -depth/2.0,
-                                    triangle[(k + 1) % 3][0], triangle[(k + 1) % 3][1],  depth/2.0,
-                                    normal);
-                            glNormal3d(normal[0], normal[1], normal[2]);
-                        }
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
 
-                        if (!isModel) glTexCoord1d((triangle[k][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
-                        glVertex3d(triangle[k][0], triangle[k][1], -depth/2.0);
-                        if (!isModel) glTexCoord1d((triangle[(k + 1) % 3][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
-                        glVertex3d(triangle[(k + 1) % 3][0], triangle[(k + 1) % 3][1], -depth/2.0);
+    glPopMatrix();
 
-                        if (!isModel) glTexCoord1d((triangle[(k + 1) % 3][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
-                        glVertex3d(triangle[(k + 1) % 3][0], triangle[(k + 1) % 3][1], depth/2.0);
-                        if (!isModel) glTexCoord1d((triangle[k][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
-                        glVertex3d(triangle[k][0], triangle[k][1], depth/2.0);
-                    }
-                }
-            }
-            glEnd();
-        }
-        else
-        {
-            // side
-            glBegin(GL_TRIANGLES);
-            for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
-                 it = m_postHermes->linScalarView()->triangles_begin(); !it.end; ++it)
-            {
-                Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
-                int& elem_marker = it.get_marker();
+    glDisable(GL_NORMALIZE);
+    glDisable(GL_TEXTURE_1D);
+    glDisable(GL_LIGHTING);
 
-                // find marker
-                SceneLabel *label = Agros2D::scene()->labels->at(atoi(postHermes()->activeViewField()->initialMesh()->get_element_markers_conversion().get_user_marker(elem_marker).marker.c_str()));
-                SceneMaterial *material = label->marker(postHermes()->activeViewField());
+    // switch-off texture transform
+    glMatrixMode(GL_TEXTURE);
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
 
-                // hide material
-                if (Agros2D::problem()->setting()->value(ProblemSetting::View_SolidViewHide).toStringList().contains(material->name()))
-                    continue;
+    glCallList(m_listScalarField3D);
 
-                if (!Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeAuto).toBool())
-                {
-                    double avgValue = (triangle[0][2] + triangle[1][2] + triangle[2][2]) / 3.0;
-                    if (avgValue < Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble() || avgValue > Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble())
-                        continue;
-                }
+    glDisable(GL_DEPTH_TEST);
 
-                for (int j = 0; j < 2; j++)
-                {
-                    if (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DLighting).toBool() || isModel)
-                    {
-                        computeNormal(triangle[0][0] * cos(j*phi/180.0*M_PI), triangle[0][1], triangle[0][0] * sin(j*phi/180.0*M_PI),
-                                triangle[1][0] * cos(j*phi/180.0*M_PI), triangle[1][1], triangle[1][0] * sin(j*phi/180.0*M_PI),
-                                triangle[2][0] * cos(j*phi/180.0*M_PI), triangle[2][1], triangle[2][0] * sin(j*phi/180.0*M_PI),
-                                normal);
-                        glNormal3d(normal[0], normal[1], normal[2]);
-                    }
+    glPopMatrix();
+}
 
-                    glTexCoord1d((triangle[0][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
-                    glVertex3d(triangle[0][0] * cos(j*phi/180.0*M_PI), triangle[0][1], triangle[0][0] * sin(j*phi/180.0*M_PI));
-                    glTexCoord1d((triangle[1][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
-                    glVertex3d(triangle[1][0] * cos(j*phi/180.0*M_PI), triangle[1][1], triangle[1][0] * sin(j*phi/180.0*M_PI));
-                    glTexCoord1d((triangle[2][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
-                    glVertex3d(triangle[2][0] * cos(j*phi/180.0*M_PI), triangle[2][1], triangle[2][0] * sin(j*phi/180.0*M_PI));
-                }
-            }
-            glEnd();
+void SceneViewPost3D::paintScalarField3DSolid()
+{
+    if (!Agros2D::problem()->isSolved()) return;
+    if (!m_postHermes->linScalarView()) return;
 
-            for (Hermes::Hermes2D::Views::Linearizer::Iterator<Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t>
-                 it = m_postHermes->linScalarView()->triangles_begin(); !it.end; ++it)
-            {
-                Hermes::Hermes2D::Views::ScalarLinearizerDataDimensions<LINEARIZER_DATA_TYPE>::triangle_t& triangle = it.get();
-                int& elem_marker = it.get_marker();
+    loadProjection3d(true, ((SceneViewPost3DMode) Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DMode).toInt()) == SceneViewPost3DMode_ScalarView3D);
 
-                // boundary element
-                // if ((linTrisBoundaries.contains(linTris[i][0]) || linTrisBoundaries.contains(linTris[i][1]) || linTrisBoundaries.contains(linTris[i][2])))
-                {
-                    // find marker
-                    SceneLabel *label = Agros2D::scene()->labels->at(atoi(postHermes()->activeViewField()->initialMesh()->get_element_markers_conversion().get_user_marker(elem_marker).marker.c_str()));
-                    SceneMaterial *material = label->marker(postHermes()->activeViewField());
+    // geometry is built once per linearization
+    if (m_arrayScalarFieldVersion != m_postHermes->scalarViewVersion())
+        createScalarFieldArrays();
 
-                    // hide material
-                    if (Agros2D::problem()->setting()->value(ProblemSetting::View_SolidViewHide).toStringList().contains(material->name()))
-                        continue;
+    bool isModel = (((SceneViewPost3DMode) Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DMode).toInt()) == SceneViewPost3DMode_Model);
+    bool planar = (Agros2D::problem()->config()->coordinateType() == CoordinateType_Planar);
 
-                    if (!Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeAuto).toBool())
-                    {
-                        double avgValue = (triangle[0][2] + triangle[1][2] + triangle[2][2]) / 3.0;
-                        if (avgValue < Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble() || avgValue > Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble())
-                            continue;
-                    }
+    RectPoint rect = Agros2D::scene()->boundingBox();
+    double max = qMax(rect.width(), rect.height());
+    double depth = max / Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DHeight).toDouble();
 
-                    // sides
-                    int count = 29.0 * phi / 360.0;
-                    double step = phi/count;
-                    for (int k = 0; k < 3; k++)
-                    {
-                        glBegin(GL_TRIANGLE_STRIP);
-                        for (int j = 0; j < count + 1; j++)
-                        {
+    double phi = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DAngle).toDouble();
 
-                            if (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DLighting).toBool() || isModel)
-                            {
-                                computeNormal(triangle[k][0] * cos((j+0)*step/180.0*M_PI), triangle[k][1], triangle[k][0] * sin((j+0)*step/180.0*M_PI),
-                                        triangle[(k + 1) % 3][0] * cos((j+0)*step/180.0*M_PI), triangle[(k + 1) % 3][1], triangle[(k + 1) % 3][0] * sin((j+0)*step/180.0*M_PI),
-                                        triangle[(k + 1) % 3][0] * cos((j+1)*step/180.0*M_PI), triangle[(k + 1) % 3][1], triangle[(k + 1) % 3][0] * sin((j+1)*step/180.0*M_PI),
-                                        normal);
-                                glNormal3d(normal[0], normal[1], normal[2]);
-                            }
+    // range
+    double rangeMin = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble();
+    double rangeMax = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMax).toDouble();
+    bool rangeAuto = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeAuto).toBool();
 
-                            if (!isModel) glTexCoord1d((triangle[k][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
-                            glVertex3d(triangle[k][0] * cos((j+0)*step/180.0*M_PI),
-                                    triangle[k][1],
-                                    triangle[k][0] * sin((j+0)*step/180.0*M_PI));
-                            if (!isModel) glTexCoord1d((triangle[(k + 1) % 3][2] - Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarRangeMin).toDouble()) * irange);
-                            glVertex3d(triangle[(k + 1) % 3][0] * cos((j+0)*step/180.0*M_PI),
-                                    triangle[(k + 1) % 3][1],
-                                    triangle[(k + 1) % 3][0] * sin((j+0)*step/180.0*M_PI));
-                        }
-                        glEnd();
-                    }
-                }
-            }
-        }
+    double irange = 1.0 / (rangeMax - rangeMin);
+    // special case: constant solution
+    if (fabs(rangeMax - rangeMin) < EPS_ZERO)
+        irange = 1.0;
 
-        // remove normals
-        delete [] normal;
+    QString rangeKey = QString("%1|%2|%3|solid|%4").
+            arg(rangeMin, 0, 'e', 16).
+            arg(rangeMax, 0, 'e', 16).
+            arg(rangeAuto).
+            arg(Agros2D::problem()->setting()->value(ProblemSetting::View_SolidViewHide).toStringList().join("|"));
+    if (rangeKey != m_arrayScalarFieldRangeKey)
+    {
+        createScalarFieldRangeArrays(rangeMin, rangeMax, true);
+        m_arrayScalarFieldRangeKey = rangeKey;
+    }
 
-        glDisable(GL_POLYGON_OFFSET_FILL);
-        glDisable(GL_LIGHTING);
+    // planar sides are scaled to depth, revolved sides depend on angle
+    QString sidesKey = QString("%1|%2|%3").
+            arg(rangeKey).
+            arg(planar).
+            arg(planar ? 0.0 : phi, 0, 'e', 16);
+    if (sidesKey != m_arraySolidSidesKey)
+    {
+        createSolidSidesArrays(phi);
+        m_arraySolidSidesKey = sidesKey;
+    }
 
-        if (!isModel)
-        {
-            glDisable(GL_TEXTURE_1D);
+    // palette and geometry
+    if (m_listScalarField3DSolid == -1)
+    {
+        paletteCreate();
 
-            // switch-off texture transform
-            glMatrixMode(GL_TEXTURE);
-            glLoadIdentity();
-            glMatrixMode(GL_MODELVIEW);
-        }
+        m_listScalarField3DSolid = glGenLists(1);
+        glNewList(m_listScalarField3DSolid, GL_COMPILE);
 
         // geometry
         if (Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DSolidGeometry).toBool())
@@ -799,18 +822,97 @@ void SceneViewPost3D::paintScalarField3DSolid()
             glDisable(GL_LINE_SMOOTH);
         }
 
-        glDisable(GL_DEPTH_TEST);
+        glEndList();
+    }
 
-        glPopMatrix();
+    glEnable(GL_DEPTH_TEST);
 
-        glEndList();
+    // set texture for coloring
+    if (!isModel)
+    {
+        glEnable(GL_TEXTURE_1D);
+        glBindTexture(GL_TEXTURE_1D, m_textureScalar);
+        glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
 
-        glCallList(m_listScalarField3DSolid);
+        // set texture transformation matrix (maps value to palette)
+        glMatrixMode(GL_TEXTURE);
+        glLoadIdentity();
+        glTranslated(m_texShift, 0.0, 0.0);
+        glScaled(m_texScale, 0.0, 0.0);
+        glScaled(irange, 1.0, 1.0);
+        glTranslated(m_arrayScalarFieldOffset - rangeMin, 0.0, 0.0);
+        glMatrixMode(GL_MODELVIEW);
     }
     else
     {
-        glCallList(m_listScalarField3DSolid);
+        glColor3d(0.7, 0.7, 0.7);
+        glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
     }
+
+    bool lighting = Agros2D::problem()->setting()->value(ProblemSetting::View_ScalarView3DLighting).toBool();
+    initLighting();
+    // normals are scaled with depth
+    if (lighting)
+        glEnable(GL_NORMALIZE);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    if (!isModel)
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    // faces - linearization moved to z = -+ depth / 2.0 (planar) or rotated to 0 and phi (axisymmetric)
+    glVertexPointer(2, GL_FLOAT, sizeof(QVector3D), m_arrayScalarField.constData());
+    if (!isModel)
+        glTexCoordPointer(1, GL_FLOAT, 0, m_arrayScalarFieldValues.constData());
+
+    for (int j = 0; j < 2; j++)
+    {
+        glPushMatrix();
+        if (planar)
+            glTranslated(0.0, 0.0, (j == 0) ? - depth / 2.0 : depth / 2.0);
+        else
+            glRotated(- j * phi, 0.0, 1.0, 0.0);
+
+        glNormal3d(0.0, 0.0, (j == 0) ? -1.0 : 1.0);
+        glDrawElements(GL_TRIANGLES, m_arrayScalarFieldIndicesRange.size(), GL_UNSIGNED_INT, m_arrayScalarFieldIndicesRange.constData());
+        glPopMatrix();
+    }
+
+    // sides
+    if (lighting)
+        glEnableClientState(GL_NORMAL_ARRAY);
+
+    glVertexPointer(3, GL_FLOAT, 0, m_arraySolidSides.constData());
+    if (lighting)
+        glNormalPointer(GL_FLOAT, 0, m_arraySolidSidesNormals.constData());
+    if (!isModel)
+        glTexCoordPointer(1, GL_FLOAT, 0, m_arraySolidSidesValues.constData());
+
+    glPushMatrix();
+    if (planar)
+        glScaled(1.0, 1.0, depth);
+    glDrawElements(GL_TRIANGLES, m_arraySolidSidesIndices.size(), GL_UNSIGNED_INT, m_arraySolidSidesIndices.constData());
+    glPopMatrix();
+
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    glDisable(GL_NORMALIZE);
+    glDisable(GL_LIGHTING);
+
+    if (!isModel)
+    {
+        glDisable(GL_TEXTURE_1D);
+
+        // switch-off texture transform
+        glMatrixMode(GL_TEXTURE);
+        glLoadIdentity();
+        glMatrixMode(GL_MODELVIEW);
+    }
+
+    glCallList(m_listScalarField3DSolid);
+
+    glDisable(GL_DEPTH_TEST);
 }
 
 void SceneViewPost3D::clearGLLists()
@@ -845,6 +947,8 @@ void SceneViewPost3D::setControls()
 
 void SceneViewPost3D::clear()
 {
+    clearArrays();
+
     SceneViewCommon3D::clear();
     if (Agros2D::problem()->isSolved())
         doZoomBestFit();
@@ -57,8 +57,35 @@ private:
     int m_listScalarField3DSolid;
     int m_listModel;
 
+    // scalar field - shared vertices (x, y, -value) with smooth normals, built once per linearization
+    QVector<QVector3D> m_arrayScalarField;
+    QVector<QVector3D> m_arrayScalarFieldNormals;
+    QVector<float> m_arrayScalarFieldValues;
+    QVector<GLuint> m_arrayScalarFieldIndices;
+    // position of vertex (ignores discontinuities of value) and label of triangle
+    QVector<int> m_arrayScalarFieldPoints;
+    QVector<int> m_arrayScalarFieldLabels;
+    int m_arrayScalarFieldVersion;
+    double m_arrayScalarFieldOffset;
+    // visible triangles and their boundary edges, depend on range and hidden materials
+    QVector<GLuint> m_arrayScalarFieldIndicesRange;
+    QVector<GLuint> m_arrayScalarFieldBoundary;
+    QString m_arrayScalarFieldRangeKey;
+
+    // solid - sides extruded (planar) or revolved (axisymmetric) from boundary edges
+    QVector<QVector3D> m_arraySolidSides;
+    QVector<QVector3D> m_arraySolidSidesNormals;
+    QVector<float> m_arraySolidSidesValues;
+    QVector<GLuint> m_arraySolidSidesIndices;
+    QString m_arraySolidSidesKey;
+
     void createActionsPost3D();
 
+    void createScalarFieldArrays();
+    void createScalarFieldRangeArrays(double rangeMin, double rangeMax, bool solid);
+    void createSolidSidesArrays(double phi);
+    void clearArrays();
+
 private slots:
     virtual void refresh();
     virtual void clearGLLists();
@@ -35,6 +35,7 @@ public:
     {
         Unknown,
         Config_LogStdOut,
+        Config_LogSolverIterations,
         Config_GUIStyle,
         Config_Locale,
         Config_ShowResults,
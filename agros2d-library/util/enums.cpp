@@ -35,6 +35,7 @@ static QMap<AdaptivityType, QString> adaptivityTypeList;
 static QMap<AdaptivityStoppingCriterionType, QString> adaptivityStoppingCriterionTypeList;
 static QMap<Hermes::Hermes2D::NormType, QString> adaptivityNormTypeList;
 static QMap<TimeStepMethod, QString> timeStepMethodList;
+static QMap<TimeStepEstimator, QString> timeStepEstimatorList;
 static QMap<SolutionMode, QString> solutionTypeList;
 static QMap<AnalysisType, QString> analysisTypeList;
 static QMap<CouplingType, QString> couplingTypeList;
@@ -98,6 +99,10 @@ QStringList timeStepMethodStringKeys() { return timeStepMethodList.values(); }
 QString timeStepMethodToStringKey(TimeStepMethod timeStepMethod) { return timeStepMethodList[timeStepMethod]; }
 TimeStepMethod timeStepMethodFromStringKey(const QString &timeStepMethod) { return timeStepMethodList.key(timeStepMethod); }
 
+QStringList timeStepEstimatorStringKeys() { return timeStepEstimatorList.values(); }
+QString timeStepEstimatorToStringKey(TimeStepEstimator timeStepEstimator) { return timeStepEstimatorList[timeStepEstimator]; }
+TimeStepEstimator timeStepEstimatorFromStringKey(const QString &timeStepEstimator) { return timeStepEstimatorList.key(timeStepEstimator); }
+
 QStringList solutionTypeStringKeys() { return solutionTypeList.values(); }
 QString solutionTypeToStringKey(SolutionMode solutionType) { return solutionTypeList[solutionType]; }
 SolutionMode solutionTypeFromStringKey(const QString &solutionType) { return solutionTypeList.key(solutionType); }
@@ -206,6 +211,9 @@ void initLists()
     //    timeStepMethodList.insert(TimeStepMethod_FixedBDF2B, "fixed_bdf2b");
     //    timeStepMethodList.insert(TimeStepMethod_FixedCombine, "fixed_combine");
 
+    timeStepEstimatorList.insert(TimeStepEstimator_Extrapolation, "extrapolation");
+    timeStepEstimatorList.insert(TimeStepEstimator_LowerOrder, "lower_order");
+
     // PHYSICFIELDVARIABLECOMP
     physicFieldVariableCompList.insert(PhysicFieldVariableComp_Scalar, "scalar");
     physicFieldVariableCompList.insert(PhysicFieldVariableComp_Magnitude, "magnitude");
@@ -484,6 +492,20 @@ QString timeStepMethodString(TimeStepMethod timeStepMethod)
     }
 }
 
+QString timeStepEstimatorString(TimeStepEstimator timeStepEstimator)
+{
+    switch (timeStepEstimator)
+    {
+    case TimeStepEstimator_Extrapolation:
+        return QObject::tr("Extrapolation (predictor)");
+    case TimeStepEstimator_LowerOrder:
+        return QObject::tr("Lower order solution");
+    default:
+        std::cerr << "Time step estimator '" + QString::number(timeStepEstimator).toStdString() + "' is not implemented. timeStepEstimatorString(TimeStepEstimator timeStepEstimator)" << endl;
+        throw;
+    }
+}
+
 QString weakFormString(WeakFormKind weakForm)
 {
     switch (weakForm)
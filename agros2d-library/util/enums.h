@@ -66,6 +66,13 @@ enum TimeStepMethod
     TimeStepMethod_BDFNumSteps = 2
 };
 
+enum TimeStepEstimator
+{
+    TimeStepEstimator_Undefined = -1,
+    TimeStepEstimator_Extrapolation = 0,
+    TimeStepEstimator_LowerOrder = 1
+};
+
 enum LinearityType
 {
     LinearityType_Undefined = -1,
@@ -302,6 +309,12 @@ AGROS_LIBRARY_API QStringList timeStepMethodStringKeys();
 AGROS_LIBRARY_API QString timeStepMethodToStringKey(TimeStepMethod timeStepMethod);
 AGROS_LIBRARY_API TimeStepMethod timeStepMethodFromStringKey(const QString &timeStepMethod);
 
+// time step error estimator
+AGROS_LIBRARY_API QString timeStepEstimatorString(TimeStepEstimator timeStepEstimator);
+AGROS_LIBRARY_API QStringList timeStepEstimatorStringKeys();
+AGROS_LIBRARY_API QString timeStepEstimatorToStringKey(TimeStepEstimator timeStepEstimator);
+AGROS_LIBRARY_API TimeStepEstimator timeStepEstimatorFromStringKey(const QString &timeStepEstimator);
+
 // solution mode
 AGROS_LIBRARY_API QString solutionTypeString(SolutionMode solutionMode);
 AGROS_LIBRARY_API QStringList solutionTypeStringKeys();
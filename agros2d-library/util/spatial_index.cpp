@@ -0,0 +1,109 @@
+// This file is part of Agros2D.
+//
+// Agros2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Agros2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Agros2D.  If not, see <http://www.gnu.org/licenses/>.
+//
+// hp-FEM group (http://hpfem.org/)
+// University of Nevada, Reno (UNR) and University of West Bohemia, Pilsen
+// Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
+
+#include "spatial_index.h"
+
+// maximum number of cells in one direction
+const int SPATIAL_INDEX_MAX_CELLS = 512;
+
+SpatialIndex::SpatialIndex()
+{
+    clear();
+}
+
+void SpatialIndex::clear()
+{
+    m_origin = Point();
+    m_cellSize = 1.0;
+    m_nx = 1;
+    m_ny = 1;
+    m_count = 0;
+
+    m_cells.clear();
+    m_cells.resize(1);
+}
+
+void SpatialIndex::setBounds(const RectPoint &rect, int count)
+{
+    clear();
+
+    double width = qMax(rect.width(), EPS_ZERO);
+    double height = qMax(rect.height(), EPS_ZERO);
+
+    // approximately one item per cell
+    m_cellSize = qMax(sqrt(width * height / qMax(count, 1)),
+                      qMax(width, height) / SPATIAL_INDEX_MAX_CELLS);
+    m_nx = qBound(1, int(ceil(width / m_cellSize)), SPATIAL_INDEX_MAX_CELLS);
+    m_ny = qBound(1, int(ceil(height / m_cellSize)), SPATIAL_INDEX_MAX_CELLS);
+    m_origin = Point(qMin(rect.start.x, rect.end.x), qMin(rect.start.y, rect.end.y));
+
+    m_cells.resize(m_nx * m_ny);
+}
+
+void SpatialIndex::insertCell(int item, int i, int j)
+{
+    QVector<int> &cell = m_cells[j * m_nx + i];
+    if (cell.isEmpty() || cell.last() != item)
+    {
+        cell.append(item);
+        m_count++;
+    }
+}
+
+void SpatialIndex::insert(int item, const Point &point)
+{
+    insertCell(item, cellX(point.x), cellY(point.y));
+}
+
+void SpatialIndex::insert(int item, const Point &start, const Point &end)
+{
+    // sample segment with half of the cell size
+    int steps = qMax(1, int(ceil(2.0 * (end - start).magnitude() / m_cellSize)));
+    for (int k = 0; k <= steps; k++)
+    {
+        Point point = start + (end - start) * (double(k) / steps);
+        insertCell(item, cellX(point.x), cellY(point.y));
+    }
+}
+
+void SpatialIndex::insert(int item, const QVector<Point> &polyline)
+{
+    if (polyline.count() == 1)
+        insert(item, polyline.first());
+
+    for (int k = 1; k < polyline.count(); k++)
+        insert(item, polyline[k - 1], polyline[k]);
+}
+
+void SpatialIndex::insert(int item, const RectPoint &rect)
+{
+    int i0 = cellX(qMin(rect.start.x, rect.end.x));
+    int i1 = cellX(qMax(rect.start.x, rect.end.x));
+    int j0 = cellY(qMin(rect.start.y, rect.end.y));
+    int j1 = cellY(qMax(rect.start.y, rect.end.y));
+
+    for (int j = j0; j <= j1; j++)
+        for (int i = i0; i <= i1; i++)
+            insertCell(item, i, j);
+}
+
+const QVector<int> &SpatialIndex::items(const Point &point) const
+{
+    return m_cells[cellY(point.y) * m_nx + cellX(point.x)];
+}
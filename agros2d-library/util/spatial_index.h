@@ -0,0 +1,110 @@
+// This file is part of Agros2D.
+//
+// Agros2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Agros2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Agros2D.  If not, see <http://www.gnu.org/licenses/>.
+//
+// hp-FEM group (http://hpfem.org/)
+// University of Nevada, Reno (UNR) and University of West Bohemia, Pilsen
+// Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
+
+#ifndef UTIL_SPATIAL_INDEX_H
+#define UTIL_SPATIAL_INDEX_H
+
+#include "util.h"
+
+// uniform grid of item indices, used for picking in large geometries
+class SpatialIndex
+{
+public:
+    SpatialIndex();
+
+    void clear();
+    inline bool isEmpty() const { return m_count == 0; }
+
+    // grid covering rect with approximately one cell per item
+    void setBounds(const RectPoint &rect, int count);
+
+    void insert(int item, const Point &point);
+    void insert(int item, const Point &start, const Point &end);
+    void insert(int item, const QVector<Point> &polyline);
+    void insert(int item, const RectPoint &rect);
+
+    // items registered in the cell containing point
+    const QVector<int> &items(const Point &point) const;
+
+    // closest item, distance(item) returns distance from point
+    template <typename Distance>
+    int nearest(const Point &point, Distance distance) const
+    {
+        if (m_count == 0)
+            return -1;
+
+        int ci = cellX(point.x);
+        int cj = cellY(point.y);
+        int rings = qMax(qMax(ci, m_nx - 1 - ci), qMax(cj, m_ny - 1 - cj));
+
+        QSet<int> visited;
+        int closest = -1;
+        double closestDistance = numeric_limits<double>::max();
+
+        for (int r = 0; r <= rings; r++)
+        {
+            for (int j = cj - r; j <= cj + r; j++)
+            {
+                if (j < 0 || j >= m_ny) continue;
+
+                // inner cells were searched in previous rings
+                int step = (j == cj - r || j == cj + r) ? 1 : qMax(2 * r, 1);
+                for (int i = ci - r; i <= ci + r; i += step)
+                {
+                    if (i < 0 || i >= m_nx) continue;
+
+                    foreach (int item, m_cells[j * m_nx + i])
+                    {
+                        if (visited.contains(item)) continue;
+                        visited.insert(item);
+
+                        double itemDistance = distance(item);
+                        if (itemDistance < closestDistance)
+                        {
+                            closestDistance = itemDistance;
+                            closest = item;
+                        }
+                    }
+                }
+            }
+
+            // remaining items are at least (r - 1) cells away
+            if (closest != -1 && closestDistance <= (r - 1) * m_cellSize)
+                break;
+        }
+
+        return closest;
+    }
+
+private:
+    Point m_origin;
+    double m_cellSize;
+    int m_nx;
+    int m_ny;
+    int m_count;
+
+    QVector<QVector<int> > m_cells;
+
+    inline int cellX(double x) const { return qBound(0, int(floor((x - m_origin.x) / m_cellSize)), m_nx - 1); }
+    inline int cellY(double y) const { return qBound(0, int(floor((y - m_origin.y) / m_cellSize)), m_ny - 1); }
+
+    void insertCell(int item, int i, int j);
+};
+
+#endif // UTIL_SPATIAL_INDEX_H
@@ -30,8 +30,31 @@
 
 #include "gui/lineeditdouble.h"
 
+// writes one rendered frame in the frame pool
+class VideoFrameWriter : public QRunnable
+{
+public:
+    VideoFrameWriter(VideoDialog *dialog, QSemaphore *frameSlots, const QImage &image, const QString &fileName)
+        : m_dialog(dialog), m_slots(frameSlots), m_image(image), m_fileName(fileName) {}
+
+    virtual void run()
+    {
+        if (!m_image.save(m_fileName, "PNG"))
+            QMetaObject::invokeMethod(m_dialog, "frameFailed", Qt::QueuedConnection, Q_ARG(QString, m_fileName));
+
+        m_slots->release();
+    }
+
+private:
+    VideoDialog *m_dialog;
+    QSemaphore *m_slots;
+    QImage m_image;
+    QString m_fileName;
+};
+
 VideoDialog::VideoDialog(SceneViewPostInterface *sceneViewInterface, PostHermes *postHermes, QWidget *parent)
-    : QDialog(parent), m_sceneViewInterface(sceneViewInterface), m_postHermes(postHermes)
+    : QDialog(parent), m_sceneViewInterface(sceneViewInterface), m_postHermes(postHermes),
+      m_animationFrames(0), m_frameSlots(2 * QThread::idealThreadCount())
 {
     setModal(true);
     setWindowIcon(icon("video"));
@@ -57,6 +80,8 @@ VideoDialog::VideoDialog(SceneViewPostInterface *sceneViewInterface, PostHermes
 
 VideoDialog::~VideoDialog()
 {
+    waitForFrames();
+
     QSettings settings;
     settings.setValue("VideoDialog/ShowGrid", chkFigureShowGrid->isChecked());
     settings.setValue("VideoDialog/ShowRulers", chkFigureShowRulers->isChecked());
@@ -71,7 +96,7 @@ VideoDialog::~VideoDialog()
     Agros2D::configComputer()->setValue(Config::Config_ShowGrid, m_showGridStore);
     Agros2D::configComputer()->setValue(Config::Config_ShowAxes, m_showAxesStore);
 
-    m_postHermes->refresh();
+    m_postHermes->refreshAsync();
 
     delete timer;
 }
@@ -242,15 +267,20 @@ void VideoDialog::transientAnimate()
 
         timer->stop();
         btnGenerate->setText(tr("Run"));
+
+        waitForFrames();
+        printFrameRate();
     }
     else
     {
-        setTransientStep(0);
-
         btnClose->setEnabled(false);
 
         btnGenerate->setText(tr("Stop"));
         timer->start(0.0);
+        startFrameRate();
+
+        // next steps are prefetched while the timer is active
+        setTransientStep(0);
     }
 }
 
@@ -268,16 +298,23 @@ void VideoDialog::transientAnimateNextStep()
 
 void VideoDialog::setTransientStep(int transientStep)
 {
+    if (timer->isActive())
+        m_animationFrames++;
+
     Agros2D::configComputer()->setValue(Config::Config_ShowRulers, chkFigureShowRulers->isChecked());
     Agros2D::configComputer()->setValue(Config::Config_ShowGrid, chkFigureShowGrid->isChecked());
     Agros2D::configComputer()->setValue(Config::Config_ShowAxes, chkFigureShowAxes->isChecked());
 
     m_postHermes->setActiveTimeStep(transientStep);
     m_postHermes->setActiveAdaptivityStep(Agros2D::solutionStore()->lastAdaptiveStep(m_postHermes->activeViewField(), SolutionMode_Normal, transientStep));
-    m_postHermes->refresh();
+    refreshPostHermes();
+
+    // next frame is linearized while this one is saved and shown
+    if (timer->isActive() && transientStep < m_timeSteps)
+        m_postHermes->prefetch(transientStep + 1, Agros2D::solutionStore()->lastAdaptiveStep(m_postHermes->activeViewField(), SolutionMode_Normal, transientStep + 1));
 
     if (chkSaveImages->isChecked())
-        m_sceneViewInterface->saveImageToFile(tempProblemDir() + QString("/video/video_%1.png").arg(QString("0000000" + QString::number(transientStep)).right(8)));
+        saveFrame(tempProblemDir() + QString("/video/video_%1.png").arg(QString("0000000" + QString::number(transientStep)).right(8)));
 
     sliderTransientAnimate->setValue(transientStep);
 
@@ -288,6 +325,51 @@ void VideoDialog::setTransientStep(int transientStep)
     QApplication::processEvents();
 }
 
+void VideoDialog::refreshPostHermes()
+{
+    // generated frames need the processed views, scrubbing cancels stale steps
+    if (timer->isActive() || chkSaveImages->isChecked())
+        m_postHermes->refresh();
+    else
+        m_postHermes->refreshAsync();
+}
+
+void VideoDialog::saveFrame(const QString &fileName)
+{
+    // encoding runs in the frame pool, the next frame is rendered meanwhile
+    m_frameSlots.acquire();
+    m_framePool.start(new VideoFrameWriter(this, &m_frameSlots, m_sceneViewInterface->renderSceneImage(), fileName));
+}
+
+void VideoDialog::waitForFrames()
+{
+    m_framePool.waitForDone();
+}
+
+void VideoDialog::startFrameRate()
+{
+    m_animationFrames = 0;
+    m_animationTime.start();
+}
+
+void VideoDialog::printFrameRate()
+{
+    // frames are rendered, prefetched and encoded (when saved)
+    double elapsed = m_animationTime.elapsed() / 1000.0;
+    if (m_animationFrames == 0 || elapsed <= 0.0)
+        return;
+
+    Agros2D::log()->printMessage(tr("Video"), tr("%1 frames in %2 s (%3 fps)").
+                                 arg(m_animationFrames).
+                                 arg(elapsed, 0, 'f', 2).
+                                 arg(m_animationFrames / elapsed, 0, 'f', 1));
+}
+
+void VideoDialog::frameFailed(const QString &fileName)
+{
+    Agros2D::log()->printError(tr("Video"), tr("Image cannot be saved to the file '%1'.").arg(fileName));
+}
+
 void VideoDialog::adaptiveAnimate()
 {
     if (timer->isActive())
@@ -296,15 +378,20 @@ void VideoDialog::adaptiveAnimate()
 
         timer->stop();
         btnGenerate->setText(tr("Generate"));
+
+        waitForFrames();
+        printFrameRate();
     }
     else
     {
-        setAdaptiveStep(1);
-
         btnClose->setEnabled(false);
 
         btnGenerate->setText(tr("Stop"));
         timer->start(0.0);
+        startFrameRate();
+
+        // next steps are prefetched while the timer is active
+        setAdaptiveStep(1);
     }
 }
 
@@ -318,30 +405,41 @@ void VideoDialog::adaptiveAnimateNextStep()
 
 void VideoDialog::setAdaptiveStep(int adaptiveStep)
 {
+    if (timer->isActive())
+        m_animationFrames++;
+
     Agros2D::configComputer()->setValue(Config::Config_ShowRulers, chkFigureShowRulers->isChecked());
     Agros2D::configComputer()->setValue(Config::Config_ShowGrid, chkFigureShowGrid->isChecked());
     Agros2D::configComputer()->setValue(Config::Config_ShowAxes, chkFigureShowAxes->isChecked());
 
     m_postHermes->setActiveAdaptivityStep(adaptiveStep - 1);
-    m_postHermes->refresh();
+    refreshPostHermes();
+
+    // next frame is linearized while this one is saved and shown
+    if (timer->isActive() && adaptiveStep < m_adaptiveSteps)
+        m_postHermes->prefetch(m_postHermes->activeTimeStep(), adaptiveStep);
 
     sliderAdaptiveAnimate->setValue(adaptiveStep);
     lblAdaptiveStep->setText(QString("%1 / %2").arg(adaptiveStep).arg(m_adaptiveSteps));
 
     if (chkSaveImages->isChecked())
-        m_sceneViewInterface->saveImageToFile(tempProblemDir() + QString("/video/video_%1.png").arg(QString("0000000" + QString::number(adaptiveStep)).right(8)));
+        saveFrame(tempProblemDir() + QString("/video/video_%1.png").arg(QString("0000000" + QString::number(adaptiveStep)).right(8)));
 
     QApplication::processEvents();
 }
 
 void VideoDialog::doVideo()
 {
+    waitForFrames();
+
     ImageSequenceDialog video;
     video.exec();
 }
 
 void VideoDialog::doOpenFolder()
 {
+    waitForFrames();
+
     QDesktopServices::openUrl(QUrl(QString("file:///%1/video").arg(tempProblemDir()), QUrl::TolerantMode));
 }
 
@@ -57,6 +57,14 @@ private:
 
     QTimer *timer;
 
+    // frame rate of the running animation (printed when it stops)
+    QElapsedTimer m_animationTime;
+    int m_animationFrames;
+
+    // png encoding of the frames, number of frames waiting for the encoding is limited
+    QThreadPool m_framePool;
+    QSemaphore m_frameSlots;
+
     // file
     QPushButton *btnClose;
     QPushButton *btnGenerate;
@@ -79,6 +87,12 @@ private:
     QWidget *createControlsViewportAdaptiveSteps();
     QWidget *createControlsViewportTimeSteps();
 
+    void refreshPostHermes();
+    void saveFrame(const QString &fileName);
+    void waitForFrames();
+    void startFrameRate();
+    void printFrameRate();
+
 private slots:
     void adaptiveAnimate();
     void adaptiveAnimateNextStep();
@@ -88,6 +102,8 @@ private slots:
     void transientAnimateNextStep();
     void setTransientStep(int transientStep);
 
+    void frameFailed(const QString &fileName);
+
     void doClose();
     void doVideo();
     void doOpenFolder();
@@ -17,67 +17,193 @@
 // University of Nevada, Reno (UNR) and University of West Bohemia, Pilsen
 // Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
 
-#include "client.h"
 
-const QString OK_STRING = "\nOK\n";
+#include "client.h"
 
-Client::Client(const QString &IP, int port) : m_IP(IP), m_port(port)
+Client::Client(const QString &IP, int port) : m_IP(IP), m_port(port), m_lastRequestId(0)
 {
     m_tcpSocket = new QTcpSocket(this);
-
-    connect(m_tcpSocket, SIGNAL(readyRead()), this, SLOT(readResult()));
-    connect(m_tcpSocket, SIGNAL(error(QAbstractSocket::SocketError)), this, SLOT(displayError(QAbstractSocket::SocketError)));
-    connect(m_tcpSocket, SIGNAL(disconnected()), this, SLOT(disconnected()));
 }
 
 Client::~Client()
 {
+    close();
     delete m_tcpSocket;
-    delete m_networkSession;
 }
 
-bool Client::run(const QString &command)
+bool Client::open()
 {
     m_tcpSocket->abort();
     m_tcpSocket->connectToHost(m_IP, m_port);
-    if (m_tcpSocket->waitForConnected(1000))
+    if (!m_tcpSocket->waitForConnected(1000))
     {
-        m_tcpSocket->write(QString(command).toLatin1());
-        return true;
+        displayError();
+        return false;
+    }
+
+    m_tcpSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+    // handshake
+    m_tcpSocket->write(RemoteProtocol::handshake());
+    while (m_buffer.size() < RemoteProtocol::HANDSHAKE_SIZE)
+    {
+        if (!m_tcpSocket->waitForReadyRead(5000))
+        {
+            cout << tr("Client error: Server does not support the framed protocol.").toStdString() << endl;
+            return false;
+        }
+        m_buffer.append(m_tcpSocket->readAll());
     }
-    else
+
+    if (m_buffer.left(RemoteProtocol::HANDSHAKE_SIZE) != RemoteProtocol::handshake())
     {
-        qDebug() << "Cannot connect to the Agros2D server.";
+        cout << tr("Client error: Protocol version mismatch.").toStdString() << endl;
         return false;
     }
+    m_buffer.remove(0, RemoteProtocol::HANDSHAKE_SIZE);
+
+    return true;
 }
 
-void Client::readResult()
+void Client::close()
 {
-    if (m_tcpSocket->bytesAvailable() > 0)
+    if (m_tcpSocket->state() == QAbstractSocket::ConnectedState)
     {
-        QString out = QString(m_tcpSocket->readAll());
-        m_result = out.left(out.indexOf(OK_STRING));
+        m_tcpSocket->disconnectFromHost();
+        if (m_tcpSocket->state() != QAbstractSocket::UnconnectedState)
+            m_tcpSocket->waitForDisconnected(1000);
     }
-    m_tcpSocket->close();
 }
 
-void Client::connected()
+quint32 Client::send(quint8 type, const QByteArray &payload)
 {
-    m_result = "";
+    quint32 id = ++m_lastRequestId;
+    m_tcpSocket->write(RemoteProtocol::encode(RemoteProtocol::Message(type, id, payload)));
+
+    return id;
 }
 
-void Client::disconnected()
+bool Client::receive(RemoteProtocol::Message &message, int timeout)
 {
-    if (!m_result.isEmpty())
-        qDebug() << m_result;
+    bool error = false;
+    while (!RemoteProtocol::decode(m_buffer, message, &error))
+    {
+        if (error || !m_tcpSocket->waitForReadyRead(timeout))
+        {
+            displayError();
+            return false;
+        }
+        m_buffer.append(m_tcpSocket->readAll());
+    }
 
-    exit(0);
+    return true;
 }
 
-void Client::displayError(QAbstractSocket::SocketError socketError)
+bool Client::run(const QString &command)
 {
-    switch (socketError)
+    quint32 id = send(RemoteProtocol::Request_Script, command.toUtf8());
+
+    RemoteProtocol::Message message;
+    while (receive(message))
+    {
+        if (message.id != id)
+            continue;
+
+        QString out = QString::fromUtf8(message.payload);
+        if (!out.isEmpty())
+            cout << out.toStdString() << endl;
+
+        return (message.type == RemoteProtocol::Response_Ok);
+    }
+
+    return false;
+}
+
+bool Client::array(const QString &script, const QString &variable, QVector<double> &values)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream << script << variable;
+
+    quint32 id = send(RemoteProtocol::Request_Array, payload);
+
+    RemoteProtocol::Message message;
+    while (receive(message))
+    {
+        if (message.id != id)
+            continue;
+
+        if (message.type != RemoteProtocol::Response_Array)
+        {
+            cout << QString::fromUtf8(message.payload).toStdString() << endl;
+            return false;
+        }
+
+        values = RemoteProtocol::decodeArray(message.payload);
+        return true;
+    }
+
+    return false;
+}
+
+double Client::measure(int count, int window, quint8 type, const QByteArray &payload)
+{
+    QTime time;
+    time.start();
+
+    // keep up to window requests in flight
+    int sent = 0;
+    int received = 0;
+    RemoteProtocol::Message message;
+    while (received < count)
+    {
+        while (sent < count && sent - received < window)
+        {
+            send(type, payload);
+            sent++;
+        }
+        m_tcpSocket->flush();
+
+        if (!receive(message, 30000))
+            return 0.0;
+        received++;
+    }
+
+    return count / (qMax(time.elapsed(), 1) / 1000.0);
+}
+
+void Client::benchmark(int count, int window, const QString &script)
+{
+    cout << tr("Benchmark: %1 requests, window %2").arg(count).arg(window).toStdString() << endl;
+
+    // network and framing only
+    double ping = measure(count, window, RemoteProtocol::Request_Ping, QByteArray());
+    cout << tr("  ping:   %1 requests/s").arg(ping, 0, 'f', 0).toStdString() << endl;
+
+    // job queue and Python engine
+    double scriptRate = measure(count, window, RemoteProtocol::Request_Script, script.toUtf8());
+    cout << tr("  script: %1 requests/s ('%2')").arg(scriptRate, 0, 'f', 0).arg(script).toStdString() << endl;
+
+    // unframed protocol, one connection per request (server is left in legacy mode per connection)
+    int legacyCount = qMin(count, 1000);
+    QTime time;
+    time.start();
+    for (int i = 0; i < legacyCount; i++)
+    {
+        QTcpSocket socket;
+        socket.connectToHost(m_IP, m_port);
+        if (!socket.waitForConnected(1000))
+            break;
+        socket.write(script.toLatin1());
+        while (socket.state() == QAbstractSocket::ConnectedState && socket.waitForReadyRead(30000))
+            socket.readAll();
+    }
+    cout << tr("  legacy: %1 requests/s (connection per request)").arg(legacyCount / (qMax(time.elapsed(), 1) / 1000.0), 0, 'f', 0).toStdString() << endl;
+}
+
+void Client::displayError()
+{
+    switch (m_tcpSocket->error())
     {
     case QAbstractSocket::HostNotFoundError:
         cout << tr("Client error: The host was not found.").toStdString() << endl;
@@ -88,6 +214,4 @@ void Client::displayError(QAbstractSocket::SocketError socketError)
     default:
         cout << tr("Client error: %1").arg(m_tcpSocket->errorString()).toStdString() << endl;
     }
-    exit(0);
 }
-
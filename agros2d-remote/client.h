@@ -17,6 +17,7 @@
 // University of Nevada, Reno (UNR) and University of West Bohemia, Pilsen
 // Email: agros2d@googlegroups.com, home page: http://hpfem.org/agros2d/
 
+
 #ifndef CLIENT_H
 #define CLIENT_H
 
@@ -25,9 +26,9 @@
 
 #include <iostream>
 
-using namespace std;
+#include "pythonlab/remotecontrol.h"
 
-class QLocalSocket;
+using namespace std;
 
 class Client : QObject
 {
@@ -37,23 +38,31 @@ public:
     Client(const QString &IP, int port);
     ~Client();
 
-    bool run(const QString &command);
+    // persistent session
+    bool open();
+    void close();
 
-private slots:   
-    void connected();
-    void readResult();
-    void disconnected();
+    // runs script, prints stdout or error
+    bool run(const QString &command);
+    // evaluates script and returns values of variable
+    bool array(const QString &script, const QString &variable, QVector<double> &values);
 
-    void displayError(QAbstractSocket::SocketError socketError);
+    // loopback benchmark (pipelined requests)
+    void benchmark(int count, int window, const QString &script);
 
 private:
     QString m_IP;
     int m_port;
 
-    QString m_result;
-
     QTcpSocket *m_tcpSocket;
-    QNetworkSession *m_networkSession;
+    QByteArray m_buffer;
+    quint32 m_lastRequestId;
+
+    quint32 send(quint8 type, const QByteArray &payload);
+    bool receive(RemoteProtocol::Message &message, int timeout = -1);
+    double measure(int count, int window, quint8 type, const QByteArray &payload);
+
+    void displayError();
 };
 
 #endif
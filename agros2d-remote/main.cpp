@@ -35,11 +35,17 @@ int main(int argc, char *argv[])
         TCLAP::ValueArg<int> portArg("p", "port", "Port", true, 14000, "int");
         TCLAP::ValueArg<std::string> commandArg("c", "command", "Run command", false, "", "string");
         TCLAP::ValueArg<std::string> scriptArg("s", "script", "Script filename", false, "", "string");
+        TCLAP::ValueArg<std::string> arrayArg("a", "array", "Print values of the variable after the script (binary array)", false, "", "string");
+        TCLAP::ValueArg<int> benchmarkArg("b", "benchmark", "Loopback benchmark (number of requests)", false, 0, "int");
+        TCLAP::ValueArg<int> windowArg("w", "window", "Number of pipelined requests in flight (benchmark)", false, 32, "int");
 
         cmd.add(ipArg);
         cmd.add(portArg);
         cmd.add(commandArg);
         cmd.add(scriptArg);
+        cmd.add(arrayArg);
+        cmd.add(benchmarkArg);
+        cmd.add(windowArg);
 
         // parse the argv array.
         cmd.parse(argc, argv);
@@ -48,16 +54,13 @@ int main(int argc, char *argv[])
         QCoreApplication a(argc, argv);
         Client *client = new Client(QString::fromStdString(ipArg.getValue()), portArg.getValue());
 
+        QString script;
         if (!commandArg.getValue().empty())
         {
-            // run command
-            client->run(QString::fromStdString(commandArg.getValue()));
-            return a.exec();
+            script = QString::fromStdString(commandArg.getValue());
         }
         else if (!scriptArg.getValue().empty())
         {
-            QString script;
-
             QFile file(QString::fromStdString(scriptArg.getValue()));
             if (file.open(QFile::ReadOnly | QFile::Text))
             {
@@ -68,22 +71,36 @@ int main(int argc, char *argv[])
                 qDebug() << file.errorString();
             }
             file.close();
+        }
 
-            // run script
-            if (!script.isEmpty())
-            {
-                client->run(script);
-                return a.exec();
-            }
-            else
+        if (!client->open())
+            return 1;
+
+        int result = 1;
+        if (benchmarkArg.getValue() > 0)
+        {
+            client->benchmark(benchmarkArg.getValue(), qMax(1, windowArg.getValue()), script.isEmpty() ? "a = 1" : script);
+            result = 0;
+        }
+        else if (!arrayArg.getValue().empty())
+        {
+            // run script and read variable
+            QVector<double> values;
+            if (client->array(script, QString::fromStdString(arrayArg.getValue()), values))
             {
-                return 1;
+                foreach (double value, values)
+                    cout << QString::number(value, 'g', 16).toStdString() << endl;
+                result = 0;
             }
         }
-        else
+        else if (!script.isEmpty())
         {
-            return 1;
+            // run script
+            result = client->run(script) ? 0 : 1;
         }
+
+        delete client;
+        return result;
     }
     catch (TCLAP::ArgException &e)
     {
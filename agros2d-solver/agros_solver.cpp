@@ -21,19 +21,43 @@
 
 #include "util/global.h"
 #include "util/checkversion.h"
+#include "util/conf.h"
 
 #include "scenenode.h"
 #include "logview.h"
 #include "pythonlab/pythonengine_agros.h"
 
 #include "hermes2d.h"
+#include "hermes2d/problem.h"
 
-AgrosSolver::AgrosSolver(int &argc, char **argv)
-    : AgrosApplication(argc, argv), m_log(NULL), m_enableLog(false)
+// prefix of result records written by batch workers to stdout
+const QString BATCH_RESULT = "BATCH_RESULT";
+
+BatchVariant::BatchVariant(const QString &line, const QDir &dir)
+{
+    QStringList items = line.split("\t");
+
+    if (items.count() > 0) id = items.at(0).trimmed();
+    if (items.count() > 1) fileName = items.at(1).trimmed();
+    if (items.count() > 2) overrides = items.at(2).trimmed();
+    if (items.count() > 3) results = items.at(3).trimmed();
+
+    if (!fileName.isEmpty() && QFileInfo(fileName).isRelative())
+        fileName = QFileInfo(dir, fileName).absoluteFilePath();
+}
+
+QString BatchVariant::toString() const
+{
+    return QString("%1\t%2\t%3\t%4").arg(id).arg(fileName).arg(overrides).arg(results);
+}
+
+AgrosSolver::AgrosSolver(int &argc, char **argv, bool checkVersion)
+    : AgrosApplication(argc, argv), m_log(NULL), m_enableLog(false), m_batchWorkers(1), m_batchThreads(0), m_batchFailed(0)
 {    
     createPythonEngine(new PythonEngineAgros());
 
-    checkForNewVersion(true, true);
+    if (checkVersion)
+        checkForNewVersion(true, true);
 }
 
 AgrosSolver::~AgrosSolver()
@@ -196,6 +220,309 @@ void AgrosSolver::printTestSuites()
     QApplication::exit(0);
 }
 
+void AgrosSolver::runBatch()
+{
+    // log stdout
+    if (m_enableLog)
+        m_log = new LogStdOut();
+
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qCritical() << tr("Batch manifest '%1' cannot be opened (%2).").arg(m_fileName).arg(file.errorString());
+        QApplication::exit(-1);
+        return;
+    }
+
+    // manifest
+    QDir dir = QFileInfo(m_fileName).absoluteDir();
+    QTextStream in(&file);
+    while (!in.atEnd())
+    {
+        QString line = in.readLine();
+        if (line.trimmed().isEmpty() || line.trimmed().startsWith("#"))
+            continue;
+
+        BatchVariant variant(line, dir);
+        if (variant.isValid())
+            m_batchQueue.append(variant);
+        else
+            qWarning() << tr("Invalid batch line: %1").arg(line);
+    }
+    file.close();
+
+    if (m_batchOutputFileName.isEmpty())
+        m_batchOutputFileName = QString("%1/%2.out").arg(dir.absolutePath()).arg(QFileInfo(m_fileName).baseName());
+
+    m_batchOutputFile.setFileName(m_batchOutputFileName);
+    if (!m_batchOutputFile.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        qCritical() << tr("Batch output '%1' cannot be opened (%2).").arg(m_batchOutputFileName).arg(m_batchOutputFile.errorString());
+        QApplication::exit(-1);
+        return;
+    }
+    writeBatchRecord("# id\tstatus\ttime [ms]\tresults");
+
+    Agros2D::log()->printMessage(tr("Batch"), tr("%1 variants, %2 worker(s)").arg(m_batchQueue.count()).arg(m_batchWorkers));
+
+    if (m_batchWorkers == 1)
+    {
+        // single worker - solve in this process
+        Agros2D::problem()->setReuseInitialMesh(true);
+        while (!m_batchQueue.isEmpty())
+            writeBatchRecord(solveVariant(m_batchQueue.takeFirst()));
+
+        finishBatch();
+        return;
+    }
+
+    // worker processes (plugins and modules stay loaded for the whole batch)
+    m_batchWorkers = qMin(m_batchWorkers, m_batchQueue.count());
+    for (int i = 0; i < m_batchWorkers; i++)
+        startBatchWorker();
+
+    if (m_batchRunning.isEmpty())
+    {
+        failRemainingVariants();
+        finishBatch();
+    }
+}
+
+bool AgrosSolver::startBatchWorker()
+{
+    // assembly threads of this process are shared by the workers
+    int threads = qMax(1, Agros2D::configComputer()->value(Config::Config_NumberOfThreads).toInt() / m_batchWorkers);
+
+    QStringList args;
+    args << "--batch-worker" << "--threads" << QString::number(threads);
+    if (m_enableLog)
+        args << "--enable-log";
+
+    QProcess *worker = new QProcess(this);
+    worker->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    connect(worker, SIGNAL(readyReadStandardOutput()), this, SLOT(batchWorkerReadyRead()));
+    connect(worker, SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(batchWorkerFinished(int, QProcess::ExitStatus)));
+    connect(worker, SIGNAL(error(QProcess::ProcessError)), this, SLOT(batchWorkerError(QProcess::ProcessError)));
+
+    // finished() is never emitted for a worker that did not start, variant is assigned to running workers only
+    worker->start(QApplication::applicationFilePath(), args);
+    if (!worker->waitForStarted())
+        return false;
+
+    dispatchBatchVariant(worker);
+    return true;
+}
+
+void AgrosSolver::runBatchWorker()
+{
+    // log stdout
+    if (m_enableLog)
+        m_log = new LogStdOut();
+
+    // silent mode
+    setSilentMode(true);
+
+    // assembly threads are divided among the workers (not saved)
+    if (m_batchThreads > 0)
+    {
+        Agros2D::configComputer()->setValue(Config::Config_NumberOfThreads, m_batchThreads);
+        Hermes::HermesCommonApi.set_integral_param_value(Hermes::numThreads, m_batchThreads);
+    }
+
+    Agros2D::problem()->setReuseInitialMesh(true);
+
+    // one variant per line, result records go to stdout
+    std::string line;
+    while (std::getline(std::cin, line))
+    {
+        BatchVariant variant(QString::fromStdString(line), QDir::current());
+        if (!variant.isValid())
+            continue;
+
+        QString record = solveVariant(variant);
+        std::cout << QString("%1\t%2").arg(BATCH_RESULT).arg(record).toStdString() << std::endl;
+    }
+
+    Agros2D::scene()->clear();
+    Agros2D::clear();
+    QApplication::exit(0);
+}
+
+QString AgrosSolver::solveVariant(const BatchVariant &variant)
+{
+    QTime time;
+    time.start();
+
+    QString error;
+    try
+    {
+        Agros2D::scene()->readFromFile(variant.fileName);
+
+        // parameter overrides
+        if (!variant.overrides.isEmpty() && !currentPythonEngineAgros()->runScript(variant.overrides))
+        {
+            ErrorResult result = currentPythonEngineAgros()->parseError();
+            throw AgrosException(tr("Overrides: %1").arg(result.error()));
+        }
+
+        Agros2D::problem()->solve(true);
+        if (!Agros2D::problem()->isSolved())
+            throw AgrosException(tr("Problem was not solved"));
+
+        // results
+        QStringList values;
+        foreach (QString item, variant.results.split(";", QString::SkipEmptyParts))
+        {
+            QString name = item.section("=", 0, 0).trimmed();
+            QString expression = item.section("=", 1).trimmed();
+
+            double value = 0.0;
+            if (currentPythonEngineAgros()->runExpression(expression, &value))
+                values.append(QString("%1=%2").arg(name).arg(value, 0, 'g', 12));
+            else
+                values.append(QString("%1=nan").arg(name));
+        }
+
+        return QString("%1\tok\t%2\t%3").arg(variant.id).arg(time.elapsed()).arg(values.join("\t"));
+    }
+    catch (AgrosException &e)
+    {
+        error = e.toString();
+    }
+    catch (Hermes::Exceptions::Exception &e)
+    {
+        error = QString("Hermes exception thrown: %1").arg(e.info().c_str());
+    }
+    catch (std::exception &e)
+    {
+        error = QString("Exception thrown: %1").arg(e.what());
+    }
+    catch (...)
+    {
+        error = QString("Unknown exception thrown");
+    }
+
+    // failed variant, the batch continues
+    Agros2D::log()->printError(tr("Batch"), error);
+    return QString("%1\terror\t%2\t%3").arg(variant.id).arg(time.elapsed()).arg(error.simplified());
+}
+
+void AgrosSolver::writeBatchRecord(const QString &record)
+{
+    if (record.section("\t", 1, 1) == "error")
+        m_batchFailed++;
+
+    m_batchOutputFile.write(QString("%1\n").arg(record).toUtf8());
+    m_batchOutputFile.flush();
+}
+
+void AgrosSolver::dispatchBatchVariant(QProcess *worker)
+{
+    if (m_batchQueue.isEmpty())
+    {
+        // no more work
+        m_batchRunning.remove(worker);
+        worker->closeWriteChannel();
+        return;
+    }
+
+    BatchVariant variant = m_batchQueue.takeFirst();
+    m_batchRunning[worker] = variant;
+    worker->write(QString("%1\n").arg(variant.toString()).toUtf8());
+}
+
+void AgrosSolver::batchWorkerReadyRead()
+{
+    QProcess *worker = qobject_cast<QProcess *>(sender());
+    assert(worker);
+
+    m_batchBuffers[worker].append(worker->readAllStandardOutput());
+
+    int index;
+    while ((index = m_batchBuffers[worker].indexOf('\n')) >= 0)
+    {
+        QString line = QString::fromUtf8(m_batchBuffers[worker].left(index));
+        m_batchBuffers[worker].remove(0, index + 1);
+
+        if (line.startsWith(BATCH_RESULT + "\t"))
+        {
+            writeBatchRecord(line.mid(BATCH_RESULT.length() + 1));
+            dispatchBatchVariant(worker);
+        }
+        else if (m_enableLog)
+        {
+            std::cout << line.toStdString() << std::endl;
+        }
+    }
+}
+
+void AgrosSolver::batchWorkerFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    QProcess *worker = qobject_cast<QProcess *>(sender());
+    assert(worker);
+
+    // variant in progress is lost
+    if (m_batchRunning.contains(worker))
+    {
+        BatchVariant variant = m_batchRunning.take(worker);
+        writeBatchRecord(QString("%1\terror\t0\tWorker terminated (exit code %2)").arg(variant.id).arg(exitCode));
+    }
+
+    m_batchBuffers.remove(worker);
+    worker->deleteLater();
+
+    // crashed worker is replaced, its variant was reported
+    if (!m_batchQueue.isEmpty() && startBatchWorker())
+        return;
+
+    // all workers finished
+    bool running = false;
+    foreach (QProcess *process, findChildren<QProcess *>())
+        if (process != worker && process->state() != QProcess::NotRunning)
+            running = true;
+
+    if (!running)
+    {
+        failRemainingVariants();
+        finishBatch();
+    }
+}
+
+void AgrosSolver::batchWorkerError(QProcess::ProcessError error)
+{
+    // crashes are reported by batchWorkerFinished
+    if (error != QProcess::FailedToStart)
+        return;
+
+    QProcess *worker = qobject_cast<QProcess *>(sender());
+    assert(worker);
+
+    Agros2D::log()->printError(tr("Batch"), tr("Worker cannot be started (%1)").arg(worker->errorString()));
+
+    // no variant was assigned, remaining variants stay in the queue for running workers
+    m_batchRunning.remove(worker);
+    m_batchBuffers.remove(worker);
+    worker->deleteLater();
+}
+
+void AgrosSolver::failRemainingVariants()
+{
+    // no worker available (all workers crashed or cannot be started)
+    while (!m_batchQueue.isEmpty())
+        writeBatchRecord(QString("%1\terror\t0\tNo worker available").arg(m_batchQueue.takeFirst().id));
+}
+
+void AgrosSolver::finishBatch()
+{
+    m_batchOutputFile.close();
+
+    Agros2D::log()->printMessage(tr("Batch"), tr("Results written to '%1' (%2 failed)").arg(m_batchOutputFileName).arg(m_batchFailed));
+
+    Agros2D::scene()->clear();
+    Agros2D::clear();
+    QApplication::exit(m_batchFailed > 0 ? 1 : 0);
+}
+
 void AgrosSolver::stdOut(const QString &str)
 {
     std::cout << str.toStdString();
@@ -25,12 +25,28 @@
 
 class LogStdOut;
 
+// one problem variant of the batch manifest
+struct BatchVariant
+{
+    BatchVariant() {}
+    BatchVariant(const QString &line, const QDir &dir);
+
+    // tab separated: id, problem file, python overrides, results (name=expression;...)
+    QString toString() const;
+    inline bool isValid() const { return !id.isEmpty() && !fileName.isEmpty(); }
+
+    QString id;
+    QString fileName;
+    QString overrides;
+    QString results;
+};
+
 class AgrosSolver : public AgrosApplication
 {
     Q_OBJECT
 
 public:
-    AgrosSolver(int& argc, char ** argv);
+    AgrosSolver(int& argc, char ** argv, bool checkVersion = true);
     ~AgrosSolver();
 
     // reimplemented from QApplication so we can throw exceptions in slots
@@ -39,22 +55,50 @@ public:
     inline void setFileName(const QString &fileName) { m_fileName = fileName; }
     inline void setEnableLog(bool enableLog = true) { m_enableLog = enableLog; }
     inline void setScriptSuite(const QString &name) { m_suiteName = name; }
+    inline void setBatchOutput(const QString &fileName) { m_batchOutputFileName = fileName; }
+    inline void setBatchWorkers(int workers) { m_batchWorkers = qMax(1, workers); }
+    inline void setBatchThreads(int threads) { m_batchThreads = threads; }
 
 public slots:
     void solveProblem();
     void runScript();
     void runSuite();
     void printTestSuites();
+    void runBatch();
+    void runBatchWorker();
 
 private slots:
     void stdOut(const QString &str);
     void stdHtml(const QString &str);
 
+    void batchWorkerReadyRead();
+    void batchWorkerFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void batchWorkerError(QProcess::ProcessError error);
+
 private:
     QString m_fileName;
     QString m_suiteName;
     bool m_enableLog;
     LogStdOut *m_log;
+
+    // batch
+    int m_batchWorkers;
+    int m_batchThreads;
+    int m_batchFailed;
+    QString m_batchOutputFileName;
+    QFile m_batchOutputFile;
+    QList<BatchVariant> m_batchQueue;
+    QMap<QProcess *, BatchVariant> m_batchRunning;
+    QMap<QProcess *, QByteArray> m_batchBuffers;
+
+    // solves one variant, returns result record
+    QString solveVariant(const BatchVariant &variant);
+    void writeBatchRecord(const QString &record);
+    // returns false if the worker cannot be started
+    bool startBatchWorker();
+    void dispatchBatchVariant(QProcess *worker);
+    void failRemainingVariants();
+    void finishBatch();
 };
 
 #endif // AGROS_SOLVER_H
@@ -41,22 +41,40 @@ int main(int argc, char *argv[])
         TCLAP::ValueArg<std::string> problemArg("p", "problem", "Solve problem", false, "", "string");
         TCLAP::ValueArg<std::string> scriptArg("s", "script", "Solve script", false, "", "string");
         TCLAP::ValueArg<std::string> testArg("t", "test", "Run tests", false, "list", "string");
+        TCLAP::ValueArg<std::string> batchArg("b", "batch", "Solve batch of problem variants (manifest: id, a2d file, python overrides, results; tab separated)", false, "", "string");
+        TCLAP::ValueArg<std::string> outputArg("o", "output", "Batch output file", false, "", "string");
+        TCLAP::ValueArg<int> workersArg("w", "workers", "Number of batch worker processes", false, QThread::idealThreadCount(), "int");
+        TCLAP::SwitchArg batchWorkerArg("", "batch-worker", "Batch worker (reads variants from stdin)", false);
+        TCLAP::ValueArg<int> threadsArg("", "threads", "Number of assembly threads of the batch worker", false, 0, "int");
 
         cmd.add(logArg);
         cmd.add(remoteArg);
         cmd.add(problemArg);
         cmd.add(scriptArg);
         cmd.add(testArg);
+        cmd.add(batchArg);
+        cmd.add(outputArg);
+        cmd.add(workersArg);
+        cmd.add(batchWorkerArg);
+        cmd.add(threadsArg);
 
         // parse the argv array.
         cmd.parse(argc, argv);
 
         CleanExit cleanExit;
-        AgrosSolver a(argc, argv);
+        AgrosSolver a(argc, argv, !batchWorkerArg.getValue());
 
         // enable log
         a.setEnableLog(logArg.getValue());
 
+        // batch worker (started by batch)
+        if (batchWorkerArg.getValue())
+        {
+            a.setBatchThreads(threadsArg.getValue());
+            QTimer::singleShot(0, &a, SLOT(runBatchWorker()));
+            return a.exec();
+        }
+
         // run remote server
         if (remoteArg.getValue())
         {
@@ -100,6 +118,22 @@ int main(int argc, char *argv[])
                 }
             }
         }
+        else if (!batchArg.getValue().empty())
+        {
+            if (QFile::exists(QString::fromStdString(batchArg.getValue())))
+            {
+                a.setFileName(QString::fromStdString(batchArg.getValue()));
+                a.setBatchOutput(QString::fromStdString(outputArg.getValue()));
+                a.setBatchWorkers(workersArg.getValue());
+                QTimer::singleShot(0, &a, SLOT(runBatch()));
+                return a.exec();
+            }
+            else
+            {
+                std::cout << QObject::tr("Batch manifest not found.").toStdString() << std::endl;
+                return 1;
+            }
+        }
         else if (!testArg.getValue().empty())
         {
             if (QString::fromStdString(testArg.getValue()) == "list")
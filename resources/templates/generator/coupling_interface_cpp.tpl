@@ -29,6 +29,10 @@
 static XMLModule::module *module_coupling = NULL;
 
 {{CLASS}}Interface::{{CLASS}}Interface() : PluginInterface()
+{
+}
+
+void {{CLASS}}Interface::loadCoupling() const
 {
     // xml coupling description
     if (!module_coupling)
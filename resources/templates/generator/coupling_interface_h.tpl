@@ -81,6 +81,10 @@ public:
 
     // description of module
     virtual QString localeDescription()  { assert(0); return NULL; }
+
+protected:
+    // xml coupling description
+    virtual void loadCoupling() const;
 };
 
 #endif // {{CLASS}}_INTERFACE_H
@@ -41,6 +41,10 @@ static XMLModule::module *module_module = NULL;
 
 {{CLASS}}Interface::{{CLASS}}Interface() : PluginInterface()
 {    
+}
+
+void {{CLASS}}Interface::loadModule() const
+{
     // xml module description
     if (!module_module)
     {
@@ -84,6 +84,10 @@ public:
     // description of module
     virtual QString localeDescription();
 
+protected:
+    // xml module description
+    virtual void loadModule() const;
+
 private:
     {{#EXT_FUNCTIONS_PART}} AgrosExtFunction *{{PART_NAME}}(const ProblemID problemId, QString id, bool derivative, bool linearized, const WeakFormAgros<double>* wfAgros);
     {{/EXT_FUNCTIONS_PART}}
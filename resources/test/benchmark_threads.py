@@ -0,0 +1,75 @@
+import agros2d
+import pythonlab
+import multiprocessing
+
+# scaling of the solver (assembly) with number of threads
+# run: agros2d_solver -s resources/test/benchmark_threads.py
+
+# reference problems (file, field, energy integral)
+problems = [['/resources/examples/Examples/Magnetic Field/Magnetostatics/Motor.a2d', 'magnetic', 'Wm'],
+            ['/resources/examples/Examples/Magnetic Field/Magnetostatics/Switched Reluctance Machine.a2d', 'magnetic', 'Wm'],
+            ['/resources/examples/Examples/Magnetic Field/Eddy Currents/Three Phase Cable.a2d', 'magnetic', 'Wm'],
+            ['/resources/examples/Examples/Electrostatics/Comb Drive Microactuator.a2d', 'electrostatic', 'We']]
+
+# additional uniform refinements (many small elements)
+refinements = 2
+# number of repeated solutions (minimum is taken)
+repeats = 3
+
+def benchmark(filename, field_id, energy):
+    agros2d.open_file(pythonlab.datadir(filename))
+
+    # only solution is measured (no postprocessing of views)
+    agros2d.view.mesh.disable()
+    agros2d.view.post2d.disable()
+
+    field = agros2d.field(field_id)
+    field.number_of_refinements = field.number_of_refinements + refinements
+
+    elapsed = []
+    for i in range(repeats):
+        problem = agros2d.problem()
+        problem.clear_solution()
+        problem.solve()
+        elapsed.append(problem.elapsed_time())
+
+    return min(elapsed), field.volume_integrals()[energy]
+
+def set_threads(threads):
+    # limited by OpenMP (OMP_NUM_THREADS)
+    try:
+        agros2d.options.number_of_threads = threads
+        return True
+    except IndexError:
+        return False
+
+threads_options = agros2d.options.number_of_threads
+
+threads_list = []
+threads = 1
+while (threads < multiprocessing.cpu_count()):
+    threads_list.append(threads)
+    threads *= 2
+threads_list.append(multiprocessing.cpu_count())
+
+for filename, field_id, energy in problems:
+    print(filename.split('/')[-1])
+    print("{0}{1}{2}{3}".format("threads".rjust(10), "time (s)".rjust(15), "speedup".rjust(15), "rel. diff.".rjust(15)))
+
+    reference_time = None
+    reference_energy = None
+    for threads in threads_list:
+        if (not set_threads(threads)):
+            break
+
+        time, value = benchmark(filename, field_id, energy)
+        if (reference_time == None):
+            reference_time = time
+            reference_energy = value
+
+        # difference from the serial solution (parallel assembly changes order of summation)
+        difference = abs(value - reference_energy) / abs(reference_energy) if (reference_energy != 0.0) else abs(value)
+
+        print("{0}{1:15.3f}{2:15.2f}{3:15.2e}".format(str(threads).rjust(10), time, reference_time / time, difference))
+
+agros2d.options.number_of_threads = threads_options
@@ -3,6 +3,10 @@ from test_suite.scenario import Agros2DTestCase
 from test_suite.scenario import Agros2DTestResult
 
 class TestElectrostaticPlanar(Agros2DTestCase):
+    # matrix solver (default if None) and its parameters
+    matrix_solver = None
+    matrix_solver_parameters = {}
+
     def setUp(self):  
         # model
         problem = agros2d.problem(clear = True)
@@ -19,6 +23,10 @@ class TestElectrostaticPlanar(Agros2DTestCase):
         self.electrostatic.number_of_refinements = 2
         self.electrostatic.polynomial_order = 3
         self.electrostatic.solver = "linear"
+        if self.matrix_solver:
+            self.electrostatic.matrix_solver = self.matrix_solver
+        for key, value in self.matrix_solver_parameters.items():
+            self.electrostatic.matrix_solver_parameters[key] = value
         
         self.electrostatic.add_boundary("Neumann", "electrostatic_surface_charge_density", {"electrostatic_surface_charge_density" : 0})
         self.electrostatic.add_boundary("U = 0 V", "electrostatic_potential", {"electrostatic_potential" : 0})
@@ -82,6 +90,18 @@ class TestElectrostaticPlanar(Agros2DTestCase):
         surface_integrals = self.electrostatic.surface_integrals([0, 1, 2, 3])
         self.value_test("Electric charge", surface_integrals["Q"], 1.048981e-7)
             
+class TestElectrostaticPlanarAutomaticSolver(TestElectrostaticPlanar):
+    # same problem, matrix solver chosen from the number of DOFs
+    matrix_solver_parameters = {'automatic' : True}
+
+class TestElectrostaticPlanarMixedPrecision(TestElectrostaticPlanar):
+    # same problem, single precision Krylov solver inside double precision defect correction
+    matrix_solver = "paralution_iterative"
+    matrix_solver_parameters = {'method' : 'cg',
+                                'preconditioner' : 'multicoloredsgs',
+                                'tolerance' : 1e-9,
+                                'mixed_precision' : True}
+
 class TestElectrostaticAxisymmetric(Agros2DTestCase):
     def setUp(self):       
         # model
@@ -162,6 +182,8 @@ if __name__ == '__main__':
     suite = ut.TestSuite()
     result = Agros2DTestResult()
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestElectrostaticPlanar))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestElectrostaticPlanarAutomaticSolver))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestElectrostaticPlanarMixedPrecision))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestElectrostaticAxisymmetric))
     suite.run(result)
     
\ No newline at end of file
@@ -204,6 +204,11 @@ class TestHeatNonlinPlanar(Agros2DTestCase):
         self.value_test("Heat flux", surface["f"], 96464.56418)
         
 class BenchmarkHeatTransientAxisymmetric(Agros2DTestCase):
+    time_step_estimator = "lower_order"
+    # matrix solver (default if None) and its parameters
+    matrix_solver = None
+    matrix_solver_parameters = {}
+
     def setUp(self):  
         # benchmark 
         #
@@ -219,6 +224,7 @@ class BenchmarkHeatTransientAxisymmetric(Agros2DTestCase):
         problem.time_step_method = "adaptive"
         problem.time_method_order = 3
         problem.time_method_tolerance = 1.0
+        problem.time_step_estimator = self.time_step_estimator
         problem.time_steps = 20
         problem.time_total = 190
 
@@ -234,6 +240,10 @@ class BenchmarkHeatTransientAxisymmetric(Agros2DTestCase):
         self.heat.number_of_refinements = 2
         self.heat.polynomial_order = 3
         self.heat.solver = "linear"
+        if self.matrix_solver:
+            self.heat.matrix_solver = self.matrix_solver
+        for key, value in self.matrix_solver_parameters.items():
+            self.heat.matrix_solver_parameters[key] = value
 
         self.heat.add_boundary("Symmetry", "heat_heat_flux", {"heat_convection_heat_transfer_coefficient" : 0, "heat_convection_external_temperature" : 0, "heat_radiation_emissivity" : 0, "heat_heat_flux" : 0, "heat_radiation_ambient_temperature" : 0})
         self.heat.add_boundary("Temperature", "heat_temperature", {"heat_temperature" : 1000})
@@ -259,6 +269,19 @@ class BenchmarkHeatTransientAxisymmetric(Agros2DTestCase):
         point = self.heat.local_values(0.1, 0.3)
         self.value_test("Temperature", point["T"], 186.5, 0.0004) # permissible error 0.02 %
         
+class BenchmarkHeatTransientAxisymmetricExtrapolation(BenchmarkHeatTransientAxisymmetric):
+    # same benchmark, local error estimated from the predictor (no additional solve)
+    time_step_estimator = "extrapolation"
+
+class BenchmarkHeatTransientAxisymmetricAMGReuse(BenchmarkHeatTransientAxisymmetric):
+    # same benchmark, AMG hierarchy kept over time steps
+    matrix_solver = "paralution_amg"
+    matrix_solver_parameters = {'method' : 'cg',
+                                'preconditioner' : 'multicoloredsgs',
+                                'tolerance' : 1e-10,
+                                'amg_reuse_solves' : 10,
+                                'amg_reuse_iterations' : 50}
+
 class TestHeatTransientAxisymmetric(Agros2DTestCase):
     def setUp(self):  
         # model
@@ -363,4 +386,6 @@ if __name__ == '__main__':
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestHeatNonlinPlanar))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(TestHeatTransientAxisymmetric))
     suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkHeatTransientAxisymmetric))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkHeatTransientAxisymmetricExtrapolation))
+    suite.addTest(ut.TestLoader().loadTestsFromTestCase(BenchmarkHeatTransientAxisymmetricAMGReuse))
     suite.run(result)
\ No newline at end of file
@@ -364,6 +364,48 @@ class TestFieldMatrixSolver(Agros2DTestCase):
         with self.assertRaises(IndexError):
             self.field.matrix_solver_parameters['iterations'] = 1.1e4
 
+    """ automatic """
+    def test_automatic(self):
+        self.field.matrix_solver_parameters['automatic'] = True
+        self.assertEqual(self.field.matrix_solver_parameters['automatic'], True)
+
+    def test_set_wrong_automatic(self):
+        with self.assertRaises(ValueError):
+            self.field.matrix_solver_parameters['automatic'] = 'wrong_value'
+
+    """ amg_reuse_solves """
+    def test_amg_reuse_solves(self):
+        self.field.matrix_solver_parameters['amg_reuse_solves'] = 10
+        self.assertEqual(self.field.matrix_solver_parameters['amg_reuse_solves'], 10)
+
+    def test_set_wrong_amg_reuse_solves(self):
+        with self.assertRaises(IndexError):
+            self.field.matrix_solver_parameters['amg_reuse_solves'] = -1
+
+        with self.assertRaises(IndexError):
+            self.field.matrix_solver_parameters['amg_reuse_solves'] = 1.1e3
+
+    """ amg_reuse_iterations """
+    def test_amg_reuse_iterations(self):
+        self.field.matrix_solver_parameters['amg_reuse_iterations'] = 50
+        self.assertEqual(self.field.matrix_solver_parameters['amg_reuse_iterations'], 50)
+
+    def test_set_wrong_amg_reuse_iterations(self):
+        with self.assertRaises(IndexError):
+            self.field.matrix_solver_parameters['amg_reuse_iterations'] = 0
+
+        with self.assertRaises(IndexError):
+            self.field.matrix_solver_parameters['amg_reuse_iterations'] = 1.1e4
+
+    """ mixed_precision """
+    def test_mixed_precision(self):
+        self.field.matrix_solver_parameters['mixed_precision'] = True
+        self.assertEqual(self.field.matrix_solver_parameters['mixed_precision'], True)
+
+    def test_set_wrong_mixed_precision(self):
+        with self.assertRaises(ValueError):
+            self.field.matrix_solver_parameters['mixed_precision'] = 'wrong_value'
+
 class TestFieldAdaptivity(Agros2DTestCase):
     def setUp(self):
         self.problem = a2d.problem(clear = True)
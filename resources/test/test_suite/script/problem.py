@@ -84,6 +84,19 @@ class TestProblemTime(Agros2DTestCase):
         with self.assertRaises(IndexError):
             self.problem.time_method_order = -1e-3
 
+    """ time_step_estimator """
+    def test_time_step_estimator(self):
+        for estimator in ['lower_order', 'extrapolation']:
+            self.problem.time_step_estimator = estimator
+            self.assertEqual(self.problem.time_step_estimator, estimator)
+
+    def test_default_time_step_estimator(self):
+        self.assertEqual(self.problem.time_step_estimator, 'lower_order')
+
+    def test_set_wrong_time_step_estimator(self):
+        with self.assertRaises(ValueError):
+            self.problem.time_step_estimator = 'wrong_estimator'
+
     """ time_total """
     def test_time_total(self):
         self.problem.time_total = 300
@@ -62,6 +62,10 @@ def positive_value(value, key):
     if (value < 0):
         raise IndexError("Value of {0} must be possitive.".format(key))
 
+def bool_value(value, key):
+    if (not isinstance(value, bool)):
+        raise ValueError("Value of '{0}' must be True or False.".format(key))
+
 # convert functions
 cdef vector[int] list_to_int_vector(list):
     cdef vector[int] int_vector
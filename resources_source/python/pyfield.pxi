@@ -310,7 +310,11 @@ cdef class __Field__:
         return {'tolerance' : self.thisptr.getDoubleParameter(string('LinearSolverIterToleranceAbsolute')),
                 'iterations' : self.thisptr.getIntParameter(string('LinearSolverIterIters')),
                 'method' : self.thisptr.getLinearSolverMethod().c_str(),
-                'preconditioner' : self.thisptr.getLinearSolverPreconditioner().c_str()}
+                'preconditioner' : self.thisptr.getLinearSolverPreconditioner().c_str(),
+                'automatic' : self.thisptr.getBoolParameter(string('LinearSolverAutomatic')),
+                'amg_reuse_solves' : self.thisptr.getIntParameter(string('LinearSolverAMGReuseSolves')),
+                'amg_reuse_iterations' : self.thisptr.getIntParameter(string('LinearSolverAMGReuseIters')),
+                'mixed_precision' : self.thisptr.getBoolParameter(string('LinearSolverMixedPrecision'))}
 
     def __set_matrix_solver_parameters__(self, parameters):
         # tolerance
@@ -325,6 +329,20 @@ cdef class __Field__:
         self.thisptr.setLinearSolverMethod(string(parameters['method']))
         self.thisptr.setLinearSolverPreconditioner(string(parameters['preconditioner']))
 
+        # automatic selection
+        bool_value(parameters['automatic'], 'automatic')
+        self.thisptr.setParameter(string('LinearSolverAutomatic'), <bool>parameters['automatic'])
+
+        # AMG hierarchy reuse
+        value_in_range(parameters['amg_reuse_solves'], 0, 1e3, 'amg_reuse_solves')
+        self.thisptr.setParameter(string('LinearSolverAMGReuseSolves'), <int>parameters['amg_reuse_solves'])
+        value_in_range(parameters['amg_reuse_iterations'], 1, 1e4, 'amg_reuse_iterations')
+        self.thisptr.setParameter(string('LinearSolverAMGReuseIters'), <int>parameters['amg_reuse_iterations'])
+
+        # mixed precision defect correction
+        bool_value(parameters['mixed_precision'], 'mixed_precision')
+        self.thisptr.setParameter(string('LinearSolverMixedPrecision'), <bool>parameters['mixed_precision'])
+
     # refinements
     property number_of_refinements:
         def __get__(self):
@@ -24,6 +24,9 @@ cdef extern from "../../agros2d-library/pythonlab/pyproblem.h":
         double getTimeMethodTolerance()
         void setTimeMethodTolerance(double timeMethodTolerance) except +
 
+        string getTimeStepEstimator()
+        void setTimeStepEstimator(string &timeStepEstimator) except +
+
         double getTimeTotal()
         void setTimeTotal(double timeTotal) except +
 
@@ -101,6 +104,12 @@ cdef class __Problem__:
         def __set__(self, time_method_tolerance):
             self.thisptr.setTimeMethodTolerance(time_method_tolerance)
 
+    property time_step_estimator:
+        def __get__(self):
+            return self.thisptr.getTimeStepEstimator().c_str()
+        def __set__(self, time_step_estimator):
+            self.thisptr.setTimeStepEstimator(string(time_step_estimator))
+
     property time_total:
         def __get__(self):
             return self.thisptr.getTimeTotal()